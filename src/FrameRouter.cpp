@@ -0,0 +1,154 @@
+#include "FrameRouter.h"
+#include "utils/PerfectHash.h"
+#include <nlohmann/json.hpp>
+
+using json = nlohmann::json;
+
+/**
+ * @file FrameRouter.cpp
+ *
+ * @brief Implements the `FrameRouter` class and its compile-time name tables.
+ */
+
+namespace {
+
+/** @brief Method names, in `RpcMethod` order. */
+constexpr std::array<std::string_view, static_cast<std::size_t>(RpcMethod::Count)> METHOD_NAMES = {
+    "subscription",
+    "heartbeat",
+    "public/auth",
+    "public/test",
+    "public/set_heartbeat",
+    "public/subscribe",
+    "public/unsubscribe",
+    "private/subscribe",
+    "private/unsubscribe",
+    "private/buy",
+    "private/sell",
+    "private/edit",
+    "private/cancel",
+    "private/cancel_all",
+    "private/cancel_all_by_instrument",
+    "private/get_order_state",
+    "private/get_open_orders",
+    "private/get_open_orders_by_currency",
+    "private/get_open_orders_by_instrument",
+    "private/get_order_history_by_currency",
+    "private/get_positions",
+    "private/get_account_summary",
+    "private/mass_quote",
+    "private/cancel_quotes"
+};
+
+/** @brief Channel family prefixes, in `ChannelKind` order. */
+constexpr std::array<std::string_view, static_cast<std::size_t>(ChannelKind::Count)> CHANNEL_PREFIXES = {
+    "book",
+    "ticker",
+    "trades",
+    "quote",
+    "incremental_ticker",
+    "perpetual",
+    "deribit_price_index",
+    "instrument.state",
+    "markprice.options",
+    "user.orders",
+    "user.trades",
+    "user.changes",
+    "user.portfolio"
+};
+
+constexpr PerfectHashTable<METHOD_NAMES.size()> METHODS(METHOD_NAMES);
+constexpr PerfectHashTable<CHANNEL_PREFIXES.size()> CHANNELS(CHANNEL_PREFIXES);
+
+static_assert(METHODS.find("subscription") == static_cast<int>(RpcMethod::Subscription), "RpcMethod order");
+static_assert(METHODS.find("private/cancel_quotes") == static_cast<int>(RpcMethod::CancelQuotes), "RpcMethod order");
+static_assert(CHANNELS.find("user.portfolio") == static_cast<int>(ChannelKind::UserPortfolio), "ChannelKind order");
+
+} // namespace
+
+RpcMethod FrameRouter::methodOf(std::string_view name) {
+    const int index = METHODS.find(name);
+    return index < 0 ? RpcMethod::Unknown : static_cast<RpcMethod>(index);
+}
+
+/**
+ * @brief Tries the first segment of the channel, then the first two segments.
+ */
+ChannelKind FrameRouter::channelKindOf(std::string_view channel) {
+    const std::size_t first = channel.find('.');
+    if (first == std::string_view::npos) {
+        return ChannelKind::Unknown;
+    }
+    int index = CHANNELS.find(channel.substr(0, first));
+    if (index < 0) {
+        const std::size_t second = channel.find('.', first + 1);
+        index = CHANNELS.find(channel.substr(0, second));
+    }
+    return index < 0 ? ChannelKind::Unknown : static_cast<ChannelKind>(index);
+}
+
+std::string_view FrameRouter::methodName(RpcMethod method) {
+    return method < RpcMethod::Count ? METHODS.key(static_cast<std::size_t>(method)) : std::string_view();
+}
+
+void FrameRouter::onChannel(ChannelKind kind, ChannelHandler handler) {
+    if (kind < ChannelKind::Count) {
+        channelHandlers[static_cast<std::size_t>(kind)] = std::move(handler);
+    }
+}
+
+void FrameRouter::onMethod(RpcMethod method, MethodHandler handler) {
+    if (method < RpcMethod::Count) {
+        methodHandlers[static_cast<std::size_t>(method)] = std::move(handler);
+    }
+}
+
+void FrameRouter::onResponse(ResponseHandler handler) {
+    responseHandler = std::move(handler);
+}
+
+bool FrameRouter::route(const json& frame) const {
+    if (!frame.is_object()) {
+        return false;
+    }
+
+    const auto method = frame.find("method");
+    if (method == frame.end() || !method->is_string()) {
+        if (responseHandler && frame.contains("id")) {
+            responseHandler(frame);
+            return true;
+        }
+        return false;
+    }
+
+    const RpcMethod resolved = methodOf(method->get_ref<const std::string&>());
+    if (resolved != RpcMethod::Subscription) {
+        if (resolved == RpcMethod::Unknown || !methodHandlers[static_cast<std::size_t>(resolved)]) {
+            return false;
+        }
+        methodHandlers[static_cast<std::size_t>(resolved)](frame);
+        return true;
+    }
+
+    const auto params = frame.find("params");
+    if (params == frame.end() || !params->is_object()) {
+        return false;
+    }
+    const auto channel = params->find("channel");
+    if (channel == params->end() || !channel->is_string()) {
+        return false;
+    }
+
+    const std::string& name = channel->get_ref<const std::string&>();
+    const ChannelKind kind = channelKindOf(name);
+    if (kind == ChannelKind::Unknown || !channelHandlers[static_cast<std::size_t>(kind)]) {
+        return false;
+    }
+    channelHandlers[static_cast<std::size_t>(kind)](name, *params);
+    return true;
+}
+
+bool FrameRouter::route(const std::string& message) const {
+    const json frame = json::parse(message, nullptr, false);
+    return !frame.is_discarded() && route(frame);
+}
@@ -0,0 +1,141 @@
+#ifndef FRAME_ROUTER_H
+#define FRAME_ROUTER_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <nlohmann/json_fwd.hpp>
+
+/**
+ * @file FrameRouter.h
+ *
+ * @brief Defines the `FrameRouter` class, which dispatches incoming JSON-RPC frames to typed
+ *        handlers, and the `RpcMethod` and `ChannelKind` enumerations it resolves names to.
+ *
+ * Method names and channel prefixes are looked up in perfect hash tables built at compile time
+ * (`PerfectHashTable`), so routing a frame costs one lookup for its `method` and at most two for
+ * its `channel` prefix, instead of a chain of string compares. Handlers live in arrays indexed by
+ * the enumerations.
+ */
+
+/**
+ * @brief Known JSON-RPC methods: server notifications and the requests this system sends.
+ *
+ * The enumerators index `FrameRouter::methodName`; keep both lists in the same order.
+ */
+enum class RpcMethod : uint8_t {
+    Subscription,
+    Heartbeat,
+    PublicAuth,
+    PublicTest,
+    PublicSetHeartbeat,
+    PublicSubscribe,
+    PublicUnsubscribe,
+    PrivateSubscribe,
+    PrivateUnsubscribe,
+    Buy,
+    Sell,
+    Edit,
+    Cancel,
+    CancelAll,
+    CancelAllByInstrument,
+    GetOrderState,
+    GetOpenOrders,
+    GetOpenOrdersByCurrency,
+    GetOpenOrdersByInstrument,
+    GetOrderHistoryByCurrency,
+    GetPositions,
+    GetAccountSummary,
+    MassQuote,
+    CancelQuotes,
+    Count,
+    Unknown = Count
+};
+
+/**
+ * @brief Known subscription channel families, identified by the channel name's prefix.
+ *
+ * Most families are named by the first segment of the channel ("book.BTC-PERPETUAL.100ms"); the
+ * `user.*`, `instrument.*` and `markprice.*` families by the first two ("user.orders.any.any.raw").
+ */
+enum class ChannelKind : uint8_t {
+    Book,
+    Ticker,
+    Trades,
+    Quote,
+    IncrementalTicker,
+    Perpetual,
+    PriceIndex,
+    InstrumentState,
+    MarkPriceOptions,
+    UserOrders,
+    UserTrades,
+    UserChanges,
+    UserPortfolio,
+    Count,
+    Unknown = Count
+};
+
+/**
+ * @class FrameRouter
+ *
+ * @brief Routes parsed frames to handlers by method and, for subscriptions, by channel family.
+ *
+ * ### Workflow:
+ * 1. Register handlers with `onChannel`, `onMethod` and `onResponse`.
+ * 2. Call `route` from the receive callback with every frame.
+ * 3. Subscription notifications go to their channel handler (with `params`), other notifications
+ *    to their method handler (with the whole frame), and replies to requests to the response handler.
+ *
+ * ### Example:
+ * ```
+ * FrameRouter router;
+ * router.onChannel(ChannelKind::Book, [&](const std::string& channel, const json& params) { book.applyUpdate(params["data"]); });
+ * router.onMethod(RpcMethod::Heartbeat, [&](const json& frame) { ... });
+ * wsClient.receive([&](const std::string& message) { router.route(message); });
+ * ```
+ */
+class FrameRouter {
+public:
+    using ChannelHandler = std::function<void(const std::string& channel, const nlohmann::json& params)>;
+    using MethodHandler = std::function<void(const nlohmann::json& frame)>;
+    using ResponseHandler = std::function<void(const nlohmann::json& frame)>;
+
+    /** @brief Resolves a method name; `RpcMethod::Unknown` if it is not known. */
+    static RpcMethod methodOf(std::string_view name);
+
+    /** @brief Resolves the channel family of a channel name; `ChannelKind::Unknown` if not known. */
+    static ChannelKind channelKindOf(std::string_view channel);
+
+    /** @brief Returns the name of a known method (empty for `Unknown`). */
+    static std::string_view methodName(RpcMethod method);
+
+    /** @brief Sets the handler of a channel family (replaces any previous one). */
+    void onChannel(ChannelKind kind, ChannelHandler handler);
+
+    /** @brief Sets the handler of a notification method other than `subscription`. */
+    void onMethod(RpcMethod method, MethodHandler handler);
+
+    /** @brief Sets the handler of replies to requests (frames with an `id`). */
+    void onResponse(ResponseHandler handler);
+
+    /**
+     * @brief Dispatches one parsed frame.
+     *
+     * @return True if a handler received the frame.
+     */
+    bool route(const nlohmann::json& frame) const;
+
+    /** @brief Parses and dispatches one frame; false if it is not JSON or was not handled. */
+    bool route(const std::string& message) const;
+
+private:
+    std::array<ChannelHandler, static_cast<std::size_t>(ChannelKind::Count)> channelHandlers;
+    std::array<MethodHandler, static_cast<std::size_t>(RpcMethod::Count)> methodHandlers;
+    ResponseHandler responseHandler;
+};
+
+#endif // FRAME_ROUTER_H
@@ -0,0 +1,156 @@
+#include "InflightRequests.h"
+#include <algorithm>
+#include <nlohmann/json.hpp>
+
+using json = nlohmann::json;
+
+/**
+ * @file InflightRequests.cpp
+ *
+ * @brief Implements the `InflightRequests` class.
+ */
+
+static_assert((InflightRequests::CAPACITY & (InflightRequests::CAPACITY - 1)) == 0, "CAPACITY must be a power of two");
+
+InflightRequests::InflightRequests(std::chrono::milliseconds timeout, uint64_t firstId)
+    : timeout(timeout), nextId(std::max<uint64_t>(firstId, 1)), slots(CAPACITY), timers(TICK, CAPACITY) {
+    expired.reserve(CAPACITY);
+}
+
+InflightRequests::Completion InflightRequests::release(uint32_t index) {
+    Slot& slot = slots[index];
+    timers.cancel(slot.timer);
+    slot.timer = TimerWheel::INVALID_TIMER;
+    slot.id = 0;
+    --count;
+    return std::move(slot.completion);
+}
+
+void InflightRequests::onTimeout(uint64_t requestId) {
+    const uint32_t index = static_cast<uint32_t>(requestId & (CAPACITY - 1));
+    if (slots[index].id != requestId) {
+        return;
+    }
+    ++stats[static_cast<std::size_t>(slots[index].method)].timedOut;
+    expired.push_back(release(index));
+}
+
+/**
+ * @brief The ID's slot is its low bits, so the ring only refuses a request when the request sent
+ *        `CAPACITY` IDs earlier is still unanswered.
+ */
+uint64_t InflightRequests::allocate(RpcMethod method, Completion completion) {
+    const auto now = std::chrono::steady_clock::now();
+    std::lock_guard<std::mutex> lock(mutex);
+    const uint64_t id = nextId;
+    const uint32_t index = static_cast<uint32_t>(id & (CAPACITY - 1));
+    Slot& slot = slots[index];
+    if (slot.id != 0) {
+        return 0;
+    }
+
+    slot.id = id;
+    slot.method = method;
+    slot.sentAt = now;
+    slot.completion = std::move(completion);
+    slot.timer = timers.schedule(now + timeout, [this, id]() { onTimeout(id); });
+    ++count;
+    ++nextId;
+    return id;
+}
+
+std::string InflightRequests::request(RpcMethod method, const json& params, Completion completion) {
+    const uint64_t id = allocate(method, std::move(completion));
+    return id == 0 ? std::string() : serialize(id, method, params);
+}
+
+std::string InflightRequests::serialize(uint64_t requestId, RpcMethod method, const json& params) {
+    return json{
+        {"jsonrpc", "2.0"},
+        {"id", requestId},
+        {"method", std::string(FrameRouter::methodName(method))},
+        {"params", params}
+    }.dump();
+}
+
+bool InflightRequests::complete(const json& response) {
+    const auto id = response.find("id");
+    if (id == response.end() || !id->is_number_unsigned()) {
+        return false;
+    }
+    const uint64_t requestId = id->get<uint64_t>();
+
+    Completion completion;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        const uint32_t index = static_cast<uint32_t>(requestId & (CAPACITY - 1));
+        Slot& slot = slots[index];
+        if (requestId == 0 || slot.id != requestId) {
+            return false;
+        }
+
+        // Round trip folded into the method's statistics (1/8 weight, as TCP's SRTT)
+        const int64_t sample = std::chrono::duration_cast<std::chrono::microseconds>(
+                                   std::chrono::steady_clock::now() - slot.sentAt).count();
+        MethodRtt& rtt = stats[static_cast<std::size_t>(slot.method)];
+        ++rtt.answered;
+        rtt.lastMicros = sample;
+        rtt.minMicros = rtt.minMicros < 0 ? sample : std::min(rtt.minMicros, sample);
+        rtt.maxMicros = std::max(rtt.maxMicros, sample);
+        rtt.smoothedMicros = rtt.smoothedMicros < 0 ? sample : rtt.smoothedMicros + (sample - rtt.smoothedMicros) / 8;
+
+        completion = release(index);
+    }
+
+    if (completion) {
+        completion(&response);
+    }
+    return true;
+}
+
+bool InflightRequests::abandon(uint64_t requestId) {
+    Completion completion;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        const uint32_t index = static_cast<uint32_t>(requestId & (CAPACITY - 1));
+        if (requestId == 0 || slots[index].id != requestId) {
+            return false;
+        }
+        completion = release(index);
+    }
+
+    if (completion) {
+        completion(nullptr);
+    }
+    return true;
+}
+
+/**
+ * @brief Timeouts fire inside `advance` with `mutex` held and only queue their completions, which
+ *        then run after the lock is released.
+ */
+std::size_t InflightRequests::expire(std::chrono::steady_clock::time_point now) {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        timers.advance(now);
+    }
+
+    const std::size_t expiredCount = expired.size();
+    for (auto& completion : expired) {
+        if (completion) {
+            completion(nullptr);
+        }
+    }
+    expired.clear();
+    return expiredCount;
+}
+
+MethodRtt InflightRequests::rtt(RpcMethod method) const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return stats[std::min(static_cast<std::size_t>(method), stats.size() - 1)];
+}
+
+std::size_t InflightRequests::inFlight() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return count;
+}
@@ -0,0 +1,170 @@
+#ifndef INFLIGHT_REQUESTS_H
+#define INFLIGHT_REQUESTS_H
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <vector>
+#include <nlohmann/json_fwd.hpp>
+#include "FrameRouter.h"
+#include "utils/TimerWheel.h"
+
+/**
+ * @file InflightRequests.h
+ *
+ * @brief Defines the `InflightRequests` class, which correlates JSON-RPC responses received on a
+ *        WebSocket with the requests sent on it.
+ *
+ * Every JSON-RPC request sent on a connection should take its ID from the connection's one ring,
+ * so IDs never collide between the components sharing the socket.
+ *
+ * Request IDs come from a monotonically increasing counter, and the low bits of an ID index a
+ * fixed ring of slots holding the request's completion, method and send time. Matching a response
+ * is one array access plus a check that the slot still holds that ID, with no map lookup and no
+ * allocation. Requests that get no answer are expired by a `TimerWheel` sized to the ring, so
+ * arming and cancelling a timeout allocates nothing either. Every answered request adds a
+ * round-trip sample to the statistics of its method.
+ */
+
+/**
+ * @struct MethodRtt
+ *
+ * @brief Round-trip statistics of one JSON-RPC method.
+ */
+struct MethodRtt {
+    uint64_t answered{0};       /**< Requests that got a response. */
+    uint64_t timedOut{0};       /**< Requests expired without a response. */
+    int64_t lastMicros{-1};     /**< Latest round trip. */
+    int64_t minMicros{-1};      /**< Smallest round trip. */
+    int64_t maxMicros{-1};      /**< Largest round trip. */
+    int64_t smoothedMicros{-1}; /**< Smoothed round trip (1/8 weight per sample). */
+};
+
+/**
+ * @class InflightRequests
+ *
+ * @brief Fixed ring of in-flight JSON-RPC requests with O(1) response matching and timeouts.
+ *
+ * ### Workflow:
+ * 1. `allocate` reserves a slot and returns the ID to put in the request.
+ * 2. `complete` is called with every received reply; the completion runs with the response.
+ * 3. `expire` is called periodically; requests past their deadline complete with `nullptr`.
+ *
+ * Completions run on the thread calling `complete` or `expire`, outside the internal lock, so they
+ * may allocate new requests. Completions capturing at most two pointers are stored without
+ * allocating.
+ *
+ * ### Example:
+ * ```
+ * InflightRequests requests(std::chrono::seconds(5));
+ * uint64_t id = requests.allocate(RpcMethod::Buy, [this](const json* response) { ... });
+ * ws.send(InflightRequests::serialize(id, RpcMethod::Buy, params));
+ * // Or both at once, when the send needs no error handling of its own:
+ * ws.send(requests.request(RpcMethod::PublicSubscribe, {{"channels", channels}}));
+ * // In the receive loop:
+ * requests.complete(message);
+ * requests.expire();
+ * ```
+ */
+class InflightRequests {
+public:
+    /** @brief Called with the response, or `nullptr` if the request timed out or was abandoned. */
+    using Completion = std::function<void(const nlohmann::json* response)>;
+
+    static constexpr std::size_t CAPACITY = 1024;        /**< Maximum requests in flight; a power of two. */
+    static constexpr std::chrono::milliseconds TICK{10}; /**< Timeout resolution. */
+
+    /**
+     * @brief Constructs an empty ring.
+     *
+     * @param timeout How long a request may stay unanswered.
+     * @param firstId The first request ID (keeps these IDs apart from other IDs on the connection).
+     */
+    explicit InflightRequests(std::chrono::milliseconds timeout = std::chrono::seconds(5), uint64_t firstId = 1);
+
+    InflightRequests(const InflightRequests&) = delete;
+    InflightRequests& operator=(const InflightRequests&) = delete;
+
+    /**
+     * @brief Reserves a slot for a request about to be sent and starts its timeout.
+     *
+     * @return The request ID, or 0 if the slot the next ID maps to is still in flight (more than
+     *         `CAPACITY` requests outstanding).
+     */
+    uint64_t allocate(RpcMethod method, Completion completion);
+
+    /**
+     * @brief Allocates a request and serializes it.
+     *
+     * @param method The request method.
+     * @param params The request parameters.
+     * @param completion Called with the response (may be empty).
+     * @return The serialized request, or an empty string if the ring is full.
+     */
+    std::string request(RpcMethod method, const nlohmann::json& params, Completion completion = nullptr);
+
+    /**
+     * @brief Serializes a JSON-RPC 2.0 request with an allocated ID.
+     */
+    static std::string serialize(uint64_t requestId, RpcMethod method, const nlohmann::json& params);
+
+    /**
+     * @brief Matches a reply to its request, records the round trip and runs the completion.
+     *
+     * @return False if the frame has no ID of an in-flight request of this ring.
+     */
+    bool complete(const nlohmann::json& response);
+
+    /**
+     * @brief Releases a request without a response (e.g., the send failed); its completion runs with `nullptr`.
+     *
+     * @return False if the request is not in flight.
+     */
+    bool abandon(uint64_t requestId);
+
+    /**
+     * @brief Expires the requests whose deadline has passed; their completions run with `nullptr`.
+     *
+     * Must be called from one thread at a time.
+     *
+     * @return The number of expired requests.
+     */
+    std::size_t expire(std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now());
+
+    /** @brief Returns a snapshot of the round-trip statistics of a method. */
+    MethodRtt rtt(RpcMethod method) const;
+
+    /** @brief Returns the number of requests in flight. */
+    std::size_t inFlight() const;
+
+private:
+    /** @brief One in-flight request. */
+    struct Slot {
+        uint64_t id{0}; /**< 0 when free. */
+        RpcMethod method{RpcMethod::Unknown};
+        std::chrono::steady_clock::time_point sentAt;
+        TimerWheel::TimerId timer{TimerWheel::INVALID_TIMER};
+        Completion completion;
+    };
+
+    /** @brief Timer callback: records the timeout and queues the completion for `expire`. Requires `mutex`. */
+    void onTimeout(uint64_t requestId);
+
+    /** @brief Frees a slot (cancelling its timer) and returns its completion. Requires `mutex`. */
+    Completion release(uint32_t index);
+
+    std::chrono::milliseconds timeout;
+    mutable std::mutex mutex;
+    uint64_t nextId;
+    std::size_t count{0};
+    std::vector<Slot> slots;
+    TimerWheel timers;                             /**< Request timeouts (guarded by `mutex`). */
+    std::array<MethodRtt, static_cast<std::size_t>(RpcMethod::Count) + 1> stats; /**< Indexed by method; last is Unknown. */
+    std::vector<Completion> expired;               /**< Filled by `onTimeout`, drained by `expire` (reserved to `CAPACITY`). */
+};
+
+#endif // INFLIGHT_REQUESTS_H
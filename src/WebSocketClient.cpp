@@ -1,9 +1,16 @@
 #include "WebSocketClient.h"
+#include <algorithm>
+#include <cstring>
 #include <iostream>
 #include <mutex>
 #include <thread>
 
 #include <fmt/color.h>
+#include <openssl/err.h>
+#include <openssl/evp.h>
+#include <openssl/rand.h>
+#include <openssl/sha.h>
+#include <poll.h>
 
 // Define color constants for clarity
 const auto ERROR_COLOR = fmt::fg(fmt::color::red);
@@ -14,6 +21,10 @@ const auto HIGHLIGHT_COLOR = fmt::fg(fmt::color::yellow);
 /**
  * @brief Implements a thread-safe, SSL-enabled WebSocket client using Boost.Beast and Boost.Asio
  * 
+ * Asio resolves and connects the socket; OpenSSL then runs directly on the socket descriptor
+ * (`SSL_set_fd`) rather than through `asio::ssl::stream`, whose memory BIO pair would keep the
+ * kernel from ever taking over the TLS records (kTLS needs OpenSSL's socket BIO).
+ * 
  * This implementation follows the Pimpl (Pointer to Implementation) idiom to:
  * - Provide clean separation of interface and implementation
  * - Hide complex Boost library details from the header
@@ -34,9 +45,22 @@ public:
         : config_(config), 
           ioc_(std::make_shared<asio::io_context>()),
           ssl_ctx_(asio::ssl::context::tlsv12_client),
-          ws_stream_(*ioc_, ssl_ctx_),
+          socket_(*ioc_),
           state_(State::Disconnected) 
     {
+        buffer_.resize(std::max(config_.read_buffer_size, MIN_READ_SIZE));
+
+        // With kTLS enabled, OpenSSL installs the negotiated keys into the socket after the
+        // handshake; SSL_read/SSL_write then become plain socket calls without userspace crypto.
+        // This covers the WebSocket only: libcurl (REST) keeps its own userspace TLS.
+        if (config_.enable_ktls) {
+#ifdef SSL_OP_ENABLE_KTLS
+            SSL_CTX_set_options(ssl_ctx_.native_handle(), SSL_OP_ENABLE_KTLS);
+#else
+            std::cerr << fmt::format(HIGHLIGHT_COLOR, "kTLS requested but OpenSSL was built without it\n");
+#endif
+        }
+
         // Configure SSL context
         if (config_.verify_ssl) {
             ssl_ctx_.set_default_verify_paths();
@@ -51,9 +75,9 @@ public:
      * 
      * Connection process:
      * 1. Resolve host and port
-     * 2. Set up a connection timeout mechanism
+     * 2. Race TCP connects across the resolved addresses within the connection timeout
      * 3. Perform SSL handshake
-     * 4. Complete WebSocket handshake
+     * 4. Complete the WebSocket upgrade (see `upgrade`)
      * 
      * Thread-safety is ensured via mutex locking
      * Throws exceptions on connection failures
@@ -73,25 +97,26 @@ public:
             asio::ip::tcp::resolver resolver(*ioc_);
             auto const results = resolver.resolve(config_.host, config_.port);
 
-            // Connect with timeout
-            asio::steady_timer timeout_timer(*ioc_, 
-                std::chrono::steady_clock::now() + config_.connect_timeout);
-            
-            timeout_timer.async_wait([this](const boost::system::error_code& ec) {
-                if (ec != asio::error::operation_aborted) {
-                    // Use next_layer().lowest_layer() instead of lowest_layer()
-                    ws_stream_.next_layer().lowest_layer().cancel();
-                }
-            });
-
-            // Connect to server
-            asio::connect(ws_stream_.next_layer().lowest_layer(), results);
+            // Race the resolved addresses (happy eyeballs) within the connect timeout
+            socket_ = race_connect(results);
 
             // Perform SSL handshake
-            ws_stream_.next_layer().handshake(asio::ssl::stream_base::client);
+            tls_handshake();
+
+            if (config_.enable_ktls) {
+                SSL* ssl = ssl_.get();
+                ktls_send_ = BIO_get_ktls_send(SSL_get_wbio(ssl));
+                ktls_recv_ = BIO_get_ktls_recv(SSL_get_rbio(ssl));
+                std::cout << fmt::format(INFO_COLOR, "kTLS offload: send {}, receive {} ({})\n",
+                                         ktls_send_ ? "on" : "off", ktls_recv_ ? "on" : "off", SSL_get_cipher(ssl));
+            }
 
-            // WebSocket handshake
-            ws_stream_.handshake(config_.host, config_.path);
+            // WebSocket handshake; frames that arrived with the 101 response start the receive buffer
+            begin_ = end_ = needed_ = 0;
+            fragment_.clear();
+            peer_closed_ = false;
+            close_sent_ = false;
+            upgrade();
 
             state_ = State::Connected;
             std::cout << fmt::format(SUCCESS_COLOR, "WebSocket connected to: {}\n", config_.host);
@@ -107,20 +132,26 @@ public:
     /**
      * @brief Gracefully closes the WebSocket connection
      * 
-     * Ensures thread-safe disconnection with proper error handling
-     * Logs any errors encountered during disconnection
+     * Sends a close frame, then keeps parsing frames from where `receive_batch` left off
+     * (discarding data messages) until the server's close frame arrives or
+     * `CLOSE_TIMEOUT` expires, and closes the socket. Thread-safe; errors are logged.
      */
     void disconnect() {
         std::lock_guard<std::mutex> lock(mutex_);
         
         if (state_ == State::Connected) {
             try {
-                // Gracefully close WebSocket
-                ws_stream_.close(websocket::close_code::normal);
+                if (!close_sent_) {
+                    const unsigned char normal[2] = {0x03, 0xE8}; // 1000, normal closure
+                    write_frame(0x8, reinterpret_cast<const char*>(normal), sizeof(normal));
+                    close_sent_ = true;
+                }
+                await_close();
             }
             catch (const std::exception& e) {
                 std::cerr << fmt::format(ERROR_COLOR, "Disconnection error: {}\n", e.what());
             }
+            close_socket(true);
         }
         
         state_ = State::Disconnected;
@@ -142,7 +173,7 @@ public:
         }
 
         try {
-            ws_stream_.write(asio::buffer(message));
+            write_frame(0x1, message.data(), message.size());
         }
         catch (const std::exception& e) {
             last_error_ = e.what();
@@ -155,11 +186,29 @@ public:
      * @brief Receives a message from the WebSocket connection
      * 
      * Provides a synchronous message reception mechanism
-     * Invokes a callback function with the received message
+     * Invokes the callback once for every complete message read in the same batch
      * 
-     * @param callback Function to be called with the received message
+     * @param callback Function to be called with each received message
      */
     void receive(std::function<void(const std::string&)> callback) {
+        receive_batch([&callback](const std::vector<std::string>& messages) {
+            for (const auto& message : messages) {
+                callback(message);
+            }
+        });
+    }
+
+    /**
+     * @brief Receives every complete message available after one blocking read
+     * 
+     * Reads a large chunk into the persistent buffer, then parses as many complete
+     * WebSocket frames as it holds before returning; only an incomplete frame leads to
+     * another read. Control frames are handled here: pings are answered with pongs and a
+     * close frame is echoed, then ends the connection once the messages before it were delivered.
+     * 
+     * @param callback Function to be called once with the batch of messages
+     */
+    void receive_batch(std::function<void(const std::vector<std::string>&)> callback) {
         std::lock_guard<std::mutex> lock(mutex_);
         
         if (state_ != State::Connected) {
@@ -167,11 +216,20 @@ public:
         }
 
         try {
-            beast::flat_buffer buffer;
-            ws_stream_.read(buffer);
-            
-            std::string message = beast::buffers_to_string(buffer.data());
-            callback(message);
+            batch_.clear();
+            while (true) {
+                parse_frames();
+                if (!batch_.empty()) {
+                    break;
+                }
+                if (peer_closed_) {
+                    state_ = State::Disconnected;
+                    close_socket(false);
+                    throw std::runtime_error("Connection closed by server");
+                }
+                fill_buffer();
+            }
+            callback(batch_);
         }
         catch (const std::exception& e) {
             last_error_ = e.what();
@@ -180,6 +238,35 @@ public:
         }
     }
 
+    /**
+     * @brief Waits for data to receive, a signal on `wake_fd`, or the timeout
+     * 
+     * Every complete frame is parsed by `receive_batch`, so what is left in the buffer is an
+     * incomplete frame that needs more data, except for frames that arrived with the upgrade
+     * response and have not been parsed yet (`needed_` still 0). Records already decrypted
+     * by OpenSSL do not show on the socket and are checked separately.
+     */
+    bool wait_readable(std::chrono::milliseconds timeout, int wake_fd) {
+        int fd;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (state_ != State::Connected) {
+                throw std::runtime_error("Not connected");
+            }
+            if (peer_closed_ || (end_ > begin_ && needed_ == 0) || SSL_pending(ssl_.get()) > 0) {
+                return true;
+            }
+            fd = socket_.native_handle();
+        }
+
+        pollfd fds[2] = {{fd, POLLIN, 0}, {wake_fd, POLLIN, 0}};
+        const int ready = ::poll(fds, wake_fd >= 0 ? 2 : 1, static_cast<int>(std::max<int64_t>(timeout.count(), 0)));
+        if (ready < 0 && errno != EINTR) {
+            throw boost::system::system_error(errno, boost::system::system_category(), "poll");
+        }
+        return ready > 0 && fds[0].revents != 0;
+    }
+
     /**
      * @brief Retrieves the current connection state
      * @return Current connection state
@@ -196,15 +283,516 @@ public:
         return last_error_;
     }
 
+    bool ktls_active() const {
+        return ktls_send_ && ktls_recv_;
+    }
+
+    /**
+     * @brief Connects to the first resolved address that answers (RFC 8305 happy eyeballs)
+     * 
+     * Addresses are interleaved by family. A new attempt starts every
+     * `CONNECTION_ATTEMPT_DELAY`, or immediately when an attempt fails; the first
+     * established connection wins and the others are closed. A black-holed address
+     * therefore costs 250 ms instead of a full TCP timeout.
+     * 
+     * @param results The resolved addresses
+     * @return The connected socket
+     */
+    asio::ip::tcp::socket race_connect(const asio::ip::tcp::resolver::results_type& results) {
+        std::vector<asio::ip::tcp::endpoint> v6;
+        std::vector<asio::ip::tcp::endpoint> v4;
+        for (const auto& entry : results) {
+            (entry.endpoint().address().is_v6() ? v6 : v4).push_back(entry.endpoint());
+        }
+        std::vector<asio::ip::tcp::endpoint> endpoints;
+        for (std::size_t i = 0; i < std::max(v6.size(), v4.size()); ++i) {
+            if (i < v6.size()) endpoints.push_back(v6[i]);
+            if (i < v4.size()) endpoints.push_back(v4[i]);
+        }
+        if (endpoints.empty()) {
+            throw boost::system::system_error(asio::error::host_not_found);
+        }
+
+        std::vector<asio::ip::tcp::socket> attempts;
+        attempts.reserve(endpoints.size());
+        for (std::size_t i = 0; i < endpoints.size(); ++i) {
+            attempts.emplace_back(*ioc_);
+        }
+
+        asio::steady_timer stagger(*ioc_);
+        std::optional<std::size_t> winner;
+        boost::system::error_code last_error = asio::error::timed_out;
+        std::size_t next = 0;
+        std::size_t outstanding = 0;
+
+        std::function<void()> launch = [&]() {
+            if (winner || next == endpoints.size()) {
+                return;
+            }
+            const std::size_t index = next++;
+            ++outstanding;
+            attempts[index].async_connect(endpoints[index], [&, index](const boost::system::error_code& ec) {
+                --outstanding;
+                if (winner) {
+                    return;
+                }
+                if (ec) {
+                    last_error = ec;
+                    launch(); // A failed attempt starts the next one right away
+                    if (outstanding == 0) {
+                        stagger.cancel(); // Every address failed
+                    }
+                    return;
+                }
+                winner = index;
+                stagger.cancel();
+                for (std::size_t i = 0; i < attempts.size(); ++i) {
+                    boost::system::error_code ignored;
+                    if (i != index) attempts[i].close(ignored);
+                }
+            });
+
+            // Re-arming cancels the previous wait, so only the latest attempt schedules the next
+            stagger.expires_after(CONNECTION_ATTEMPT_DELAY);
+            stagger.async_wait([&](const boost::system::error_code& ec) {
+                if (!ec) launch();
+            });
+        };
+
+        const auto started = std::chrono::steady_clock::now();
+        ioc_->restart();
+        launch();
+        ioc_->run_for(config_.connect_timeout);
+
+        if (!winner) {
+            // Timed out: abort the remaining attempts and let their handlers run before returning
+            stagger.cancel();
+            for (auto& attempt : attempts) {
+                boost::system::error_code ignored;
+                attempt.close(ignored);
+            }
+            ioc_->restart();
+            ioc_->run();
+            throw boost::system::system_error(last_error);
+        }
+
+        std::cout << fmt::format(INFO_COLOR, "Connected to {} in {} ms ({} of {} addresses tried)\n",
+                                 endpoints[*winner].address().to_string(),
+                                 std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - started).count(),
+                                 next, endpoints.size());
+        return std::move(attempts[*winner]);
+    }
+
+    /**
+     * @brief Runs the TLS client handshake on the connected socket
+     * 
+     * The socket is put back into blocking mode first (the asynchronous connect left it
+     * non-blocking), so SSL_read/SSL_write block like the rest of this client.
+     */
+    void tls_handshake() {
+        socket_.native_non_blocking(false);
+        ssl_.reset(SSL_new(ssl_ctx_.native_handle()));
+        if (!ssl_ || SSL_set_fd(ssl_.get(), socket_.native_handle()) != 1) {
+            throw std::runtime_error("Cannot create the TLS session");
+        }
+        SSL_set_tlsext_host_name(ssl_.get(), config_.host.c_str());
+        errno = 0;
+        const int result = SSL_connect(ssl_.get());
+        if (result != 1) {
+            throw boost::system::system_error(tls_error(result), "TLS handshake");
+        }
+    }
+
+    /** @brief Maps the result of an SSL_read/SSL_write call to an error code. */
+    boost::system::error_code tls_error(int result) const {
+        switch (SSL_get_error(ssl_.get(), result)) {
+        case SSL_ERROR_WANT_READ:
+        case SSL_ERROR_WANT_WRITE:
+            return asio::error::would_block;
+        case SSL_ERROR_ZERO_RETURN:
+            return asio::error::eof;
+        case SSL_ERROR_SYSCALL:
+            return errno != 0 ? boost::system::error_code(errno, boost::system::system_category())
+                              : boost::system::error_code(asio::error::eof);
+        default:
+            return boost::system::error_code(static_cast<int>(ERR_get_error()), asio::error::get_ssl_category());
+        }
+    }
+
+    /** @brief Reads decrypted bytes; sets `ec` (would_block, eof, ...) instead of throwing. */
+    std::size_t tls_read(char* data, std::size_t size, boost::system::error_code& ec) {
+        std::size_t read = 0;
+        errno = 0;
+        const int result = SSL_read_ex(ssl_.get(), data, size, &read);
+        ec = result == 1 ? boost::system::error_code() : tls_error(result);
+        return read;
+    }
+
+    /** @brief Writes some bytes; sets `ec` instead of throwing. */
+    std::size_t tls_write_some(const char* data, std::size_t size, boost::system::error_code& ec) {
+        std::size_t written = 0;
+        errno = 0;
+        const int result = SSL_write_ex(ssl_.get(), data, size, &written);
+        ec = result == 1 ? boost::system::error_code() : tls_error(result);
+        return written;
+    }
+
+    /** @brief Writes all bytes; throws on failure. */
+    void tls_write(const char* data, std::size_t size) {
+        boost::system::error_code ec;
+        while (size > 0) {
+            const std::size_t written = tls_write_some(data, size, ec);
+            if (ec) {
+                throw boost::system::system_error(ec, "TLS write");
+            }
+            data += written;
+            size -= written;
+        }
+    }
+
+    /**
+     * @brief Sends TLS close_notify (when the session is healthy) and closes the socket.
+     */
+    void close_socket(bool notify) {
+        if (ssl_ && notify) {
+            socket_.native_non_blocking(true); // Never wait for the peer's close_notify
+            SSL_shutdown(ssl_.get());
+        }
+        ssl_.reset();
+        boost::system::error_code ec;
+        socket_.close(ec);
+    }
+
+    /**
+     * @struct TlsStream
+     * @brief Minimal synchronous stream over the TLS session, for Beast's HTTP read/write.
+     */
+    struct TlsStream {
+        Impl& impl;
+
+        template <typename Buffers>
+        std::size_t read_some(const Buffers& buffers, boost::system::error_code& ec) {
+            for (auto it = asio::buffer_sequence_begin(buffers); it != asio::buffer_sequence_end(buffers); ++it) {
+                const asio::mutable_buffer buffer = *it;
+                if (buffer.size() > 0) {
+                    return impl.tls_read(static_cast<char*>(buffer.data()), buffer.size(), ec);
+                }
+            }
+            ec = {};
+            return 0;
+        }
+
+        template <typename Buffers>
+        std::size_t read_some(const Buffers& buffers) {
+            boost::system::error_code ec;
+            const std::size_t read = read_some(buffers, ec);
+            if (ec) {
+                throw boost::system::system_error(ec);
+            }
+            return read;
+        }
+
+        template <typename Buffers>
+        std::size_t write_some(const Buffers& buffers, boost::system::error_code& ec) {
+            for (auto it = asio::buffer_sequence_begin(buffers); it != asio::buffer_sequence_end(buffers); ++it) {
+                const asio::const_buffer buffer = *it;
+                if (buffer.size() > 0) {
+                    return impl.tls_write_some(static_cast<const char*>(buffer.data()), buffer.size(), ec);
+                }
+            }
+            ec = {};
+            return 0;
+        }
+
+        template <typename Buffers>
+        std::size_t write_some(const Buffers& buffers) {
+            boost::system::error_code ec;
+            const std::size_t written = write_some(buffers, ec);
+            if (ec) {
+                throw boost::system::system_error(ec);
+            }
+            return written;
+        }
+    };
+
+    /**
+     * @brief Sends the HTTP upgrade request and validates the 101 response (RFC 6455 section 4)
+     * 
+     * The response is read with Beast's HTTP parser into a local buffer. Whatever the parser
+     * read past the end of the response (frames the server sent right after the 101) is
+     * copied to the front of the receive buffer, so no frame is lost.
+     */
+    void upgrade() {
+        unsigned char nonce[16];
+        if (RAND_bytes(nonce, sizeof(nonce)) != 1) {
+            throw std::runtime_error("Cannot generate the WebSocket key");
+        }
+        const std::string key = base64(nonce, sizeof(nonce));
+
+        beast::http::request<beast::http::empty_body> request{beast::http::verb::get, config_.path, 11};
+        request.set(beast::http::field::host, config_.host);
+        request.set(beast::http::field::upgrade, "websocket");
+        request.set(beast::http::field::connection, "Upgrade");
+        request.set(beast::http::field::sec_websocket_key, key);
+        request.set(beast::http::field::sec_websocket_version, "13");
+        request.set(beast::http::field::user_agent, BOOST_BEAST_VERSION_STRING);
+        TlsStream stream{*this};
+        beast::http::write(stream, request);
+
+        beast::flat_buffer leftover;
+        beast::http::response<beast::http::string_body> response;
+        beast::http::read(stream, leftover, response);
+
+        const std::string accept_key = key + "258EAFA5-E914-47DA-95CA-C5AB0DC85B11";
+        unsigned char digest[SHA_DIGEST_LENGTH];
+        SHA1(reinterpret_cast<const unsigned char*>(accept_key.data()), accept_key.size(), digest);
+        if (response.result() != beast::http::status::switching_protocols ||
+            response[beast::http::field::sec_websocket_accept] != base64(digest, sizeof(digest))) {
+            throw std::runtime_error("WebSocket upgrade refused: HTTP " + std::to_string(response.result_int()));
+        }
+
+        const auto bytes = asio::buffer_cast<const char*>(leftover.data());
+        const std::size_t size = leftover.size();
+        if (buffer_.size() < size) {
+            buffer_.resize(size);
+        }
+        std::memcpy(buffer_.data(), bytes, size);
+        end_ = size;
+    }
+
+    /** @brief Standard base64 (with padding) of a binary string. */
+    static std::string base64(const unsigned char* data, std::size_t size) {
+        std::string encoded(4 * ((size + 2) / 3), '\0');
+        const int written = EVP_EncodeBlock(reinterpret_cast<unsigned char*>(&encoded[0]), data, static_cast<int>(size));
+        encoded.resize(static_cast<std::size_t>(std::max(written, 0)));
+        return encoded;
+    }
+
+    /**
+     * @brief Writes one client frame (RFC 6455 section 5.2): FIN set, masked with a random key
+     * 
+     * The frame is assembled in a reusable buffer and written with a single TLS write.
+     */
+    void write_frame(unsigned opcode, const char* payload, std::size_t length) {
+        std::size_t header_size = 2;
+        out_.resize(14 + length);
+        auto* frame = reinterpret_cast<unsigned char*>(out_.data());
+        frame[0] = static_cast<unsigned char>(0x80 | opcode);
+        if (length < 126) {
+            frame[1] = static_cast<unsigned char>(0x80 | length);
+        } else if (length <= 0xFFFF) {
+            frame[1] = 0x80 | 126;
+            frame[2] = static_cast<unsigned char>(length >> 8);
+            frame[3] = static_cast<unsigned char>(length);
+            header_size = 4;
+        } else {
+            frame[1] = 0x80 | 127;
+            for (int i = 0; i < 8; ++i) {
+                frame[2 + i] = static_cast<unsigned char>(static_cast<uint64_t>(length) >> (56 - 8 * i));
+            }
+            header_size = 10;
+        }
+
+        unsigned char* key = frame + header_size;
+        if (RAND_bytes(key, 4) != 1) {
+            throw std::runtime_error("Cannot generate a WebSocket masking key");
+        }
+        header_size += 4;
+        for (std::size_t i = 0; i < length; ++i) {
+            frame[header_size + i] = static_cast<unsigned char>(payload[i]) ^ key[i & 3];
+        }
+        tls_write(out_.data(), header_size + length);
+    }
+
+    /**
+     * @brief Compacts and, if needed, grows the receive buffer before a read
+     * 
+     * The partial frame left by the previous parse is moved to the front, and the buffer
+     * grows when the next frame does not fit.
+     */
+    void prepare_read() {
+        if (begin_ > 0) {
+            std::memmove(buffer_.data(), buffer_.data() + begin_, end_ - begin_);
+            end_ -= begin_;
+            begin_ = 0;
+        }
+        const std::size_t required = std::max(needed_, end_ + MIN_READ_SIZE);
+        if (buffer_.size() < required) {
+            buffer_.resize(std::max(required, buffer_.size() * 2));
+        }
+    }
+
+    /**
+     * @brief Reads from the TLS stream into the free tail of the receive buffer
+     * 
+     * After the blocking read, records OpenSSL has already decrypted are drained without
+     * another syscall.
+     */
+    void fill_buffer() {
+        prepare_read();
+        boost::system::error_code ec;
+        end_ += tls_read(buffer_.data() + end_, buffer_.size() - end_, ec);
+        while (!ec && end_ < buffer_.size() && SSL_pending(ssl_.get()) > 0) {
+            end_ += tls_read(buffer_.data() + end_, buffer_.size() - end_, ec);
+        }
+        if (ec) {
+            throw boost::system::system_error(ec);
+        }
+    }
+
+    /**
+     * @brief Reads until the server's close frame arrives, for at most `CLOSE_TIMEOUT`
+     * 
+     * The socket is switched to non-blocking mode so the wait can be bounded with poll.
+     */
+    void await_close() {
+        socket_.native_non_blocking(true);
+        const auto deadline = std::chrono::steady_clock::now() + CLOSE_TIMEOUT;
+        while (true) {
+            parse_frames();
+            batch_.clear(); // Data that raced the close is no longer wanted
+            if (peer_closed_) {
+                return;
+            }
+
+            prepare_read();
+            boost::system::error_code ec;
+            const std::size_t read = tls_read(buffer_.data() + end_, buffer_.size() - end_, ec);
+            if (!ec) {
+                end_ += read;
+                continue;
+            }
+            if (ec != asio::error::would_block && ec != asio::error::try_again) {
+                return; // The server closed the connection without a close frame
+            }
+
+            const auto left = std::chrono::duration_cast<std::chrono::milliseconds>(deadline - std::chrono::steady_clock::now());
+            pollfd fd{socket_.native_handle(), POLLIN, 0};
+            if (left.count() <= 0 || ::poll(&fd, 1, static_cast<int>(left.count())) <= 0) {
+                return;
+            }
+        }
+    }
+
+    /**
+     * @brief Parses every complete RFC 6455 frame in the buffer into `batch_`
+     * 
+     * Stops at the first incomplete frame and records its total size in `needed_`.
+     * Fragmented messages are reassembled in `fragment_`.
+     */
+    void parse_frames() {
+        needed_ = 0;
+        while (!peer_closed_) {
+            const std::size_t available = end_ - begin_;
+            if (available < 2) {
+                return;
+            }
+
+            const auto* header = reinterpret_cast<const unsigned char*>(buffer_.data() + begin_);
+            const bool fin = (header[0] & 0x80) != 0;
+            const unsigned opcode = header[0] & 0x0F;
+            const bool masked = (header[1] & 0x80) != 0;
+            uint64_t length = header[1] & 0x7F;
+            std::size_t header_size = 2;
+
+            if (length == 126) {
+                if (available < 4) {
+                    return;
+                }
+                length = (uint64_t{header[2]} << 8) | header[3];
+                header_size = 4;
+            } else if (length == 127) {
+                if (available < 10) {
+                    return;
+                }
+                length = 0;
+                for (int i = 2; i < 10; ++i) {
+                    length = (length << 8) | header[i];
+                }
+                header_size = 10;
+            }
+            if (length > MAX_FRAME_SIZE) {
+                throw std::runtime_error("WebSocket frame too large");
+            }
+            if (masked) {
+                header_size += 4;
+            }
+            if (available < header_size + length) {
+                needed_ = header_size + static_cast<std::size_t>(length);
+                return;
+            }
+
+            char* payload = buffer_.data() + begin_ + header_size;
+            if (masked) {
+                // Servers must not mask, but unmasking costs nothing if one does
+                const unsigned char* key = header + header_size - 4;
+                for (uint64_t i = 0; i < length; ++i) {
+                    payload[i] = static_cast<char>(payload[i] ^ key[i & 3]);
+                }
+            }
+            begin_ += header_size + static_cast<std::size_t>(length);
+
+            switch (opcode) {
+            case 0x1: // Text
+            case 0x2: // Binary
+                if (fin) {
+                    batch_.emplace_back(payload, static_cast<std::size_t>(length));
+                } else {
+                    fragment_.assign(payload, static_cast<std::size_t>(length));
+                }
+                break;
+            case 0x0: // Continuation
+                fragment_.append(payload, static_cast<std::size_t>(length));
+                if (fin) {
+                    batch_.push_back(std::move(fragment_));
+                    fragment_.clear();
+                }
+                break;
+            case 0x8: // Close: echo the status code, unless this answers our own close
+                if (!close_sent_) {
+                    write_frame(0x8, payload, std::min<std::size_t>(static_cast<std::size_t>(length), 2));
+                    close_sent_ = true;
+                }
+                peer_closed_ = true;
+                break;
+            case 0x9: // Ping (not answered once our close frame is out)
+                if (!close_sent_) {
+                    write_frame(0xA, payload, std::min<std::size_t>(static_cast<std::size_t>(length), 125));
+                }
+                break;
+            default: // Pong and reserved opcodes
+                break;
+            }
+        }
+    }
+
 private:
     Config config_;
     std::shared_ptr<asio::io_context> ioc_;
     asio::ssl::context ssl_ctx_;
-    websocket::stream<asio::ssl::stream<asio::ip::tcp::socket>> ws_stream_;
+    asio::ip::tcp::socket socket_;
+    std::unique_ptr<SSL, decltype(&SSL_free)> ssl_{nullptr, &SSL_free}; // TLS session on socket_
+
+    static constexpr std::chrono::milliseconds CONNECTION_ATTEMPT_DELAY{250}; // RFC 8305 recommendation
+    static constexpr std::size_t MIN_READ_SIZE = 16 * 1024;           // One full TLS record
+    static constexpr uint64_t MAX_FRAME_SIZE = 64ull * 1024 * 1024;   // Protocol error above this
+    static constexpr std::chrono::seconds CLOSE_TIMEOUT{1};           // Wait for the server's close frame
+
+    std::vector<char> buffer_;          // Persistent receive buffer; [begin_, end_) is unparsed
+    std::size_t begin_{0};
+    std::size_t end_{0};
+    std::size_t needed_{0};             // Size of the incomplete frame at begin_, if known
+    std::string fragment_;              // Message being reassembled from fragments
+    std::vector<std::string> batch_;    // Messages of the current batch
+    std::vector<char> out_;             // Frame being written (header, masking key, masked payload)
+    bool peer_closed_{false};
+    bool close_sent_{false};
     
     std::mutex mutex_;
     State state_;
     std::optional<std::string> last_error_;
+    bool ktls_send_{false};
+    bool ktls_recv_{false};
 };
 
 // Remaining wrapper methods remain the same as in the original implementation
@@ -240,10 +828,22 @@ void WebSocketClient::receive(std::function<void(const std::string&)> callback)
     pimpl_->receive(callback);
 }
 
+void WebSocketClient::receive_batch(std::function<void(const std::vector<std::string>&)> callback) {
+    pimpl_->receive_batch(callback);
+}
+
+bool WebSocketClient::wait_readable(std::chrono::milliseconds timeout, int wake_fd) {
+    return pimpl_->wait_readable(timeout, wake_fd);
+}
+
 WebSocketClient::State WebSocketClient::get_state() const {
     return pimpl_->get_state();
 }
 
+bool WebSocketClient::ktls_active() const {
+    return pimpl_->ktls_active();
+}
+
 std::optional<std::string> WebSocketClient::get_last_error() const {
     return pimpl_->get_last_error();
-}
\ No newline at end of file
+}
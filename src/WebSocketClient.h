@@ -5,11 +5,12 @@
 #include <boost/beast.hpp>
 #include <boost/beast/websocket.hpp>
 #include <boost/asio/ssl.hpp>
-#include <boost/beast/websocket/ssl.hpp>
+#include <chrono>
 #include <string>
 #include <functional>
 #include <memory>
 #include <optional>
+#include <vector>
 
 /**
  * @file WebSocketClient.h
@@ -19,42 +20,12 @@
  *
  * The WebSocketClient class provides an interface for establishing secure 
  * WebSocket connections, sending and receiving messages, handling connection 
- * states, and managing error conditions. It supports synchronous and asynchronous 
+ * states, and managing error conditions. Beast performs the HTTP upgrade; RFC 6455
+ * frames are then read and written directly on the TLS stream. It supports synchronous and asynchronous 
  * communication, making it suitable for real-time data streaming applications like 
  * trading platforms.
  */
 
-namespace boost::beast::websocket {
-    /**
-     * @brief Custom teardown function for SSL streams.
-     *
-     * This function ensures proper shutdown of SSL connections by first shutting 
-     * down the SSL stream and then closing the underlying TCP socket. It also 
-     * handles specific errors like incomplete handshakes gracefully.
-     *
-     * @tparam Teardown A custom teardown policy, if any.
-     * @param role Specifies the WebSocket role (client/server).
-     * @param socket The SSL stream wrapping the TCP socket.
-     * @param ec Error code to store any shutdown errors.
-     */
-    template <typename Teardown>
-    void teardown(role_type role,
-        boost::asio::ssl::stream<boost::asio::ip::tcp::socket>& socket,
-        boost::system::error_code& ec)
-    {
-        // Shutdown SSL stream first
-        socket.shutdown(ec);
-
-        // If shutdown fails due to a handshake not being completed, ignore the error
-        if (ec == boost::asio::error::invalid_argument)
-            ec = {};
-
-        // Then close the underlying socket
-        if (socket.lowest_layer().is_open())
-            socket.lowest_layer().close(ec);
-    }
-}
-
 namespace asio = boost::asio;
 namespace beast = boost::beast;
 namespace websocket = beast::websocket;
@@ -102,6 +73,8 @@ public:
         bool verify_ssl{true};              /**< Whether to verify the SSL certificate. */
         std::chrono::seconds connect_timeout{10}; /**< Timeout for connection attempts. */
         std::chrono::seconds read_timeout{30};    /**< Timeout for reading messages. */
+        std::size_t read_buffer_size{64 * 1024};  /**< Initial size of the persistent receive buffer (grows for larger frames). */
+        bool enable_ktls{false};                  /**< Hand TLS record encryption to the kernel (kTLS) when available. */
     };
 
     /**
@@ -185,10 +158,39 @@ public:
      * @param callback A function to process the received message.
      * 
      * Blocks until a message is received and then invokes the callback function 
-     * with the received message. Throws exceptions on connection errors.
+     * with the received message. When one read returned several messages, the
+     * callback is invoked for each of them before returning. Throws exceptions on
+     * connection errors.
      */
     void receive(std::function<void(const std::string&)> callback);
 
+    /**
+     * @brief Receives all messages available after one blocking read.
+     * 
+     * @param callback A function invoked once with every complete message, in order.
+     * 
+     * Data is read in large chunks into a persistent buffer and parsed into as many
+     * complete frames as it holds, so a burst of small messages costs one read (and
+     * one pass over the TLS records) instead of one per message. Pings are answered
+     * automatically. Throws exceptions on connection errors.
+     */
+    void receive_batch(std::function<void(const std::vector<std::string>&)> callback);
+
+    /**
+     * @brief Waits until a receive can make progress without blocking for new data.
+     * 
+     * @param timeout The longest time to wait.
+     * @param wake_fd An optional descriptor (e.g., an eventfd) that ends the wait when it
+     *                becomes readable; -1 for none.
+     * @return True if buffered or incoming data is ready for `receive`/`receive_batch`; false
+     *         if the timeout expired or `wake_fd` was signalled.
+     * 
+     * Lets one thread both read the connection and send requests queued by other threads:
+     * TLS reads and writes cannot overlap on one connection, so a thread blocked in `receive`
+     * would hold back every send. The socket is polled without holding the client's lock.
+     */
+    bool wait_readable(std::chrono::milliseconds timeout, int wake_fd = -1);
+
     /**
      * @brief Asynchronously receives messages.
      * 
@@ -215,6 +217,15 @@ public:
      */
     bool is_connected() const;
 
+    /**
+     * @brief Checks whether the connection's TLS records are processed by the kernel.
+     *
+     * @return True if kTLS was requested and the kernel took over both the send and the receive
+     *         direction after the handshake. Requires OpenSSL 3 built with kTLS, the Linux `tls`
+     *         module and a kTLS-capable cipher (AES-GCM or ChaCha20-Poly1305).
+     */
+    bool ktls_active() const;
+
     // --- Error Handling ---
 
     /**
@@ -119,14 +119,14 @@ std::string AccountManager::getAccountSummary() {
  * ### API Data:
  * - **Endpoint**: `/private/get_positions`
  * - **Parameters**:
- *   - `currency`: Specifies the currency (e.g., "BTC") for which positions are requested.
- *   - `kind`: Specifies the kind of positions (e.g., "future").
+ *   - `currency`: Specifies the currency (e.g., "BTC", or "any") for which positions are requested.
+ *   - `kind`: Specifies the kind of positions (e.g., "future"); omitted to request every kind.
  * - **Response**: Includes details such as instrument names, sizes, entry prices, and profits.
  *
  * ### Error Handling:
  * - Logs any CURL initialization errors, network issues, or API response errors.
  */
-std::string AccountManager::getPositions() {
+std::string AccountManager::getPositions(const std::string& currency, const std::string& kind) {
     CURL* curl = curl_easy_init(); // Initialize a CURL handle for HTTP requests
     std::string response;          // Buffer to store the API response
 
@@ -139,8 +139,11 @@ std::string AccountManager::getPositions() {
             {"jsonrpc", "2.0"},              // JSON-RPC version
             {"method", "private/get_positions"}, // API method name
             {"id", 1},                       // Request ID for tracking
-            {"params", {{"currency", "BTC"}, {"kind", "future"}}} // Parameters for currency and kind of positions
+            {"params", {{"currency", currency}}} // Currency of the positions
         };
+        if (!kind.empty()) {
+            requestBody["params"]["kind"] = kind; // Kind of the positions, all kinds if omitted
+        }
 
         std::string data = requestBody.dump(); // Serialize the JSON request to a string
 
@@ -165,3 +168,64 @@ std::string AccountManager::getPositions() {
 
     return response;
 }
+
+/**
+ * @brief Fetches the open positions and rebuilds the local position cache.
+ *
+ * @return True if the cache was refreshed, false if the response was empty or malformed.
+ *
+ * ### Error Handling:
+ * - Returns false without touching the cache if the request fails or the API reports an error.
+ */
+bool AccountManager::refreshPositions() {
+    std::string response = getPositions();
+    if (response.empty()) {
+        return false;
+    }
+
+    json parsed = json::parse(response, nullptr, false);
+    if (parsed.is_discarded() || parsed.contains("error") || !parsed.contains("result")) {
+        std::cerr << "Failed to refresh positions: " << response << std::endl;
+        return false;
+    }
+
+    positions.clear();
+    applyPositionUpdates(parsed["result"]);
+    return true;
+}
+
+/**
+ * @brief Merges position objects into the cache.
+ *
+ * @param data Either a `user.changes.*` payload (with a `positions` array) or an array of positions.
+ */
+void AccountManager::applyPositionUpdates(const json& data) {
+    const json& list = data.is_object() ? data.value("positions", json::array()) : data;
+    if (!list.is_array()) {
+        return;
+    }
+
+    for (const auto& entry : list) {
+        const std::string instrument = entry.value("instrument_name", "");
+        if (instrument.empty()) {
+            continue;
+        }
+
+        const double size = entry.value("size", 0.0);
+        if (size == 0.0) {
+            positions.erase(instrument);
+            continue;
+        }
+
+        Position& position = positions[instrument];
+        position.instrument = instrument;
+        position.kind = entry.value("kind", "");
+        position.size = size;
+        position.averagePrice = entry.value("average_price", 0.0);
+        position.markPrice = entry.value("mark_price", 0.0);
+    }
+}
+
+const std::unordered_map<std::string, Position>& AccountManager::cachedPositions() const {
+    return positions;
+}
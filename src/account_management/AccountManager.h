@@ -2,6 +2,8 @@
 #define ACCOUNT_MANAGER_H
 
 #include <string>
+#include <unordered_map>
+#include <nlohmann/json_fwd.hpp>
 
 /**
  * @file AccountManager.h
@@ -16,6 +18,8 @@
  * ### Key Responsibilities:
  * - Fetch the account summary, including balance and currency details.
  * - Retrieve the current open positions in the user's trading account.
+ * - Keep a local position cache that other components (e.g., funding projections) can read
+ *   without issuing REST requests.
  *
  * ### Integration with the Trading System:
  * The `AccountManager` class is a crucial component of the trading system, enabling users to view
@@ -23,6 +27,19 @@
  * components, such as the `AuthManager` for authentication and `OrderManager` for trade execution.
  */
 
+/**
+ * @struct Position
+ *
+ * @brief A cached open position, as reported by `/private/get_positions` or `user.changes` notifications.
+ */
+struct Position {
+    std::string instrument;       /**< The instrument name (e.g., "BTC-PERPETUAL"). */
+    std::string kind;             /**< The instrument kind ("future", "option", ...). */
+    double size{0.0};             /**< Signed position size (USD for inverse futures, negative when short). */
+    double averagePrice{0.0};     /**< Average entry price. */
+    double markPrice{0.0};        /**< Mark price at the time of the last update. */
+};
+
 /**
  * @class AccountManager
  *
@@ -85,6 +102,8 @@ public:
     /**
      * @brief Fetches the current open positions from the trading platform API.
      *
+     * @param currency The currency of the positions (e.g., "BTC"), or "any" for every currency.
+     * @param kind The instrument kind (e.g., "future"), or empty for every kind.
      * @return A JSON-formatted string containing details of active trading positions.
      *
      * ### Workflow:
@@ -102,7 +121,35 @@ public:
      * - **Endpoint**: `/private/get_positions`
      * - **Response**: Includes details such as instrument names, sizes, entry prices, and profits.
      */
-    std::string getPositions();
+    std::string getPositions(const std::string& currency = "any", const std::string& kind = "");
+
+    /**
+     * @brief Fetches the open positions and replaces the local position cache with them.
+     *
+     * @return True if the response could be parsed and the cache was refreshed.
+     *
+     * ### Workflow:
+     * - Calls `getPositions` once for every currency and kind (typically at startup).
+     * - Parses the `result` array into `Position` entries keyed by instrument name.
+     * - Later changes should be fed incrementally through `applyPositionUpdates` from
+     *   `user.changes.any.any.100ms`.
+     */
+    bool refreshPositions();
+
+    /**
+     * @brief Applies position updates pushed by the exchange to the local cache.
+     *
+     * @param data The `data` object of a `user.changes.*` notification (its `positions` array is
+     *             used), or a plain array of position objects.
+     *
+     * Positions whose size drops to zero are removed from the cache.
+     */
+    void applyPositionUpdates(const nlohmann::json& data);
+
+    /**
+     * @brief Returns the cached open positions keyed by instrument name.
+     */
+    const std::unordered_map<std::string, Position>& cachedPositions() const;
 
 private:
     /**
@@ -112,6 +159,11 @@ private:
      * the `AccountManager` class and is not exposed directly to external components.
      */
     std::string accessToken;
+
+    /**
+     * @brief Local cache of open positions keyed by instrument name.
+     */
+    std::unordered_map<std::string, Position> positions;
 };
 
 #endif // ACCOUNT_MANAGER_H
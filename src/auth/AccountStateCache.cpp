@@ -0,0 +1,71 @@
+#include "AccountStateCache.h"
+
+/**
+ * @file AccountStateCache.cpp
+ *
+ * @brief Implements the seqlock-protected `AccountStateCache`.
+ */
+
+AccountStateCache::AccountStateCache() : used(0) {}
+
+std::size_t AccountStateCache::allocate() {
+    return used < CAPACITY ? used++ : INVALID_SLOT;
+}
+
+/**
+ * @brief Odd sequence while writing, next even value once the fields are published.
+ */
+void AccountStateCache::store(std::size_t slot, const AccountState& state) {
+    if (slot >= used) {
+        return;
+    }
+
+    Slot& target = slots[slot];
+    const uint32_t sequence = target.sequence.load(std::memory_order_relaxed);
+    target.sequence.store(sequence + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    target.equity.store(state.equity, std::memory_order_relaxed);
+    target.balance.store(state.balance, std::memory_order_relaxed);
+    target.availableFunds.store(state.availableFunds, std::memory_order_relaxed);
+    target.initialMargin.store(state.initialMargin, std::memory_order_relaxed);
+    target.maintenanceMargin.store(state.maintenanceMargin, std::memory_order_relaxed);
+    target.timestamp.store(state.timestamp, std::memory_order_relaxed);
+
+    target.sequence.store(sequence + 2, std::memory_order_release);
+}
+
+/**
+ * @brief Retries until the fields were copied between two equal, even sequence values.
+ */
+bool AccountStateCache::load(std::size_t slot, AccountState& out) const {
+    if (slot >= used) {
+        return false;
+    }
+
+    const Slot& source = slots[slot];
+    uint32_t before = 0;
+    uint32_t after = 0;
+    do {
+        before = source.sequence.load(std::memory_order_acquire);
+        if (before & 1u) {
+            continue; // Write in progress
+        }
+
+        out.equity = source.equity.load(std::memory_order_relaxed);
+        out.balance = source.balance.load(std::memory_order_relaxed);
+        out.availableFunds = source.availableFunds.load(std::memory_order_relaxed);
+        out.initialMargin = source.initialMargin.load(std::memory_order_relaxed);
+        out.maintenanceMargin = source.maintenanceMargin.load(std::memory_order_relaxed);
+        out.timestamp = source.timestamp.load(std::memory_order_relaxed);
+
+        std::atomic_thread_fence(std::memory_order_acquire);
+        after = source.sequence.load(std::memory_order_relaxed);
+    } while ((before & 1u) || before != after);
+
+    return before != 0;
+}
+
+std::size_t AccountStateCache::size() const {
+    return used;
+}
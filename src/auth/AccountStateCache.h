@@ -0,0 +1,104 @@
+#ifndef ACCOUNT_STATE_CACHE_H
+#define ACCOUNT_STATE_CACHE_H
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <cstddef>
+
+/**
+ * @file AccountStateCache.h
+ *
+ * @brief Defines the `AccountStateCache` class, a fixed-size table of per-account portfolio state
+ *        that any thread can read without locks.
+ *
+ * Each account/currency pair owns one slot, written only by the receive thread of its session.
+ * Every slot is protected by a sequence lock: the writer bumps the sequence to an odd value, writes
+ * the fields, and bumps it to the next even value; readers retry if the sequence was odd or changed
+ * while they copied the fields. Readers never block the writer, and the writer never waits.
+ */
+
+/**
+ * @struct AccountState
+ *
+ * @brief A snapshot of one account's portfolio in one currency (from `user.portfolio.{currency}`).
+ */
+struct AccountState {
+    double equity{0.0};            /**< Account equity. */
+    double balance{0.0};           /**< Balance. */
+    double availableFunds{0.0};    /**< Funds available for new orders. */
+    double initialMargin{0.0};     /**< Initial margin in use. */
+    double maintenanceMargin{0.0}; /**< Maintenance margin in use. */
+    int64_t timestamp{0};          /**< Local receive time (ms since epoch). */
+};
+
+/**
+ * @class AccountStateCache
+ *
+ * @brief Seqlock-protected slots of `AccountState`.
+ *
+ * Slots are allocated during setup (before any writer thread starts); after that, `store` and
+ * `load` are safe to call concurrently as long as each slot has a single writer.
+ *
+ * ### Example:
+ * ```
+ * AccountStateCache cache;
+ * std::size_t slot = cache.allocate();
+ * cache.store(slot, state);      // session receive thread
+ * AccountState snapshot;
+ * cache.load(slot, snapshot);    // any thread
+ * ```
+ */
+class AccountStateCache {
+public:
+    /** @brief Maximum number of account/currency slots. */
+    static constexpr std::size_t CAPACITY = 256;
+
+    /** @brief Value returned by `allocate` when the cache is full. */
+    static constexpr std::size_t INVALID_SLOT = static_cast<std::size_t>(-1);
+
+    AccountStateCache();
+
+    /**
+     * @brief Reserves a slot; setup-time only, not thread-safe.
+     *
+     * @return The slot index, or `INVALID_SLOT` if the cache is full.
+     */
+    std::size_t allocate();
+
+    /** @brief Publishes a new state into a slot (single writer per slot). */
+    void store(std::size_t slot, const AccountState& state);
+
+    /**
+     * @brief Copies a consistent snapshot of a slot.
+     *
+     * @return False if the slot is invalid or has never been written.
+     */
+    bool load(std::size_t slot, AccountState& out) const;
+
+    /** @brief Returns the number of allocated slots. */
+    std::size_t size() const;
+
+private:
+    /**
+     * @brief One seqlock-protected record, on its own cache line so writers of neighbouring slots
+     *        do not invalidate each other's readers.
+     *
+     * Fields are relaxed atomics so concurrent reads during a write are well-defined; the sequence
+     * counter provides the ordering.
+     */
+    struct alignas(64) Slot {
+        std::atomic<uint32_t> sequence{0};
+        std::atomic<double> equity{0.0};
+        std::atomic<double> balance{0.0};
+        std::atomic<double> availableFunds{0.0};
+        std::atomic<double> initialMargin{0.0};
+        std::atomic<double> maintenanceMargin{0.0};
+        std::atomic<int64_t> timestamp{0};
+    };
+
+    std::array<Slot, CAPACITY> slots;
+    std::size_t used;
+};
+
+#endif // ACCOUNT_STATE_CACHE_H
@@ -178,3 +178,24 @@ std::string AuthManager::authenticate() {
         return "";
     }
 }
+
+/**
+ * @brief Builds the `public/auth` request used to authorize a WebSocket connection.
+ *
+ * @param requestId The JSON-RPC id to use for the request.
+ * @return The serialized JSON-RPC request using the client credentials grant.
+ */
+std::string AuthManager::buildWebSocketAuthRequest(uint64_t requestId) const {
+    json requestBody = {
+        {"jsonrpc", "2.0"},
+        {"method", "public/auth"},
+        {"id", requestId},
+        {"params", {
+            {"grant_type", "client_credentials"},
+            {"client_id", clientId},
+            {"client_secret", clientSecret},
+            {"scope", "trade:read_write"}
+        }}
+    };
+    return requestBody.dump();
+}
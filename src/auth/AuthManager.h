@@ -1,6 +1,7 @@
 #ifndef AUTH_MANAGER_H
 #define AUTH_MANAGER_H
 
+#include <cstdint>
 #include <string>
 
 /**
@@ -89,6 +90,19 @@ public:
      */
     std::string authenticate();
 
+    /**
+     * @brief Builds a `public/auth` JSON-RPC request for authorizing a WebSocket connection.
+     *
+     * @param requestId The JSON-RPC id to use for the request (allocated from the connection's `InflightRequests`).
+     * @return The serialized request, to be sent as the first message on the connection.
+     *
+     * ### Purpose:
+     * - WebSocket sessions are authorized per connection; a token obtained over HTTP does not
+     *   authorize an existing socket.
+     * - Authorized connections unlock private channels such as `book.{instrument}.raw`.
+     */
+    std::string buildWebSocketAuthRequest(uint64_t requestId) const;
+
 private:
     /**
      * @brief The client ID provided by the trading platform for authentication.
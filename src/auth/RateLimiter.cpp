@@ -0,0 +1,40 @@
+#include "RateLimiter.h"
+#include <algorithm>
+
+/**
+ * @file RateLimiter.cpp
+ *
+ * @brief Implements the `RateLimiter` token bucket.
+ */
+
+RateLimiter::RateLimiter(Config limits)
+    : config(limits), tokens(limits.burst), lastRefill(Clock::now()), rejectedCount(0) {}
+
+bool RateLimiter::tryAcquire(double cost) {
+    std::lock_guard<std::mutex> lock(mutex);
+    refillLocked();
+    if (tokens < cost) {
+        ++rejectedCount;
+        return false;
+    }
+    tokens -= cost;
+    return true;
+}
+
+double RateLimiter::available() {
+    std::lock_guard<std::mutex> lock(mutex);
+    refillLocked();
+    return tokens;
+}
+
+unsigned long RateLimiter::rejected() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return rejectedCount;
+}
+
+void RateLimiter::refillLocked() {
+    const auto now = Clock::now();
+    const double elapsed = std::chrono::duration<double>(now - lastRefill).count();
+    tokens = std::min(config.burst, tokens + elapsed * config.ratePerSecond);
+    lastRefill = now;
+}
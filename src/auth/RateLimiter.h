@@ -0,0 +1,74 @@
+#ifndef RATE_LIMITER_H
+#define RATE_LIMITER_H
+
+#include <chrono>
+#include <mutex>
+
+/**
+ * @file RateLimiter.h
+ *
+ * @brief Defines the `RateLimiter` class, a token bucket mirroring Deribit's per-account credit system.
+ *
+ * Deribit limits each account (and each subaccount) separately: every request costs credits, and
+ * credits refill at a fixed rate up to a maximum. Tracking the bucket locally lets a session refuse
+ * or delay a request before the exchange rejects it with `too_many_requests`.
+ */
+
+/**
+ * @class RateLimiter
+ *
+ * @brief Thread-safe token bucket.
+ *
+ * ### Example:
+ * ```
+ * RateLimiter limiter(RateLimiter::Config{20.0, 50.0}); // 20 requests/s, bursts of 50
+ * if (limiter.tryAcquire()) {
+ *     orderManager.placeOrder("BTC-PERPETUAL", "buy", 10, 30000);
+ * }
+ * ```
+ */
+class RateLimiter {
+public:
+    /**
+     * @struct Config
+     *
+     * @brief Refill rate and capacity of the bucket.
+     *
+     * The defaults match Deribit's default matching-engine limit for an account.
+     */
+    struct Config {
+        double ratePerSecond{20.0}; /**< Tokens added per second. */
+        double burst{50.0};         /**< Maximum number of tokens (bucket capacity). */
+    };
+
+    /** @brief Constructs a full bucket. */
+    explicit RateLimiter(Config config);
+
+    /**
+     * @brief Takes tokens if enough are available.
+     *
+     * @param cost The number of tokens the request costs.
+     * @return True if the tokens were taken; false if the request would exceed the limit.
+     */
+    bool tryAcquire(double cost = 1.0);
+
+    /** @brief Returns the number of tokens currently available. */
+    double available();
+
+    /** @brief Returns the number of requests refused since construction. */
+    unsigned long rejected() const;
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    /** @brief Adds the tokens accrued since the last refill; the caller must hold the mutex. */
+    void refillLocked();
+
+    Config config;
+    mutable std::mutex mutex;
+    double tokens;
+    Clock::time_point lastRefill;
+    unsigned long rejectedCount;
+};
+
+#endif // RATE_LIMITER_H
@@ -0,0 +1,422 @@
+#include "SessionManager.h"
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <future>
+#include <iostream>
+#include <sys/eventfd.h>
+#include <unistd.h>
+#include <nlohmann/json.hpp>
+#include <fmt/color.h>
+#include <fmt/format.h>
+
+// Define color constants for clarity
+const auto ERROR_COLOR = fmt::fg(fmt::color::red);
+const auto SUCCESS_COLOR = fmt::fg(fmt::color::cyan);
+const auto INFO_COLOR = fmt::fg(fmt::color::blue);
+const auto HIGHLIGHT_COLOR = fmt::fg(fmt::color::yellow);
+
+using json = nlohmann::json;
+
+/**
+ * @file SessionManager.cpp
+ *
+ * @brief Implements the `SessionManager` class, which runs several authenticated accounts with
+ *        per-account connections and rate limits.
+ */
+
+namespace {
+
+/** @brief Heartbeat interval (seconds) requested from the exchange. */
+constexpr int HEARTBEAT_INTERVAL = 10;
+
+/** @brief Minimum time between two probes of a connection; also the longest idle wait of a receive loop. */
+constexpr std::chrono::seconds PROBE_INTERVAL{1};
+
+/**
+ * @brief How long `placeOrder` waits for its completion: the ring expires an unanswered request
+ *        after its default 5s timeout, and the receive loop runs `expire` at least once per `PROBE_INTERVAL`.
+ */
+constexpr std::chrono::milliseconds ORDER_REPLY_TIMEOUT = std::chrono::seconds(5) + 2 * PROBE_INTERVAL;
+
+std::string toUpper(std::string text) {
+    std::transform(text.begin(), text.end(), text.begin(), [](unsigned char c) { return std::toupper(c); });
+    return text;
+}
+
+std::string toLower(std::string text) {
+    std::transform(text.begin(), text.end(), text.begin(), [](unsigned char c) { return std::tolower(c); });
+    return text;
+}
+
+} // namespace
+
+Session::~Session() {
+    if (wakeFd >= 0) {
+        ::close(wakeFd);
+    }
+}
+
+SessionManager::SessionManager(WebSocketClient::Config config) : wsConfig(std::move(config)), running(false) {}
+
+SessionManager::~SessionManager() {
+    stop();
+}
+
+std::vector<SessionConfig> SessionManager::parseConfigs(const json& accounts) {
+    std::vector<SessionConfig> configs;
+    if (!accounts.is_array()) {
+        return configs;
+    }
+
+    for (const auto& entry : accounts) {
+        SessionConfig config;
+        config.accountId = entry.value("account_id", "");
+        config.clientId = entry.value("client_id", "");
+        config.clientSecret = entry.value("client_secret", "");
+        if (config.accountId.empty() || config.clientId.empty() || config.clientSecret.empty()) {
+            continue;
+        }
+
+        if (entry.contains("currencies") && entry["currencies"].is_array()) {
+            config.currencies = entry["currencies"].get<std::vector<std::string>>();
+        }
+        config.limits.ratePerSecond = entry.value("rate_per_second", config.limits.ratePerSecond);
+        config.limits.burst = entry.value("burst", config.limits.burst);
+
+        // Redundant connections share the credentials; the primary follows the portfolio
+        const int connections = entry.value("connections", 1);
+        configs.push_back(config);
+        for (int i = 2; i <= connections; ++i) {
+            SessionConfig redundant = config;
+            redundant.accountId = config.accountId + "#" + std::to_string(i);
+            redundant.currencies.clear();
+            redundant.redundantOf = config.accountId;
+            configs.push_back(std::move(redundant));
+        }
+    }
+    return configs;
+}
+
+/**
+ * @brief Authenticates over REST, builds the per-account managers and opens the WebSocket.
+ *
+ * The WebSocket is authorized right away; private subscriptions are sent by the receive loop once
+ * the authorization has been confirmed.
+ */
+bool SessionManager::addSession(const SessionConfig& config) {
+    if (running || byAccount.count(config.accountId) > 0) {
+        return false;
+    }
+    if (!config.redundantOf.empty() && byAccount.count(config.redundantOf) == 0) {
+        std::cerr << fmt::format(ERROR_COLOR, "Connection {} backs up unknown account {}\n", config.accountId, config.redundantOf);
+        return false;
+    }
+
+    auto session = std::make_unique<Session>();
+    session->config = config;
+    session->auth = std::make_unique<AuthManager>(config.clientId, config.clientSecret);
+    session->token = session->auth->authenticate();
+    if (session->token.empty()) {
+        std::cerr << fmt::format(ERROR_COLOR, "Authentication failed for account {}\n", config.accountId);
+        return false;
+    }
+
+    for (const auto& currency : config.currencies) {
+        const std::size_t slot = states.allocate();
+        if (slot == AccountStateCache::INVALID_SLOT) {
+            std::cerr << fmt::format(ERROR_COLOR, "Account state cache is full, cannot add {}\n", config.accountId);
+            return false;
+        }
+        session->slots[toUpper(currency)] = slot;
+    }
+
+    session->orders = std::make_unique<OrderManager>(session->token);
+    session->account = std::make_unique<AccountManager>(session->token);
+    session->limiter = std::make_unique<RateLimiter>(config.limits);
+    session->ws = std::make_unique<WebSocketClient>(wsConfig);
+    session->wakeFd = ::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (session->wakeFd < 0) {
+        std::cerr << fmt::format(ERROR_COLOR, "Cannot create the wake-up descriptor for account {}\n", config.accountId);
+        return false;
+    }
+
+    // Every request on the connection takes its ID from the session's ring; the reply runs the completion
+    Session* target = session.get();
+    const uint64_t authId = session->requests.allocate(RpcMethod::PublicAuth, [this, target](const json* response) {
+        onAuthorized(*target, response);
+    });
+
+    try {
+        session->ws->connect();
+        session->ws->send(session->auth->buildWebSocketAuthRequest(authId));
+    } catch (const std::exception& e) {
+        std::cerr << fmt::format(ERROR_COLOR, "WebSocket connection failed for account {}: {}\n", config.accountId, e.what());
+        return false;
+    }
+
+    fmt::print(SUCCESS_COLOR, "Session ready for account {}\n", config.accountId);
+    byAccount[config.accountId] = session.get();
+    sessions.push_back(std::move(session));
+    return true;
+}
+
+void SessionManager::start() {
+    if (running.exchange(true)) {
+        return;
+    }
+    for (auto& session : sessions) {
+        Session* target = session.get();
+        target->receiver = std::thread([this, target]() { receiveLoop(*target); });
+    }
+}
+
+void SessionManager::stop() {
+    if (!running.exchange(false)) {
+        return;
+    }
+    for (auto& session : sessions) {
+        wake(*session);
+    }
+    for (auto& session : sessions) {
+        if (session->receiver.joinable()) {
+            session->receiver.join();
+        }
+        session->ws->disconnect();
+    }
+}
+
+void SessionManager::wake(Session& session) {
+    const uint64_t signal = 1;
+    if (::write(session.wakeFd, &signal, sizeof(signal)) < 0) {
+        // The counter is already non-zero (EAGAIN): the thread is woken up anyway
+    }
+}
+
+/**
+ * @brief Owns the connection: reads messages, writes the requests queued by other threads (orders)
+ *        and by completions, and probes the round trip.
+ *
+ * TLS reads and writes cannot overlap on one connection, so this thread is the only one to use
+ * `ws`. It blocks in `wait_readable` rather than in `receive`, so a queued order only waits for the
+ * eventfd wake-up, never for the next incoming message.
+ */
+void SessionManager::receiveLoop(Session& session) {
+    session.receiving = true;
+    while (running) {
+        try {
+            if (session.ws->wait_readable(PROBE_INTERVAL, session.wakeFd)) {
+                session.ws->receive([this, &session](const std::string& message) { handleMessage(session, message); });
+            }
+            session.requests.expire();
+
+            // Reset the wake-up counter before taking the queue, so a later push signals again
+            uint64_t signals;
+            if (::read(session.wakeFd, &signals, sizeof(signals)) < 0) {
+                // EAGAIN: nothing was queued
+            }
+            std::vector<std::string> requests;
+            {
+                std::lock_guard<std::mutex> lock(session.sendMutex);
+                requests.swap(session.sendQueue);
+            }
+            requests.insert(requests.end(), session.outbox.begin(), session.outbox.end());
+            session.outbox.clear();
+            for (const auto& request : requests) {
+                session.ws->send(request);
+            }
+
+            // One probe in flight at a time; the loop wakes up at least once per `PROBE_INTERVAL`. The ring
+            // smooths the round trips of public/test, and a timed-out probe leaves the estimate as is
+            const auto now = std::chrono::steady_clock::now();
+            if (!session.probePending && now - session.probeSentAt >= PROBE_INTERVAL) {
+                std::string probe = session.requests.request(RpcMethod::PublicTest, json::object(), [&session](const json* response) {
+                    if (response) {
+                        session.rttMicros.store(session.requests.rtt(RpcMethod::PublicTest).smoothedMicros, std::memory_order_relaxed);
+                    }
+                    session.probePending = false;
+                });
+                if (!probe.empty()) {
+                    session.probeSentAt = now;
+                    session.probePending = true;
+                    session.ws->send(probe);
+                }
+            }
+        } catch (const std::exception& e) {
+            std::cerr << fmt::format(ERROR_COLOR, "Session {} stopped receiving: {}\n", session.config.accountId, e.what());
+            break;
+        }
+    }
+    session.receiving = false;
+}
+
+void SessionManager::handleMessage(Session& session, const std::string& message) {
+    json notification = json::parse(message, nullptr, false);
+    if (notification.is_discarded()) {
+        return;
+    }
+
+    // Replies to requests of this connection run their completions
+    if (session.requests.complete(notification)) {
+        return;
+    }
+
+    const std::string method = notification.value("method", "");
+    if (method == "heartbeat") {
+        if (notification["params"].value("type", "") == "test_request") {
+            std::string reply = session.requests.request(RpcMethod::PublicTest, json::object());
+            if (!reply.empty()) {
+                session.outbox.push_back(std::move(reply));
+            }
+        }
+        return;
+    }
+
+    if (method != "subscription") {
+        return;
+    }
+
+    const json& params = notification["params"];
+    if (params.value("channel", "").rfind("user.portfolio.", 0) != 0 || !params.contains("data")) {
+        return;
+    }
+
+    const json& data = params["data"];
+    auto slot = session.slots.find(toUpper(data.value("currency", "")));
+    if (slot == session.slots.end()) {
+        return;
+    }
+
+    AccountState state;
+    state.equity = data.value("equity", 0.0);
+    state.balance = data.value("balance", 0.0);
+    state.availableFunds = data.value("available_funds", 0.0);
+    state.initialMargin = data.value("initial_margin", 0.0);
+    state.maintenanceMargin = data.value("maintenance_margin", 0.0);
+    state.timestamp = std::chrono::duration_cast<std::chrono::milliseconds>(
+                          std::chrono::system_clock::now().time_since_epoch()).count();
+    states.store(slot->second, state);
+}
+
+/**
+ * @brief Authorization confirmed: subscribe to portfolio updates and keep the connection chatty.
+ */
+void SessionManager::onAuthorized(Session& session, const json* response) {
+    if (!response || !response->contains("result")) {
+        std::cerr << fmt::format(ERROR_COLOR, "WebSocket authorization failed for account {}\n", session.config.accountId);
+        return;
+    }
+
+    json channels = json::array();
+    for (const auto& entry : session.slots) {
+        channels.push_back("user.portfolio." + toLower(entry.first));
+    }
+    for (std::string request : {session.requests.request(RpcMethod::PrivateSubscribe, {{"channels", channels}}),
+                                session.requests.request(RpcMethod::PublicSetHeartbeat, {{"interval", HEARTBEAT_INTERVAL}})}) {
+        if (!request.empty()) {
+            session.outbox.push_back(std::move(request));
+        }
+    }
+}
+
+Session* SessionManager::session(const std::string& accountId) {
+    auto it = byAccount.find(accountId);
+    return it == byAccount.end() ? nullptr : it->second;
+}
+
+Session* SessionManager::primarySession(const std::string& accountId) {
+    Session* found = session(accountId);
+    return found && !found->config.redundantOf.empty() ? session(found->config.redundantOf) : found;
+}
+
+Session* SessionManager::fastestSession(const std::string& accountId) {
+    Session* owner = primarySession(accountId);
+    if (!owner) {
+        return nullptr;
+    }
+
+    Session* fastest = owner;
+    int64_t best = owner->receiving ? owner->rttMicros.load(std::memory_order_relaxed) : -1;
+    for (const auto& candidate : sessions) {
+        if (candidate->config.redundantOf != owner->config.accountId || !candidate->receiving) {
+            continue;
+        }
+        if (!fastest->receiving) {
+            fastest = candidate.get(); // A live backup beats a primary whose connection is gone
+        }
+        const int64_t rtt = candidate->rttMicros.load(std::memory_order_relaxed);
+        if (rtt >= 0 && (best < 0 || rtt < best)) {
+            fastest = candidate.get();
+            best = rtt;
+        }
+    }
+    return fastest;
+}
+
+int64_t SessionManager::rttMicros(const std::string& accountId) const {
+    auto it = byAccount.find(accountId);
+    return it == byAccount.end() ? -1 : it->second->rttMicros.load(std::memory_order_relaxed);
+}
+
+/**
+ * @brief Charges the account's rate limit, then hands the order to the receive thread of the
+ *        account's fastest connection and waits for its completion.
+ */
+std::string SessionManager::placeOrder(const std::string& accountId, const std::string& instrument,
+                                       const std::string& side, double quantity, double price) {
+    Session* owner = primarySession(accountId);
+    if (!owner) {
+        return R"({"error": "Unknown account: )" + accountId + R"("})";
+    }
+    if (!owner->limiter->tryAcquire()) {
+        return R"({"error": "Rate limit exceeded for account: )" + accountId + R"("})";
+    }
+    Session* target = fastestSession(accountId);
+    if (!running || !target->receiving) {
+        return R"({"error": "No live connection for account: )" + accountId + R"("})";
+    }
+
+    // The completion outlives this call if the wait below gives up, so the promise is shared
+    auto reply = std::make_shared<std::promise<std::string>>();
+    std::future<std::string> answer = reply->get_future();
+    const RpcMethod method = side == "sell" ? RpcMethod::Sell : RpcMethod::Buy;
+    const json params = {{"instrument_name", instrument}, {"amount", quantity}, {"type", "limit"}, {"price", price}};
+    std::string request = target->requests.request(method, params, [reply](const json* response) {
+        reply->set_value(response ? response->dump() : R"({"error": "Order request timed out"})");
+    });
+    if (request.empty()) {
+        return R"({"error": "Too many requests in flight on the connection"})";
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(target->sendMutex);
+        target->sendQueue.push_back(std::move(request));
+    }
+    wake(*target);
+
+    if (answer.wait_for(ORDER_REPLY_TIMEOUT) != std::future_status::ready) {
+        return R"({"error": "No answer from the connection of account: )" + accountId + R"("})";
+    }
+    return answer.get();
+}
+
+bool SessionManager::accountState(const std::string& accountId, const std::string& currency, AccountState& out) const {
+    auto it = byAccount.find(accountId);
+    if (it == byAccount.end()) {
+        return false;
+    }
+    auto slot = it->second->slots.find(toUpper(currency));
+    return slot != it->second->slots.end() && states.load(slot->second, out);
+}
+
+std::vector<std::string> SessionManager::accountIds() const {
+    std::vector<std::string> ids;
+    for (const auto& session : sessions) {
+        ids.push_back(session->config.accountId);
+    }
+    return ids;
+}
+
+std::size_t SessionManager::size() const {
+    return sessions.size();
+}
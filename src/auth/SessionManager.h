@@ -0,0 +1,225 @@
+#ifndef SESSION_MANAGER_H
+#define SESSION_MANAGER_H
+
+#include <string>
+#include <vector>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <atomic>
+#include <chrono>
+#include <unordered_map>
+#include <nlohmann/json_fwd.hpp>
+#include "AuthManager.h"
+#include "RateLimiter.h"
+#include "../InflightRequests.h"
+#include "AccountStateCache.h"
+#include "../order_management/OrderManager.h"
+#include "../account_management/AccountManager.h"
+#include "../WebSocketClient.h"
+
+/**
+ * @file SessionManager.h
+ *
+ * @brief Defines the `SessionManager` class, which runs several authenticated accounts (main
+ *        account and subaccounts) in one process.
+ *
+ * Every account gets its own `Session`: its own credentials and token, its own WebSocket
+ * connection for private notifications, its own order and account managers, and its own rate-limit
+ * bucket, since Deribit accounts each have a separate credit pool. Orders are routed to the session
+ * that owns the account ID. Portfolio state of all accounts is published into one shared
+ * `AccountStateCache`, which any thread reads without locks.
+ *
+ * Every session continuously probes its connection with `public/test`. An account can open redundant
+ * connections (`"connections": N` in the accounts file): each is a session of its own, named
+ * `{account_id}#2` ... `{account_id}#N`, that backs up the primary session. Orders for the account
+ * are sent as JSON-RPC requests over whichever of its connections has the lowest measured round
+ * trip, so the round trip that picks the connection is the one the order travels.
+ *
+ * ### Key Responsibilities:
+ * - Authenticate and connect N accounts.
+ * - Route requests by account ID and account for each account's rate limit.
+ * - Measure each connection's round trip and route orders over the fastest connection of an account.
+ * - Keep the portfolio state of every account current from `user.portfolio` notifications.
+ */
+
+/**
+ * @struct SessionConfig
+ *
+ * @brief Credentials and settings of one account.
+ */
+struct SessionConfig {
+    std::string accountId;                        /**< Name used to route requests (e.g., "main", "mm-btc"). */
+    std::string clientId;                         /**< API key client ID of this account. */
+    std::string clientSecret;                     /**< API key client secret of this account. */
+    std::vector<std::string> currencies{"BTC", "ETH"}; /**< Currencies whose portfolio is tracked. */
+    RateLimiter::Config limits;                   /**< Rate limit of this account. */
+    std::string redundantOf;                      /**< Primary account ID this connection backs up; empty for a primary. */
+};
+
+/**
+ * @struct Session
+ *
+ * @brief One authenticated account with its own connection and rate-limit accounting.
+ */
+struct Session {
+    ~Session();
+
+    SessionConfig config;                         /**< Account settings. */
+    std::unique_ptr<AuthManager> auth;            /**< Credentials and WebSocket auth requests. */
+    std::string token;                            /**< Access token from REST authentication. */
+    std::unique_ptr<OrderManager> orders;         /**< Order requests made with this account's token. */
+    std::unique_ptr<AccountManager> account;      /**< Account requests made with this account's token. */
+    std::unique_ptr<WebSocketClient> ws;          /**< Private notification stream. */
+    InflightRequests requests;                    /**< IDs, replies and timeouts of every request sent on `ws`. */
+    std::vector<std::string> outbox;              /**< Requests queued by completions, sent after `receive` returns (receive thread only). */
+    std::mutex sendMutex;                         /**< Guards `sendQueue`. */
+    std::vector<std::string> sendQueue;           /**< Requests queued by other threads (orders), sent by the receive thread. */
+    int wakeFd{-1};                               /**< eventfd that wakes the receive thread for `sendQueue` or `stop`. */
+    std::atomic<bool> receiving{false};           /**< The receive thread is running on a live connection. */
+    std::unique_ptr<RateLimiter> limiter;         /**< Token bucket of this account. */
+    std::unordered_map<std::string, std::size_t> slots; /**< Currency -> slot in the shared cache. */
+    std::thread receiver;                         /**< Reads `ws` and publishes into the cache. */
+    std::atomic<int64_t> rttMicros{-1};           /**< Smoothed `public/test` round trip (µs); -1 until measured. */
+    std::chrono::steady_clock::time_point probeSentAt{}; /**< Send time of the last probe (receive thread only). */
+    bool probePending{false};                     /**< A probe awaits its response (receive thread only). */
+};
+
+/**
+ * @class SessionManager
+ *
+ * @brief Owns N sessions and routes requests to them by account ID.
+ *
+ * ### Workflow:
+ * 1. `addSession` for every account (authenticates over REST, connects the WebSocket).
+ * 2. `start` launches one receive thread per session.
+ * 3. `placeOrder` (or `session(...)`) routes requests; `accountState` reads cached portfolios.
+ * 4. `stop` joins the receive threads and disconnects.
+ *
+ * ### Example:
+ * ```
+ * SessionManager sessions(WebSocketClient::Config{"test.deribit.com", "443", "/ws/api/v2"});
+ * sessions.addSession(SessionConfig{"main", "id1", "secret1"});
+ * sessions.addSession(SessionConfig{"hedge", "id2", "secret2"});
+ * sessions.start();
+ * sessions.placeOrder("hedge", "BTC-PERPETUAL", "sell", 10, 31000);
+ * AccountState state;
+ * sessions.accountState("main", "BTC", state);
+ * ```
+ */
+class SessionManager {
+public:
+    /**
+     * @brief Constructs an empty manager.
+     *
+     * @param wsConfig Connection parameters used for every session's WebSocket.
+     */
+    explicit SessionManager(WebSocketClient::Config wsConfig);
+
+    /** @brief Stops all sessions. */
+    ~SessionManager();
+
+    /**
+     * @brief Loads session configurations from a JSON array.
+     *
+     * @param accounts Objects with `account_id`, `client_id`, `client_secret` and optionally
+     *                 `currencies`, `rate_per_second`, `burst` and `connections`.
+     * @return The parsed configurations (invalid entries are skipped).
+     *
+     * An entry with `"connections": N` (N > 1) yields its primary configuration followed by N - 1
+     * redundant ones, `{account_id}#2` ... `{account_id}#N`, with the same credentials, no tracked
+     * currencies (the portfolio is followed once) and `redundantOf` set to the primary account ID:
+     * ```
+     * [{"account_id": "main", "client_id": "...", "client_secret": "...", "connections": 3}]
+     * ```
+     */
+    static std::vector<SessionConfig> parseConfigs(const nlohmann::json& accounts);
+
+    /**
+     * @brief Authenticates an account and opens its WebSocket.
+     *
+     * @param config The account settings.
+     * @return False if the account ID is a duplicate, the primary of a redundant connection has not
+     *         been added, authentication fails, the connection fails, or the shared cache is full.
+     *         Must be called before `start`.
+     */
+    bool addSession(const SessionConfig& config);
+
+    /** @brief Launches one receive thread per session. */
+    void start();
+
+    /**
+     * @brief Stops the receive threads and closes the connections.
+     *
+     * The receive threads are woken up and exit, unless one is in the middle of reading a frame.
+     */
+    void stop();
+
+    /** @brief Returns the session of an account, or nullptr if it is unknown. */
+    Session* session(const std::string& accountId);
+
+    /**
+     * @brief Returns the fastest live connection of an account.
+     *
+     * @param accountId A primary account ID or one of its redundant connections (`main#2`).
+     * @return The receiving session with the lowest measured round trip among the primary and its
+     *         redundant connections (the primary until one has been measured), or nullptr if the
+     *         account is unknown.
+     */
+    Session* fastestSession(const std::string& accountId);
+
+    /** @brief Returns the smoothed round trip of an account's connection in microseconds, or -1. */
+    int64_t rttMicros(const std::string& accountId) const;
+
+    /**
+     * @brief Places a limit order on behalf of an account and waits for the exchange's answer.
+     *
+     * The primary account's rate limit is charged, and the order is sent as a `private/buy` or
+     * `private/sell` JSON-RPC request over `fastestSession(accountId)`: its ID comes from that
+     * connection's `InflightRequests`, and the connection's receive thread writes it and
+     * completes it with the response. Must be called after `start`, from any thread but a
+     * session's receive thread.
+     *
+     * @return The JSON-RPC response, or an error JSON if the account is unknown, its rate limit
+     *         would be exceeded, no connection is live, or no answer came within the request timeout.
+     */
+    std::string placeOrder(const std::string& accountId, const std::string& instrument,
+                           const std::string& side, double quantity, double price);
+
+    /**
+     * @brief Reads the cached portfolio state of an account without locking.
+     *
+     * @return False if the account or currency is unknown or no update has been received yet.
+     */
+    bool accountState(const std::string& accountId, const std::string& currency, AccountState& out) const;
+
+    /** @brief Returns the account IDs in the order they were added. */
+    std::vector<std::string> accountIds() const;
+
+    /** @brief Returns the number of sessions. */
+    std::size_t size() const;
+
+private:
+    /** @brief Receive loop of one session. */
+    void receiveLoop(Session& session);
+
+    /** @brief Handles one message of a session; requests to send go to its `outbox`. */
+    void handleMessage(Session& session, const std::string& message);
+
+    /** @brief Returns the primary session of an account or of one of its redundant connections. */
+    Session* primarySession(const std::string& accountId);
+
+    /** @brief Wakes a session's receive thread up (queued requests or `stop`). */
+    static void wake(Session& session);
+
+    /** @brief Completion of `public/auth`: queues the private subscription and the heartbeat. */
+    void onAuthorized(Session& session, const nlohmann::json* response);
+
+    WebSocketClient::Config wsConfig;                        /**< Shared connection parameters. */
+    std::vector<std::unique_ptr<Session>> sessions;          /**< Sessions in insertion order. */
+    std::unordered_map<std::string, Session*> byAccount;     /**< Account ID -> session. */
+    AccountStateCache states;                                /**< Portfolio state of all accounts. */
+    std::atomic<bool> running;                               /**< Receive loop flag. */
+};
+
+#endif // SESSION_MANAGER_H
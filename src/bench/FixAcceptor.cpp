@@ -0,0 +1,413 @@
+#include "FixAcceptor.h"
+#include <arpa/inet.h>
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <ctime>
+#include <stdexcept>
+#include <vector>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <fmt/format.h>
+
+/**
+ * @file FixAcceptor.cpp
+ *
+ * @brief Implements the `FixAcceptor` class: accept loop, session handling and the in-memory book.
+ */
+
+namespace {
+
+/** @brief Formats the current UTC time as YYYYMMDD-HH:MM:SS.sss. */
+std::string sendingTimeNow() {
+    const auto now = std::chrono::system_clock::now();
+    const auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(now.time_since_epoch()).count();
+    const std::time_t seconds = static_cast<std::time_t>(ms / 1000);
+    std::tm utc{};
+    gmtime_r(&seconds, &utc);
+    return fmt::format("{:04}{:02}{:02}-{:02}:{:02}:{:02}.{:03}", utc.tm_year + 1900, utc.tm_mon + 1, utc.tm_mday, utc.tm_hour,
+                       utc.tm_min, utc.tm_sec, ms % 1000);
+}
+
+/** @brief Appends one `tag=value<SOH>` field to a pre-formatted body. */
+template <typename Value>
+void field(std::string& body, int tag, const Value& value) {
+    fmt::format_to(std::back_inserter(body), "{}={}\x01", tag, value);
+}
+
+} // namespace
+
+FixAcceptor::FixAcceptor() {
+    listener = ::socket(AF_INET, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    sockaddr_in address{};
+    address.sin_family = AF_INET;
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    socklen_t length = sizeof(address);
+    if (listener < 0 || ::bind(listener, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0 ||
+        ::listen(listener, 1) != 0 ||
+        ::getsockname(listener, reinterpret_cast<sockaddr*>(&address), &length) != 0) {
+        if (listener >= 0) {
+            ::close(listener);
+        }
+        throw std::runtime_error("Failed to open the FIX acceptor socket");
+    }
+    listenPort = ntohs(address.sin_port);
+}
+
+FixAcceptor::~FixAcceptor() {
+    stop();
+    ::close(listener);
+}
+
+uint16_t FixAcceptor::port() const {
+    return listenPort;
+}
+
+void FixAcceptor::start() {
+    if (running.exchange(true)) {
+        return;
+    }
+    acceptorThread = std::thread([this]() { run(); });
+}
+
+void FixAcceptor::stop() {
+    running = false;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (connection >= 0) {
+            ::shutdown(connection, SHUT_RDWR);
+        }
+    }
+    if (acceptorThread.joinable()) {
+        acceptorThread.join();
+    }
+}
+
+void FixAcceptor::dropNextReply() {
+    std::lock_guard<std::mutex> lock(mutex);
+    dropNext = true;
+}
+
+void FixAcceptor::duplicateLastReply() {
+    std::lock_guard<std::mutex> lock(mutex);
+    auto it = sent.find(lastApplicationSeq);
+    if (it != sent.end()) {
+        write(it->second.msgType, it->first, true, it->second.body, it->second.sendingTime);
+    }
+}
+
+void FixAcceptor::requestResend(uint64_t begin, uint64_t end) {
+    std::lock_guard<std::mutex> lock(mutex);
+    std::string body;
+    field(body, FixTag::BeginSeqNo, begin);
+    field(body, FixTag::EndSeqNo, end);
+    reply("2", body, false);
+}
+
+uint64_t FixAcceptor::nextClientSeq() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return nextInSeq;
+}
+
+FixAcceptor::Stats FixAcceptor::stats() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return counters;
+}
+
+void FixAcceptor::run() {
+    while (running) {
+        pollfd descriptor{listener, POLLIN, 0};
+        if (::poll(&descriptor, 1, 100) <= 0) {
+            continue;
+        }
+        const int fd = ::accept4(listener, nullptr, nullptr, SOCK_CLOEXEC);
+        if (fd < 0) {
+            continue;
+        }
+        const int enable = 1;
+        setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &enable, sizeof(enable));
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            connection = fd;
+        }
+        serve(fd);
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            connection = -1;
+        }
+        ::close(fd);
+    }
+}
+
+void FixAcceptor::serve(int fd) {
+    std::vector<char> buffer(64 * 1024);
+    std::size_t used = 0;
+    while (running) {
+        pollfd descriptor{fd, POLLIN, 0};
+        const int ready = ::poll(&descriptor, 1, 100);
+        if (ready < 0 && errno != EINTR) {
+            return;
+        }
+        if (ready <= 0) {
+            continue;
+        }
+        if (used == buffer.size()) {
+            buffer.resize(buffer.size() * 2);
+        }
+        const ssize_t received = ::recv(fd, buffer.data() + used, buffer.size() - used, 0);
+        if (received <= 0) {
+            return;
+        }
+        used += static_cast<std::size_t>(received);
+
+        std::size_t consumed = 0;
+        FixMessage message;
+        bool loggedOut = false;
+        while (consumed < used) {
+            const std::string_view pending(buffer.data() + consumed, used - consumed);
+            const std::size_t length = FixMessage::frameLength(pending);
+            if (length == 0) {
+                break;
+            }
+            if (length == FixMessage::INVALID || !message.parse(pending.substr(0, length))) {
+                return;
+            }
+            std::lock_guard<std::mutex> lock(mutex);
+            handle(message);
+            loggedOut = loggedOut || message.msgType() == "5";
+            consumed += length;
+        }
+        std::memmove(buffer.data(), buffer.data() + consumed, used - consumed);
+        used -= consumed;
+        if (loggedOut) {
+            return;
+        }
+    }
+}
+
+/**
+ * @brief Client messages below the expected number are duplicates: PossDups are counted and
+ *        ignored, so a resent order is never executed twice. Messages above it are accepted (the
+ *        stand-in never asks the client to fill its own gaps unless told to).
+ */
+void FixAcceptor::handle(const FixMessage& message) {
+    const std::string_view type = message.msgType();
+    const uint64_t seq = message.seqNum();
+    const bool possDup = message.get(FixTag::PossDupFlag) == "Y";
+
+    if (type == "A") {
+        clientCompId = std::string(message.get(FixTag::SenderCompID));
+        ++counters.logons;
+        counters.lastLogonSeq = seq;
+        counters.expectedAtLastLogon = nextInSeq;
+        std::string body;
+        field(body, FixTag::EncryptMethod, 0);
+        field(body, FixTag::HeartBtInt, message.getInt(FixTag::HeartBtInt, 30));
+        if (message.get(FixTag::ResetSeqNumFlag) == "Y") {
+            nextOutSeq = 1;
+            sent.clear();
+            field(body, FixTag::ResetSeqNumFlag, 'Y');
+        }
+        nextInSeq = seq + 1;
+        reply("A", body, false);
+        return;
+    }
+
+    if (type == "4" && message.get(FixTag::GapFillFlag) == "Y") {
+        ++counters.gapFills;
+        const uint64_t newSeq = static_cast<uint64_t>(message.getInt(FixTag::NewSeqNo, 0));
+        if (newSeq > nextInSeq) {
+            nextInSeq = newSeq;
+        }
+        return;
+    }
+
+    if (possDup) {
+        ++counters.possDups;
+    }
+    if (seq < nextInSeq) {
+        return;
+    }
+    if (seq > nextInSeq) {
+        ++counters.inboundGaps;
+    }
+    nextInSeq = seq + 1;
+
+    if (type == "1") {
+        std::string body;
+        field(body, FixTag::TestReqID, message.get(FixTag::TestReqID));
+        reply("0", body, false);
+    } else if (type == "2") {
+        ++counters.resendRequests;
+        resend(static_cast<uint64_t>(message.getInt(FixTag::BeginSeqNo, 1)), static_cast<uint64_t>(message.getInt(FixTag::EndSeqNo, 0)));
+    } else if (type == "5") {
+        reply("5", {}, false);
+    } else if (type == "D" || type == "G" || type == "F" || type == "q" || type == "H") {
+        ++counters.orders;
+        execute(message);
+    }
+}
+
+/**
+ * @brief Every order rests until it is cancelled; nothing trades.
+ */
+void FixAcceptor::execute(const FixMessage& message) {
+    const std::string_view type = message.msgType();
+    const std::string clOrdId(message.get(FixTag::ClOrdID));
+    std::string body;
+
+    auto executionReport = [&body, &clOrdId](const std::string& orderId, const Order& order, char ordStatus) {
+        field(body, FixTag::OrderID, orderId);
+        field(body, FixTag::ClOrdID, clOrdId);
+        field(body, FixTag::OrdStatus, ordStatus);
+        field(body, FixTag::Symbol, order.symbol);
+        field(body, FixTag::Side, order.side);
+        field(body, FixTag::OrderQty, order.quantity);
+        field(body, FixTag::Price, order.price);
+        field(body, FixTag::CumQty, 0);
+    };
+    auto cancelReject = [&body, &clOrdId](std::string_view orderId) {
+        field(body, FixTag::ClOrdID, clOrdId);
+        field(body, FixTag::OrigClOrdID, orderId);
+        field(body, FixTag::Text, "Unknown order");
+    };
+
+    if (type == "D") {
+        const std::string orderId = fmt::format("FIX-{}", ++orderCounter);
+        const std::string_view side = message.get(FixTag::Side);
+        Order& order = book[orderId];
+        order = Order{std::string(message.get(FixTag::Symbol)), side.empty() ? '1' : side[0],
+                      message.getDouble(FixTag::OrderQty), message.getDouble(FixTag::Price)};
+        executionReport(orderId, order, '0');
+        reply("8", body, true);
+    } else if (type == "G" || type == "F") {
+        const std::string orderId(message.get(FixTag::OrigClOrdID));
+        auto it = book.find(orderId);
+        if (it == book.end()) {
+            cancelReject(orderId);
+            reply("9", body, true);
+            return;
+        }
+        if (type == "G") {
+            it->second.quantity = message.getDouble(FixTag::OrderQty);
+            it->second.price = message.getDouble(FixTag::Price);
+            executionReport(orderId, it->second, '0');
+        } else {
+            executionReport(orderId, it->second, '4');
+            book.erase(it);
+        }
+        reply("8", body, true);
+    } else if (type == "q") {
+        const bool all = message.get(FixTag::MassCancelRequestType) == "7";
+        const std::string_view symbol = message.get(FixTag::Symbol);
+        std::size_t cancelled = 0;
+        for (auto it = book.begin(); it != book.end();) {
+            if (all || it->second.symbol == symbol) {
+                it = book.erase(it);
+                ++cancelled;
+            } else {
+                ++it;
+            }
+        }
+        field(body, FixTag::ClOrdID, clOrdId);
+        field(body, FixTag::MassCancelRequestType, all ? '7' : '1');
+        field(body, FixTag::MassCancelResponse, all ? '7' : '1');
+        field(body, FixTag::TotalAffectedOrders, cancelled);
+        reply("r", body, true);
+    } else { // H
+        const std::string orderId(message.get(FixTag::OrderID));
+        field(body, FixTag::OrdStatusReqID, message.get(FixTag::OrdStatusReqID));
+        auto it = book.find(orderId);
+        if (it == book.end()) {
+            field(body, FixTag::OrderID, orderId);
+            field(body, FixTag::OrdStatus, '8');
+            field(body, FixTag::Text, "Unknown order");
+        } else {
+            executionReport(orderId, it->second, '0');
+        }
+        reply("8", body, true);
+    }
+}
+
+/**
+ * @brief A withheld message still consumes its number; the Heartbeat written in its place makes
+ *        the gap visible to the client at once.
+ */
+void FixAcceptor::reply(std::string_view msgType, const std::string& body, bool application) {
+    const uint64_t seq = nextOutSeq++;
+    const std::string now = sendingTimeNow();
+    if (application) {
+        sent[seq] = Sent{std::string(msgType), body, now};
+        lastApplicationSeq = seq;
+        if (dropNext) {
+            dropNext = false;
+            write("0", nextOutSeq++, false, {}, sendingTimeNow());
+            return;
+        }
+    }
+    write(msgType, seq, false, body, now);
+}
+
+void FixAcceptor::write(std::string_view msgType, uint64_t seq, bool possDup, std::string_view body, const std::string& sendingTime) {
+    if (connection < 0) {
+        return;
+    }
+    writer.begin(msgType);
+    writer.add(FixTag::SenderCompID, std::string_view(COMP_ID));
+    writer.add(FixTag::TargetCompID, clientCompId);
+    writer.add(FixTag::MsgSeqNum, static_cast<int64_t>(seq));
+    if (possDup) {
+        writer.add(FixTag::PossDupFlag, 'Y');
+        writer.add(FixTag::SendingTime, sendingTimeNow());
+        writer.add(FixTag::OrigSendingTime, sendingTime);
+    } else {
+        writer.add(FixTag::SendingTime, sendingTime);
+    }
+    writer.addRaw(body);
+    std::string_view wire = writer.finish();
+    while (!wire.empty()) {
+        const ssize_t written = ::send(connection, wire.data(), wire.size(), MSG_NOSIGNAL);
+        if (written < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return;
+        }
+        wire.remove_prefix(static_cast<std::size_t>(written));
+    }
+}
+
+/**
+ * @brief Stored application messages are resent as PossDups; every run of admin numbers collapses
+ *        into one SequenceReset-GapFill.
+ */
+void FixAcceptor::resend(uint64_t begin, uint64_t end) {
+    const uint64_t last = (end == 0 || end >= nextOutSeq) ? nextOutSeq - 1 : end;
+    uint64_t gapStart = 0;
+    auto flushGap = [this, &gapStart](uint64_t newSeq) {
+        if (gapStart == 0) {
+            return;
+        }
+        std::string body;
+        field(body, FixTag::GapFillFlag, 'Y');
+        field(body, FixTag::NewSeqNo, newSeq);
+        write("4", gapStart, true, body, sendingTimeNow());
+        gapStart = 0;
+    };
+
+    for (uint64_t seq = begin == 0 ? 1 : begin; seq <= last; ++seq) {
+        auto it = sent.find(seq);
+        if (it == sent.end()) {
+            if (gapStart == 0) {
+                gapStart = seq;
+            }
+            continue;
+        }
+        flushGap(seq);
+        write(it->second.msgType, seq, true, it->second.body, it->second.sendingTime);
+    }
+    flushGap(last + 1);
+}
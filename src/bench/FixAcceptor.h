@@ -0,0 +1,158 @@
+#ifndef FIX_ACCEPTOR_H
+#define FIX_ACCEPTOR_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include "../fix/FixCodec.h"
+
+/**
+ * @file FixAcceptor.h
+ *
+ * @brief Defines the `FixAcceptor` class, an in-process FIX 4.4 acceptor standing in for Deribit's
+ *        FIX gateway in `fix_bench`.
+ *
+ * The stand-in accepts plain TCP connections on a loopback port, one at a time, and implements just
+ * enough of both layers to drive `FixSession` and `FixOrderManager`: Logon, heartbeats and test
+ * requests, Logout, ResendRequest answered with PossDup resends and SequenceReset-GapFill, and the
+ * five order requests (D, G, F, q, H) against an in-memory order book. Its sequence numbers and
+ * orders survive a reconnect, as the exchange's do, so a restarted client can be checked to
+ * continue from its sequence file.
+ *
+ * Faults are injected on demand: `dropNextReply` withholds the next application message (the client
+ * sees an inbound gap), `duplicateLastReply` repeats one as a PossDup, and `requestResend` asks the
+ * client to resend its own messages.
+ */
+
+/**
+ * @class FixAcceptor
+ *
+ * @brief Loopback FIX acceptor with an in-memory order book and fault injection.
+ *
+ * ### Example:
+ * ```
+ * FixAcceptor acceptor;
+ * acceptor.start();
+ * FixSession session(FixSessionConfig{"127.0.0.1", std::to_string(acceptor.port()), "CLIENT", FixAcceptor::COMP_ID});
+ * session.logon();
+ * ```
+ */
+class FixAcceptor {
+public:
+    static constexpr const char* COMP_ID = "DERIBITSERVER";
+
+    /** @brief What the acceptor has seen; counters accumulate across connections. */
+    struct Stats {
+        std::size_t logons{0};
+        uint64_t lastLogonSeq{0};        /**< MsgSeqNum of the latest Logon. */
+        uint64_t expectedAtLastLogon{0}; /**< MsgSeqNum the acceptor expected for that Logon. */
+        std::size_t orders{0};           /**< Order requests executed (PossDup resends excluded). */
+        std::size_t resendRequests{0};   /**< ResendRequests received from the client. */
+        std::size_t possDups{0};         /**< PossDup messages received from the client. */
+        std::size_t gapFills{0};         /**< SequenceReset-GapFill received from the client. */
+        std::size_t inboundGaps{0};      /**< Client messages that arrived above the expected number. */
+    };
+
+    /** @brief Opens the listening socket; throws `std::runtime_error` on failure. */
+    FixAcceptor();
+
+    /** @brief Stops the acceptor. */
+    ~FixAcceptor();
+
+    FixAcceptor(const FixAcceptor&) = delete;
+    FixAcceptor& operator=(const FixAcceptor&) = delete;
+
+    /** @brief Returns the loopback port the acceptor listens on. */
+    uint16_t port() const;
+
+    /** @brief Starts the acceptor thread. */
+    void start();
+
+    /** @brief Closes the current connection and stops the acceptor thread. */
+    void stop();
+
+    /** @brief The next application message is assigned its number but not written; a Heartbeat follows it. */
+    void dropNextReply();
+
+    /** @brief Writes the last application message again as a PossDup. */
+    void duplicateLastReply();
+
+    /** @brief Sends a ResendRequest for the client's messages [begin, end] (end 0 = up to the latest). */
+    void requestResend(uint64_t begin, uint64_t end);
+
+    /** @brief Returns the next MsgSeqNum expected from the client. */
+    uint64_t nextClientSeq() const;
+
+    Stats stats() const;
+
+private:
+    /** @brief A resting order of the in-memory book. */
+    struct Order {
+        std::string symbol;
+        char side;
+        double quantity;
+        double price;
+    };
+
+    /** @brief A sent application message kept for resend. */
+    struct Sent {
+        std::string msgType;
+        std::string body;         /**< Body fields, pre-formatted. */
+        std::string sendingTime;  /**< Original SendingTime. */
+    };
+
+    /** @brief Accept loop: serves one connection at a time until `stop`. */
+    void run();
+
+    /** @brief Reads and handles messages until the connection ends. */
+    void serve(int fd);
+
+    /** @brief Handles one client message. Requires `mutex`. */
+    void handle(const FixMessage& message);
+
+    /** @brief Handles one order request. Requires `mutex`. */
+    void execute(const FixMessage& message);
+
+    /**
+     * @brief Writes a message with the next sequence number. Requires `mutex`.
+     *
+     * @param body The body fields, pre-formatted as `tag=value<SOH>...`.
+     * @param application Stored for resend; admin messages are gap-filled instead.
+     */
+    void reply(std::string_view msgType, const std::string& body, bool application);
+
+    /**
+     * @brief Writes one message with the standard header. Requires `mutex`.
+     *
+     * @param sendingTime The SendingTime, or for a PossDup the OrigSendingTime.
+     */
+    void write(std::string_view msgType, uint64_t seq, bool possDup, std::string_view body, const std::string& sendingTime);
+
+    /** @brief Answers a ResendRequest for [begin, end]. Requires `mutex`. */
+    void resend(uint64_t begin, uint64_t end);
+
+    int listener{-1};
+    uint16_t listenPort{0};
+    std::thread acceptorThread;
+    std::atomic<bool> running{false};
+
+    mutable std::mutex mutex;            /**< Guards everything below (the thread and fault injection). */
+    int connection{-1};
+    std::string clientCompId;
+    FixWriter writer;
+    uint64_t nextOutSeq{1};
+    uint64_t nextInSeq{1};
+    std::map<uint64_t, Sent> sent;       /**< Application messages by MsgSeqNum. */
+    uint64_t lastApplicationSeq{0};
+    bool dropNext{false};
+    std::map<std::string, Order> book;   /**< OrderID -> order. */
+    uint64_t orderCounter{0};
+    Stats counters;
+};
+
+#endif // FIX_ACCEPTOR_H
@@ -0,0 +1,293 @@
+#include "../InflightRequests.h"
+#include "../WebSocketClient.h"
+#include "../fix/FixOrderManager.h"
+#include "../fix/FixSession.h"
+#include "FixAcceptor.h"
+#include "MockWsServer.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+#include <nlohmann/json.hpp>
+#include <fmt/color.h>
+#include <fmt/format.h>
+
+// Define color constants for clarity
+const auto ERROR_COLOR = fmt::fg(fmt::color::red);
+const auto SUCCESS_COLOR = fmt::fg(fmt::color::cyan);
+const auto INFO_COLOR = fmt::fg(fmt::color::blue);
+const auto HIGHLIGHT_COLOR = fmt::fg(fmt::color::yellow);
+
+using json = nlohmann::json;
+
+/**
+ * @file FixBench.cpp
+ *
+ * @brief Standalone check of the FIX order path against an in-process acceptor stand-in
+ *        (`FixAcceptor`), and an order round-trip benchmark of FIX against WebSocket JSON-RPC.
+ *
+ * ### Scenarios (each prints PASS or FAIL; the exit code is 1 if any fails):
+ * 1. Logon.
+ * 2. The five `OrderEntry` calls: place, modify, order state, cancel (and a rejected cancel), cancel all.
+ * 3. Inbound gap: the acceptor withholds an execution report; the client sends a ResendRequest and
+ *    the report arrives as a PossDup resend, followed by a SequenceReset-GapFill.
+ * 4. A PossDup duplicate of an already processed message is ignored.
+ * 5. The acceptor asks the client to resend: stored orders come back as PossDups (not executed
+ *    again) and admin messages as GapFills.
+ * 6. Restart: a new `FixSession` on the same sequence file continues both sequences, so its
+ *    Logon needs no resend.
+ *
+ * ### Benchmark:
+ * `orders` sequential `placeOrder` round trips over FIX (plain TCP, as `FixSession` connects;
+ * Deribit's gateway is reached through a TLS tunnel) and `private/buy` round trips over a TLS
+ * WebSocket against `MockWsServer` (JSON-RPC correlated by `InflightRequests`, as `SessionManager`
+ * does). Both servers answer with a resting order.
+ *
+ * ### Usage:
+ * ```
+ * make fix_bench
+ * ./fix_bench [orders=5000]
+ * ```
+ */
+
+namespace {
+
+int failures = 0;
+
+void check(bool passed, const std::string& name, const std::string& detail = "") {
+    if (passed) {
+        std::cout << fmt::format(SUCCESS_COLOR, "PASS ") << name << "\n";
+    } else {
+        ++failures;
+        std::cout << fmt::format(ERROR_COLOR, "FAIL ") << name << (detail.empty() ? "" : ": " + detail) << "\n";
+    }
+}
+
+/** @brief Returns `result.order` of a `private/buy` style response, or null. */
+json orderOf(const std::string& response) {
+    const json parsed = json::parse(response, nullptr, false);
+    if (parsed.is_object() && parsed.contains("result") && parsed["result"].is_object() && parsed["result"].contains("order")) {
+        return parsed["result"]["order"];
+    }
+    return nullptr;
+}
+
+FixSessionConfig sessionConfig(uint16_t port, const std::string& sequenceFile) {
+    FixSessionConfig config;
+    config.host = "127.0.0.1";
+    config.port = std::to_string(port);
+    config.senderCompId = "GOQUANT-BENCH";
+    config.targetCompId = FixAcceptor::COMP_ID;
+    config.clientId = "bench";
+    config.clientSecret = "secret";
+    config.sequenceFile = sequenceFile;
+    return config;
+}
+
+/** @brief Prints the latency distribution of one set of round trips. */
+void report(const char* name, std::vector<double>& micros) {
+    if (micros.empty()) {
+        std::cout << fmt::format(ERROR_COLOR, "{}: no round trips\n", name);
+        return;
+    }
+    std::sort(micros.begin(), micros.end());
+    double total = 0;
+    for (double value : micros) {
+        total += value;
+    }
+    std::cout << fmt::format(HIGHLIGHT_COLOR, "{:<22}", name)
+              << fmt::format("{} orders: mean {:.1f} us, p50 {:.1f} us, p99 {:.1f} us, max {:.1f} us\n", micros.size(),
+                             total / static_cast<double>(micros.size()), micros[micros.size() / 2],
+                             micros[micros.size() * 99 / 100], micros.back());
+}
+
+double microsSince(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+}
+
+/** @brief Runs the scenarios, then the FIX round trips on the restarted session. */
+std::vector<double> runFix(std::size_t orders) {
+    const std::string sequenceFile = "fix_bench.seq";
+    std::remove(sequenceFile.c_str());
+    FixAcceptor acceptor;
+    acceptor.start();
+
+    auto session = std::make_unique<FixSession>(sessionConfig(acceptor.port(), sequenceFile));
+    auto fixOrders = std::make_unique<FixOrderManager>(*session, std::chrono::seconds(2));
+    session->setMessageHandler([&fixOrders](const FixMessage& message) { fixOrders->onMessage(message); });
+
+    // 1. Logon
+    check(session->logon(std::chrono::seconds(2)) && acceptor.stats().logons == 1, "logon");
+
+    // 2. The five order calls
+    json placed = orderOf(fixOrders->placeOrder("BTC-PERPETUAL", "buy", 10, 30000));
+    const std::string orderId = placed.is_object() ? placed.value("order_id", "") : "";
+    check(!orderId.empty() && placed.value("order_state", "") == "open", "placeOrder", placed.dump());
+    json modified = orderOf(fixOrders->modifyOrder(orderId, 20, 30500));
+    check(modified.is_object() && modified.value("price", 0.0) == 30500 && modified.value("amount", 0.0) == 20, "modifyOrder",
+          modified.dump());
+    json state = orderOf(fixOrders->getOrderState(orderId));
+    check(state.is_object() && state.value("order_state", "") == "open" && state.value("price", 0.0) == 30500, "getOrderState",
+          state.dump());
+    json cancelled = orderOf(fixOrders->cancelOrder(orderId));
+    check(cancelled.is_object() && cancelled.value("order_state", "") == "cancelled", "cancelOrder", cancelled.dump());
+    const json rejected = json::parse(fixOrders->cancelOrder(orderId), nullptr, false);
+    check(rejected.is_object() && rejected.contains("error"), "cancelOrder of a cancelled order is rejected", rejected.dump());
+    fixOrders->placeOrder("BTC-PERPETUAL", "buy", 10, 29000);
+    fixOrders->placeOrder("ETH-PERPETUAL", "sell", 5, 3100);
+    const json massCancel = json::parse(fixOrders->cancelAllOrders(), nullptr, false);
+    check(massCancel.is_object() && massCancel.value("result", -1) == 2, "cancelAllOrders", massCancel.dump());
+
+    // 3. Inbound gap: ResendRequest, PossDup resend and GapFill
+    const std::size_t resendsBefore = acceptor.stats().resendRequests;
+    acceptor.dropNextReply();
+    json recovered = orderOf(fixOrders->placeOrder("BTC-PERPETUAL", "sell", 10, 31000));
+    check(recovered.is_object() && acceptor.stats().resendRequests == resendsBefore + 1, "inbound gap recovered by ResendRequest",
+          recovered.dump());
+    json afterGap = orderOf(fixOrders->placeOrder("BTC-PERPETUAL", "sell", 10, 31500));
+    check(afterGap.is_object() && acceptor.stats().resendRequests == resendsBefore + 1, "sequence in step after the GapFill");
+
+    // 4. A PossDup duplicate is ignored
+    const uint64_t expectedIn = session->nextTargetSeq();
+    acceptor.duplicateLastReply();
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    check(session->isLoggedOn() && session->nextTargetSeq() == expectedIn, "PossDup duplicate ignored");
+
+    // 5. The client resends its own messages
+    const FixAcceptor::Stats beforeResend = acceptor.stats();
+    acceptor.requestResend(1, 0);
+    std::this_thread::sleep_for(std::chrono::milliseconds(200));
+    const FixAcceptor::Stats afterResend = acceptor.stats();
+    check(afterResend.possDups > beforeResend.possDups && afterResend.gapFills > beforeResend.gapFills &&
+              afterResend.orders == beforeResend.orders && acceptor.nextClientSeq() == session->nextSenderSeq() && session->isLoggedOn(),
+          "outbound resend as PossDup and GapFill",
+          fmt::format("possdups {} gapfills {} orders {} -> {}", afterResend.possDups - beforeResend.possDups,
+                      afterResend.gapFills - beforeResend.gapFills, beforeResend.orders, afterResend.orders));
+
+    // 6. Restart from the sequence file
+    session->logout();
+    const uint64_t nextOut = session->nextSenderSeq();
+    const uint64_t nextIn = session->nextTargetSeq();
+    fixOrders.reset();
+    session.reset();
+
+    session = std::make_unique<FixSession>(sessionConfig(acceptor.port(), sequenceFile));
+    fixOrders = std::make_unique<FixOrderManager>(*session, std::chrono::seconds(2));
+    session->setMessageHandler([&fixOrders](const FixMessage& message) { fixOrders->onMessage(message); });
+    const std::size_t resendsBeforeRestart = acceptor.stats().resendRequests;
+    const bool relogged = session->logon(std::chrono::seconds(2));
+    const FixAcceptor::Stats restarted = acceptor.stats();
+    check(relogged && restarted.lastLogonSeq == nextOut && restarted.expectedAtLastLogon == nextOut &&
+              session->nextTargetSeq() == nextIn + 1 && restarted.resendRequests == resendsBeforeRestart,
+          "sequence numbers reloaded across a restart",
+          fmt::format("logon seq {} expected {}, next in {} (was {})", restarted.lastLogonSeq, nextOut, session->nextTargetSeq(), nextIn));
+
+    // Benchmark on the restarted session
+    std::vector<double> micros;
+    micros.reserve(orders);
+    for (std::size_t i = 0; i < orders; ++i) {
+        const auto start = std::chrono::steady_clock::now();
+        const std::string response = fixOrders->placeOrder("BTC-PERPETUAL", "buy", 10, 30000);
+        micros.push_back(microsSince(start));
+        if (response.find("\"result\"") == std::string::npos) {
+            std::cerr << fmt::format(ERROR_COLOR, "FIX order {} failed: {}\n", i, response);
+            break;
+        }
+    }
+
+    session->logout();
+    acceptor.stop();
+    std::remove(sequenceFile.c_str());
+    return micros;
+}
+
+/** @brief `private/buy` round trips over a TLS WebSocket to the mock server. */
+std::vector<double> runWebSocket(std::size_t orders) {
+    MockWsServer mock;
+    uint64_t orderCounter = 0;
+    std::thread server([&mock, &orderCounter]() {
+        mock.answerRequests([&orderCounter](const std::string& request) {
+            const json parsed = json::parse(request, nullptr, false);
+            const json& params = parsed.is_object() && parsed.contains("params") ? parsed["params"] : json::object();
+            json order = {
+                {"order_id", fmt::format("ETH-{}", ++orderCounter)},
+                {"order_state", "open"},
+                {"instrument_name", params.value("instrument_name", "")},
+                {"direction", parsed.value("method", "") == "private/sell" ? "sell" : "buy"},
+                {"amount", params.value("amount", 0.0)},
+                {"filled_amount", 0.0},
+                {"price", params.value("price", 0.0)}
+            };
+            return json{{"jsonrpc", "2.0"}, {"id", parsed.value("id", 0)}, {"result", {{"order", order}, {"trades", json::array()}}}}.dump();
+        });
+    });
+
+    WebSocketClient::Config config;
+    config.host = "127.0.0.1";
+    config.port = std::to_string(mock.port());
+    config.path = "/ws";
+    config.verify_ssl = false;
+    WebSocketClient client(config);
+    InflightRequests requests;
+
+    std::vector<double> micros;
+    micros.reserve(orders);
+    try {
+        client.connect();
+        const json params = {{"instrument_name", "BTC-PERPETUAL"}, {"amount", 10}, {"price", 30000}, {"type", "limit"}};
+        for (std::size_t i = 0; i < orders; ++i) {
+            const auto start = std::chrono::steady_clock::now();
+            bool answered = false;
+            std::string response;
+            const std::string payload = requests.request(RpcMethod::Buy, params, [&answered, &response](const json* reply) {
+                answered = true;
+                response = reply ? reply->dump() : "";
+            });
+            client.send(payload);
+            while (!answered) {
+                client.receive([&requests](const std::string& message) { requests.complete(json::parse(message, nullptr, false)); });
+            }
+            micros.push_back(microsSince(start));
+            if (response.find("\"result\"") == std::string::npos) {
+                std::cerr << fmt::format(ERROR_COLOR, "WebSocket order {} failed: {}\n", i, response);
+                break;
+            }
+        }
+        client.disconnect();
+    } catch (const std::exception& e) {
+        std::cerr << fmt::format(ERROR_COLOR, "WebSocket run stopped early: {}\n", e.what());
+    }
+    server.join();
+    return micros;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    const std::size_t orders = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 5000;
+
+    try {
+        std::cout << fmt::format(INFO_COLOR, "FIX acceptor stand-in scenarios:\n");
+        std::vector<double> fix = runFix(orders);
+        std::vector<double> webSocket = runWebSocket(orders);
+
+        std::cout << fmt::format(INFO_COLOR, "Order round trips (one in flight at a time):\n");
+        report("FIX (TCP)", fix);
+        report("WS JSON-RPC (TLS)", webSocket);
+    } catch (const std::exception& e) {
+        std::cerr << fmt::format(ERROR_COLOR, "Benchmark failed: {}\n", e.what());
+        return 1;
+    }
+
+    if (failures > 0) {
+        std::cerr << fmt::format(ERROR_COLOR, "{} scenario(s) failed\n", failures);
+        return 1;
+    }
+    std::cout << fmt::format(SUCCESS_COLOR, "Benchmark finished\n");
+    return 0;
+}
@@ -0,0 +1,133 @@
+#include "../WebSocketClient.h"
+#include "MockWsServer.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <ctime>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+#include <fmt/color.h>
+
+// Define color constants for clarity
+const auto ERROR_COLOR = fmt::fg(fmt::color::red);
+const auto SUCCESS_COLOR = fmt::fg(fmt::color::cyan);
+const auto INFO_COLOR = fmt::fg(fmt::color::blue);
+const auto HIGHLIGHT_COLOR = fmt::fg(fmt::color::yellow);
+
+/**
+ * @file KtlsBench.cpp
+ *
+ * @brief Standalone benchmark comparing `WebSocketClient` receive throughput and CPU cost with
+ *        user-space TLS and with kernel TLS offload (`Config::enable_ktls`), and per-message
+ *        `receive` with `receive_batch` under bursty traffic.
+ *
+ * An in-process `MockWsServer` (self-signed certificate generated at startup) accepts one TLS
+ * WebSocket connection per run, streams `frames` text frames of `frame_bytes` bytes and closes.
+ * The first two runs stream continuously and drain with `receive_batch`, with and without kTLS.
+ * The last two send bursts of `burst` frames coalesced into one write, with a short pause between
+ * bursts (as market data arrives), and drain them with `receive` and with `receive_batch`. Wall
+ * time and the client thread's CPU time (`CLOCK_THREAD_CPUTIME_ID`) are reported for every run.
+ *
+ * ### Usage:
+ * ```
+ * make ktls_bench
+ * ./ktls_bench [frames=200000] [frame_bytes=1024] [burst=64]
+ * ```
+ *
+ * kTLS needs the `tls` kernel module (`modprobe tls`); without it the second run falls back to
+ * user-space TLS and reports `ktls_active=no`.
+ */
+
+namespace {
+
+double threadCpuSeconds() {
+    timespec ts{};
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+    return static_cast<double>(ts.tv_sec) + static_cast<double>(ts.tv_nsec) / 1e9;
+}
+
+/**
+ * @brief Runs one client against a fresh server connection and prints its results.
+ *
+ * @param batched Drain with `receive_batch` (one callback per read) instead of `receive` (one per message).
+ * @param burst Frames per server write, 0 for continuous streaming (see `MockWsServer::streamFrames`).
+ */
+void runOnce(MockWsServer& mock, bool enableKtls, bool batched, std::size_t frames, std::size_t frameBytes, std::size_t burst) {
+    std::thread server([&mock, frames, frameBytes, burst]() { mock.streamFrames(frames, frameBytes, burst); });
+
+    WebSocketClient::Config config;
+    config.host = "127.0.0.1";
+    config.port = std::to_string(mock.port());
+    config.path = "/ws";
+    config.verify_ssl = false;
+    config.enable_ktls = enableKtls;
+    WebSocketClient client(config);
+
+    std::size_t messages = 0;
+    std::size_t bytes = 0;
+    std::size_t calls = 0;
+    bool ktls = false;
+    const auto start = std::chrono::steady_clock::now();
+    const double cpuStart = threadCpuSeconds();
+    try {
+        client.connect();
+        ktls = client.ktls_active();
+        while (messages < frames) {
+            ++calls;
+            if (batched) {
+                client.receive_batch([&](const std::vector<std::string>& batch) {
+                    messages += batch.size();
+                    for (const auto& message : batch) {
+                        bytes += message.size();
+                    }
+                });
+            } else {
+                client.receive([&](const std::string& message) {
+                    ++messages;
+                    bytes += message.size();
+                });
+            }
+        }
+        client.disconnect();
+    } catch (const std::exception& e) {
+        std::cerr << fmt::format(ERROR_COLOR, "Run stopped early: {}\n", e.what());
+    }
+    const double cpu = threadCpuSeconds() - cpuStart;
+    const double wall = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    server.join();
+
+    const double megabytes = static_cast<double>(bytes) / (1024.0 * 1024.0);
+    const std::string label = fmt::format("{} {}", enableKtls ? "kTLS" : "user TLS", batched ? "receive_batch" : "receive");
+    std::cout << fmt::format(HIGHLIGHT_COLOR, "{:<24}", label)
+              << fmt::format("ktls_active={:<3} messages={} ({} calls) {:.1f} MB in {:.3f} s: {:.1f} MB/s, client CPU {:.3f} s "
+                             "({:.1f} ns/byte, {:.0f} ns/message)\n",
+                             ktls ? "yes" : "no", messages, calls, megabytes, wall, wall > 0 ? megabytes / wall : 0.0, cpu,
+                             bytes > 0 ? cpu * 1e9 / static_cast<double>(bytes) : 0.0,
+                             messages > 0 ? cpu * 1e9 / static_cast<double>(messages) : 0.0);
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    const std::size_t frames = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 200000;
+    const std::size_t frameBytes = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 1024;
+    const std::size_t burst = argc > 3 ? std::max<std::size_t>(1, std::strtoull(argv[3], nullptr, 10)) : 64;
+
+    try {
+        MockWsServer mock;
+        std::cout << fmt::format(INFO_COLOR, "Mock server on 127.0.0.1:{}, {} frames of {} bytes per run\n", mock.port(), frames, frameBytes);
+        runOnce(mock, false, true, frames, frameBytes, 0);
+        runOnce(mock, true, true, frames, frameBytes, 0);
+
+        std::cout << fmt::format(INFO_COLOR, "Bursts of {} coalesced frames:\n", burst);
+        runOnce(mock, false, false, frames, frameBytes, burst);
+        runOnce(mock, false, true, frames, frameBytes, burst);
+        std::cout << fmt::format(SUCCESS_COLOR, "Benchmark finished\n");
+    } catch (const std::exception& e) {
+        std::cerr << fmt::format(ERROR_COLOR, "Benchmark failed: {}\n", e.what());
+        return 1;
+    }
+    return 0;
+}
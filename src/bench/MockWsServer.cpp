@@ -0,0 +1,259 @@
+#include "MockWsServer.h"
+#include <arpa/inet.h>
+#include <chrono>
+#include <netinet/in.h>
+#include <stdexcept>
+#include <sys/socket.h>
+#include <thread>
+#include <unistd.h>
+#include <openssl/evp.h>
+#include <openssl/x509.h>
+
+/**
+ * @file MockWsServer.cpp
+ *
+ * @brief Implements the `MockWsServer` class: certificate, TLS accept, WebSocket upgrade and framing.
+ */
+
+namespace {
+
+/** @brief Builds a server context with a fresh P-256 key and self-signed certificate. */
+SSL_CTX* makeServerContext() {
+    std::unique_ptr<SSL_CTX, decltype(&SSL_CTX_free)> ctx(SSL_CTX_new(TLS_server_method()), &SSL_CTX_free);
+    std::unique_ptr<EVP_PKEY, decltype(&EVP_PKEY_free)> key(EVP_EC_gen("P-256"), &EVP_PKEY_free);
+    std::unique_ptr<X509, decltype(&X509_free)> cert(X509_new(), &X509_free);
+    if (!ctx || !key || !cert) {
+        throw std::runtime_error("Failed to allocate TLS server context");
+    }
+
+    X509_set_version(cert.get(), 2);
+    ASN1_INTEGER_set(X509_get_serialNumber(cert.get()), 1);
+    X509_gmtime_adj(X509_getm_notBefore(cert.get()), 0);
+    X509_gmtime_adj(X509_getm_notAfter(cert.get()), 24 * 3600);
+    X509_set_pubkey(cert.get(), key.get());
+    X509_NAME* name = X509_get_subject_name(cert.get());
+    X509_NAME_add_entry_by_txt(name, "CN", MBSTRING_ASC, reinterpret_cast<const unsigned char*>("localhost"), -1, -1, 0);
+    X509_set_issuer_name(cert.get(), name);
+    if (X509_sign(cert.get(), key.get(), EVP_sha256()) == 0 ||
+        SSL_CTX_use_certificate(ctx.get(), cert.get()) != 1 ||
+        SSL_CTX_use_PrivateKey(ctx.get(), key.get()) != 1) {
+        throw std::runtime_error("Failed to create self-signed certificate");
+    }
+    SSL_CTX_set_options(ctx.get(), SSL_OP_ENABLE_KTLS);
+    return ctx.release();
+}
+
+/** @brief Computes the `Sec-WebSocket-Accept` value for a client key (RFC 6455, section 4.2.2). */
+std::string acceptKey(const std::string& clientKey) {
+    const std::string input = clientKey + "258EAFA5-E914-47DA-95CA-C5AB0DC85B11";
+    unsigned char digest[20];
+    EVP_Digest(input.data(), input.size(), digest, nullptr, EVP_sha1(), nullptr);
+    unsigned char encoded[32];
+    const int length = EVP_EncodeBlock(encoded, digest, sizeof(digest));
+    return std::string(reinterpret_cast<const char*>(encoded), length);
+}
+
+/** @brief Appends one unmasked server frame. */
+void appendFrame(std::string& out, unsigned char opcode, const std::string& payload) {
+    out.push_back(static_cast<char>(0x80 | opcode));
+    if (payload.size() < 126) {
+        out.push_back(static_cast<char>(payload.size()));
+    } else if (payload.size() <= 0xFFFF) {
+        out.push_back(static_cast<char>(126));
+        out.push_back(static_cast<char>(payload.size() >> 8));
+        out.push_back(static_cast<char>(payload.size() & 0xFF));
+    } else {
+        out.push_back(static_cast<char>(127));
+        for (int shift = 56; shift >= 0; shift -= 8) {
+            out.push_back(static_cast<char>((static_cast<uint64_t>(payload.size()) >> shift) & 0xFF));
+        }
+    }
+    out += payload;
+}
+
+/**
+ * @brief Takes one complete masked client frame off the front of `buffer`.
+ *
+ * @return False if `buffer` does not hold a complete frame yet.
+ */
+bool takeClientFrame(std::string& buffer, unsigned char& opcode, std::string& payload) {
+    if (buffer.size() < 2) {
+        return false;
+    }
+    const auto* bytes = reinterpret_cast<const unsigned char*>(buffer.data());
+    std::size_t header = 2;
+    uint64_t length = bytes[1] & 0x7F;
+    if (length == 126) {
+        header = 4;
+        if (buffer.size() < header) {
+            return false;
+        }
+        length = (static_cast<uint64_t>(bytes[2]) << 8) | bytes[3];
+    } else if (length == 127) {
+        header = 10;
+        if (buffer.size() < header) {
+            return false;
+        }
+        length = 0;
+        for (int i = 2; i < 10; ++i) {
+            length = (length << 8) | bytes[i];
+        }
+    }
+    const bool masked = (bytes[1] & 0x80) != 0;
+    const std::size_t maskBytes = masked ? 4 : 0;
+    if (buffer.size() < header + maskBytes + length) {
+        return false;
+    }
+
+    opcode = bytes[0] & 0x0F;
+    payload.assign(buffer, header + maskBytes, length);
+    if (masked) {
+        for (std::size_t i = 0; i < payload.size(); ++i) {
+            payload[i] = static_cast<char>(payload[i] ^ bytes[header + (i & 3)]);
+        }
+    }
+    buffer.erase(0, header + maskBytes + length);
+    return true;
+}
+
+} // namespace
+
+MockWsServer::MockWsServer() : ctx(makeServerContext(), &SSL_CTX_free) {
+    listener = ::socket(AF_INET, SOCK_STREAM, 0);
+    sockaddr_in address{};
+    address.sin_family = AF_INET;
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    socklen_t length = sizeof(address);
+    if (listener < 0 || ::bind(listener, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0 ||
+        ::listen(listener, 1) != 0 ||
+        ::getsockname(listener, reinterpret_cast<sockaddr*>(&address), &length) != 0) {
+        if (listener >= 0) {
+            ::close(listener);
+        }
+        throw std::runtime_error("Failed to open the mock server socket");
+    }
+    listenPort = ntohs(address.sin_port);
+}
+
+MockWsServer::~MockWsServer() {
+    ::close(listener);
+}
+
+uint16_t MockWsServer::port() const {
+    return listenPort;
+}
+
+MockWsServer::SslPtr MockWsServer::acceptClient(int& fd) {
+    fd = ::accept(listener, nullptr, nullptr);
+    if (fd < 0) {
+        return SslPtr(nullptr, &SSL_free);
+    }
+    SslPtr ssl(SSL_new(ctx.get()), &SSL_free);
+    SSL_set_fd(ssl.get(), fd);
+    if (SSL_accept(ssl.get()) != 1) {
+        ::close(fd);
+        return SslPtr(nullptr, &SSL_free);
+    }
+
+    std::string request;
+    char chunk[4096];
+    while (request.find("\r\n\r\n") == std::string::npos) {
+        std::size_t received = 0;
+        if (SSL_read_ex(ssl.get(), chunk, sizeof(chunk), &received) != 1) {
+            ::close(fd);
+            return SslPtr(nullptr, &SSL_free);
+        }
+        request.append(chunk, received);
+    }
+
+    std::string key;
+    const auto keyPos = request.find("Sec-WebSocket-Key:");
+    if (keyPos != std::string::npos) {
+        const auto begin = request.find_first_not_of(' ', keyPos + 18);
+        key = request.substr(begin, request.find("\r\n", begin) - begin);
+    }
+    const std::string response =
+        "HTTP/1.1 101 Switching Protocols\r\nUpgrade: websocket\r\nConnection: Upgrade\r\n"
+        "Sec-WebSocket-Accept: " + acceptKey(key) + "\r\n\r\n";
+    std::size_t written = 0;
+    SSL_write_ex(ssl.get(), response.data(), response.size(), &written);
+    return ssl;
+}
+
+void MockWsServer::streamFrames(std::size_t frames, std::size_t frameBytes, std::size_t burst) {
+    int fd = -1;
+    SslPtr ssl = acceptClient(fd);
+    if (!ssl) {
+        return;
+    }
+
+    const std::string payload(frameBytes, 'x');
+    std::string batch;
+    std::size_t sent = 0;
+    std::size_t written = 0;
+    while (sent < frames) {
+        batch.clear();
+        for (std::size_t inBatch = 0; sent < frames && (burst > 0 ? inBatch < burst : batch.size() < 256 * 1024); ++sent, ++inBatch) {
+            appendFrame(batch, 0x1, payload);
+        }
+        if (SSL_write_ex(ssl.get(), batch.data(), batch.size(), &written) != 1) {
+            break;
+        }
+        if (burst > 0) {
+            std::this_thread::sleep_for(std::chrono::microseconds(50));
+        }
+    }
+
+    batch.clear();
+    appendFrame(batch, 0x8, std::string("\x03\xe8", 2));
+    SSL_write_ex(ssl.get(), batch.data(), batch.size(), &written);
+    // Wait for the client's close echo (or EOF) before tearing down
+    char chunk[4096];
+    std::size_t received = 0;
+    SSL_read_ex(ssl.get(), chunk, sizeof(chunk), &received);
+    SSL_shutdown(ssl.get());
+    ::close(fd);
+}
+
+/**
+ * @brief Pings are answered with pongs; a close frame is echoed and ends the connection.
+ */
+void MockWsServer::answerRequests(const Responder& respond) {
+    int fd = -1;
+    SslPtr ssl = acceptClient(fd);
+    if (!ssl) {
+        return;
+    }
+
+    std::string buffer;
+    std::string payload;
+    std::string out;
+    char chunk[16 * 1024];
+    bool open = true;
+    while (open) {
+        std::size_t received = 0;
+        if (SSL_read_ex(ssl.get(), chunk, sizeof(chunk), &received) != 1) {
+            break;
+        }
+        buffer.append(chunk, received);
+
+        out.clear();
+        unsigned char opcode = 0;
+        while (open && takeClientFrame(buffer, opcode, payload)) {
+            if (opcode == 0x1) {
+                appendFrame(out, 0x1, respond(payload));
+            } else if (opcode == 0x9) {
+                appendFrame(out, 0xA, payload);
+            } else if (opcode == 0x8) {
+                appendFrame(out, 0x8, payload);
+                open = false;
+            }
+        }
+        std::size_t written = 0;
+        if (!out.empty() && SSL_write_ex(ssl.get(), out.data(), out.size(), &written) != 1) {
+            break;
+        }
+    }
+    SSL_shutdown(ssl.get());
+    ::close(fd);
+}
@@ -0,0 +1,76 @@
+#ifndef MOCK_WS_SERVER_H
+#define MOCK_WS_SERVER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <openssl/ssl.h>
+
+/**
+ * @file MockWsServer.h
+ *
+ * @brief Defines the `MockWsServer` class, an in-process TLS WebSocket server for the benchmarks.
+ *
+ * The server listens on a loopback port with a self-signed certificate generated at startup, so
+ * `WebSocketClient` can be measured against it with `verify_ssl = false` and no network access.
+ */
+
+/**
+ * @class MockWsServer
+ *
+ * @brief Serves one WebSocket connection at a time, either streaming frames or answering requests.
+ *
+ * Every `serve...` call accepts one connection, performs the TLS handshake and the WebSocket
+ * upgrade, and returns once the connection is closed; run it on its own thread.
+ *
+ * ### Example:
+ * ```
+ * MockWsServer server;
+ * std::thread serving([&]() { server.streamFrames(100000, 1024, 0); });
+ * WebSocketClient client(WebSocketClient::Config{"127.0.0.1", std::to_string(server.port()), "/ws"});
+ * ```
+ */
+class MockWsServer {
+public:
+    /** @brief Returns the reply to one text frame from the client. */
+    using Responder = std::function<std::string(const std::string& request)>;
+
+    /** @brief Creates the certificate and the listening socket; throws `std::runtime_error` on failure. */
+    MockWsServer();
+
+    ~MockWsServer();
+
+    MockWsServer(const MockWsServer&) = delete;
+    MockWsServer& operator=(const MockWsServer&) = delete;
+
+    /** @brief Returns the loopback port the server listens on. */
+    uint16_t port() const;
+
+    /**
+     * @brief Serves one connection: `frames` text frames of `frameBytes` bytes, then a close.
+     *
+     * @param burst Frames per write with a short pause after each write, or 0 to write ~256KB
+     *              batches back to back (so the server is not the bottleneck).
+     */
+    void streamFrames(std::size_t frames, std::size_t frameBytes, std::size_t burst);
+
+    /**
+     * @brief Serves one connection: every text frame from the client is answered with the
+     *        responder's reply until the client closes the connection.
+     */
+    void answerRequests(const Responder& respond);
+
+private:
+    using SslPtr = std::unique_ptr<SSL, decltype(&SSL_free)>;
+
+    /** @brief Accepts a connection, handshakes TLS and upgrades it; returns null on failure. */
+    SslPtr acceptClient(int& fd);
+
+    std::unique_ptr<SSL_CTX, decltype(&SSL_CTX_free)> ctx;
+    int listener{-1};
+    uint16_t listenPort{0};
+};
+
+#endif // MOCK_WS_SERVER_H
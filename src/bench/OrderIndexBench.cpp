@@ -0,0 +1,203 @@
+#include "../order_management/OrderIndex.h"
+#include "../order_management/OrderStore.h"
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include <nlohmann/json.hpp>
+#include <fmt/color.h>
+#include <fmt/format.h>
+
+// Define color constants for clarity
+const auto ERROR_COLOR = fmt::fg(fmt::color::red);
+const auto SUCCESS_COLOR = fmt::fg(fmt::color::cyan);
+const auto INFO_COLOR = fmt::fg(fmt::color::blue);
+const auto HIGHLIGHT_COLOR = fmt::fg(fmt::color::yellow);
+
+using json = nlohmann::json;
+
+/**
+ * @file OrderIndexBench.cpp
+ *
+ * @brief Standalone benchmark of the order ID lookup behind every `user.orders` execution report.
+ *
+ * Three runs over `live_orders` open orders:
+ * 1. Lookup of random live order IDs: `OrderIndex::find` against `std::unordered_map<std::string, uint32_t>`.
+ * 2. Churn (one order finishes, a new one arrives): `erase` + `intern` against the map's `erase` + `emplace`.
+ * 3. `OrderStore::onUserOrders` over a recorded mix of reports (partial fills of live orders, and
+ *    for one order in five a final fill followed by a new order), then `openOrders`; finished
+ *    orders leave the store, so its size stays at the live count.
+ *
+ * ### Usage:
+ * ```
+ * make order_index_bench
+ * ./order_index_bench [live_orders=50000] [reports=1000000]
+ * ```
+ */
+
+namespace {
+
+std::string orderIdOf(uint64_t number) {
+    return fmt::format("ETH-{}", 10000000 + number);
+}
+
+/** @brief Prints one result line; `sink` keeps the measured work from being optimized away. */
+void report(const char* name, std::size_t operations, std::chrono::steady_clock::duration elapsed, uint64_t sink) {
+    const double nanos = static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count());
+    std::cout << fmt::format(HIGHLIGHT_COLOR, "{:<28}", name)
+              << fmt::format("{} ops, {:.1f} ns/op (check {})\n", operations, operations > 0 ? nanos / static_cast<double>(operations) : 0.0,
+                             sink);
+}
+
+void benchLookups(const std::vector<std::string>& ids, std::size_t lookups, std::mt19937_64& random) {
+    OrderIndex index(ids.size());
+    std::unordered_map<std::string, uint32_t> map;
+    map.reserve(ids.size());
+    for (const auto& id : ids) {
+        map.emplace(id, index.intern(id));
+    }
+
+    std::vector<uint32_t> sequence(lookups);
+    std::uniform_int_distribution<uint32_t> pick(0, static_cast<uint32_t>(ids.size() - 1));
+    for (auto& position : sequence) {
+        position = pick(random);
+    }
+
+    uint64_t sink = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (uint32_t position : sequence) {
+        sink += index.find(ids[position]);
+    }
+    report("OrderIndex::find", lookups, std::chrono::steady_clock::now() - start, sink);
+
+    sink = 0;
+    start = std::chrono::steady_clock::now();
+    for (uint32_t position : sequence) {
+        sink += map.find(ids[position])->second;
+    }
+    report("unordered_map::find", lookups, std::chrono::steady_clock::now() - start, sink);
+}
+
+void benchChurn(std::size_t liveOrders, std::size_t steps, std::mt19937_64& random) {
+    // live[k] is the k-th live slot; each step replaces a random slot with a fresh order ID
+    std::vector<std::string> live;
+    for (std::size_t i = 0; i < liveOrders; ++i) {
+        live.push_back(orderIdOf(i));
+    }
+    std::vector<std::string> arrivals;
+    std::vector<uint32_t> slots;
+    std::uniform_int_distribution<uint32_t> pick(0, static_cast<uint32_t>(liveOrders - 1));
+    for (std::size_t i = 0; i < steps; ++i) {
+        arrivals.push_back(orderIdOf(liveOrders + i));
+        slots.push_back(pick(random));
+    }
+
+    OrderIndex index(liveOrders);
+    for (const auto& id : live) {
+        index.intern(id);
+    }
+    std::vector<std::string> current = live;
+    uint64_t sink = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (std::size_t i = 0; i < steps; ++i) {
+        index.erase(current[slots[i]]);
+        sink += index.intern(arrivals[i]);
+        current[slots[i]] = arrivals[i];
+    }
+    report("OrderIndex erase+intern", steps, std::chrono::steady_clock::now() - start, sink);
+    std::cout << fmt::format(INFO_COLOR, "  live keys {}, handle limit {}\n", index.size(), index.handleLimit());
+
+    std::unordered_map<std::string, uint32_t> map;
+    map.reserve(liveOrders);
+    for (std::size_t i = 0; i < liveOrders; ++i) {
+        map.emplace(live[i], static_cast<uint32_t>(i));
+    }
+    current = live;
+    sink = 0;
+    start = std::chrono::steady_clock::now();
+    for (std::size_t i = 0; i < steps; ++i) {
+        map.erase(current[slots[i]]);
+        sink += map.emplace(arrivals[i], slots[i]).first->second;
+        current[slots[i]] = arrivals[i];
+    }
+    report("unordered_map erase+emplace", steps, std::chrono::steady_clock::now() - start, sink);
+}
+
+json orderReport(const std::string& orderId, const char* state, double filled, int64_t timestamp) {
+    return {{"order_id", orderId},
+            {"instrument_name", "ETH-PERPETUAL"},
+            {"direction", "buy"},
+            {"order_state", state},
+            {"price", 3000.0},
+            {"amount", 100.0},
+            {"filled_amount", filled},
+            {"last_update_timestamp", timestamp}};
+}
+
+void benchStore(std::size_t liveOrders, std::size_t reports, std::mt19937_64& random) {
+    OrderStore store;
+    std::vector<std::string> live;
+    int64_t timestamp = 1;
+    for (std::size_t i = 0; i < liveOrders; ++i) {
+        live.push_back(orderIdOf(i));
+        store.upsert(orderReport(live.back(), "open", 0.0, timestamp++));
+    }
+
+    // Reports are parsed up front, as the receive loop hands `params.data` over already parsed
+    std::vector<json> recorded;
+    recorded.reserve(reports);
+    std::uniform_int_distribution<uint32_t> pick(0, static_cast<uint32_t>(liveOrders - 1));
+    std::uniform_int_distribution<int> kind(0, 9);
+    uint64_t nextOrder = liveOrders;
+    while (recorded.size() < reports) {
+        const uint32_t slot = pick(random);
+        if (kind(random) < 2) {
+            // The order fills completely and a new order takes its place
+            recorded.push_back(orderReport(live[slot], "filled", 100.0, timestamp++));
+            live[slot] = orderIdOf(nextOrder++);
+            recorded.push_back(orderReport(live[slot], "open", 0.0, timestamp++));
+        } else {
+            recorded.push_back(orderReport(live[slot], "open", 10.0, timestamp++));
+        }
+    }
+
+    std::size_t applied = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (const auto& data : recorded) {
+        applied += store.onUserOrders(data);
+    }
+    report("OrderStore::onUserOrders", recorded.size(), std::chrono::steady_clock::now() - start, applied);
+
+    start = std::chrono::steady_clock::now();
+    const std::size_t open = store.openOrders().size();
+    report("OrderStore::openOrders", 1, std::chrono::steady_clock::now() - start, open);
+    std::cout << fmt::format(INFO_COLOR, "  live orders {} (of {} ever seen)\n", store.size(), nextOrder);
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    const std::size_t liveOrders = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 50000;
+    const std::size_t reports = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 1000000;
+    if (liveOrders == 0) {
+        std::cerr << fmt::format(ERROR_COLOR, "live_orders must be positive\n");
+        return 1;
+    }
+
+    std::mt19937_64 random(42);
+    std::vector<std::string> ids;
+    for (std::size_t i = 0; i < liveOrders; ++i) {
+        ids.push_back(orderIdOf(i));
+    }
+
+    std::cout << fmt::format(INFO_COLOR, "{} live orders, {} operations per run\n", liveOrders, reports);
+    benchLookups(ids, reports, random);
+    benchChurn(liveOrders, reports, random);
+    benchStore(liveOrders, reports, random);
+    std::cout << fmt::format(SUCCESS_COLOR, "Benchmark finished\n");
+    return 0;
+}
@@ -0,0 +1,235 @@
+#include "../FrameRouter.h"
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include <nlohmann/json.hpp>
+#include <fmt/color.h>
+#include <fmt/format.h>
+
+// Define color constants for clarity
+const auto ERROR_COLOR = fmt::fg(fmt::color::red);
+const auto SUCCESS_COLOR = fmt::fg(fmt::color::cyan);
+const auto INFO_COLOR = fmt::fg(fmt::color::blue);
+const auto HIGHLIGHT_COLOR = fmt::fg(fmt::color::yellow);
+
+using json = nlohmann::json;
+
+/**
+ * @file RouterBench.cpp
+ *
+ * @brief Standalone benchmark of frame routing: `FrameRouter` (compile-time perfect hash tables,
+ *        handlers in arrays) against the same routing done with `std::unordered_map<std::string, ...>`.
+ *
+ * A recorded mix of frames (mostly book and ticker notifications, then trades, `user.*` channels,
+ * the price index, heartbeats and request replies) is parsed up front and routed `rounds` times
+ * by each router. A second run resolves just the names (method, then channel family) so the
+ * lookup cost is visible without the JSON traversal around it.
+ *
+ * ### Usage:
+ * ```
+ * make router_bench
+ * ./router_bench [frames=100000] [rounds=20]
+ * ```
+ */
+
+namespace {
+
+/** @brief One entry of the recorded mix: a frame and how often it occurs (out of 100). */
+struct MixEntry {
+    int weight;
+    const char* frame;
+};
+
+const std::vector<MixEntry> MIX = {
+    {35, R"({"jsonrpc":"2.0","method":"subscription","params":{"channel":"book.BTC-PERPETUAL.100ms","data":{"change_id":1}}})"},
+    {20, R"({"jsonrpc":"2.0","method":"subscription","params":{"channel":"ticker.ETH-PERPETUAL.raw","data":{"mark_price":3000}}})"},
+    {10, R"({"jsonrpc":"2.0","method":"subscription","params":{"channel":"trades.BTC-PERPETUAL.raw","data":[]}})"},
+    {8, R"({"jsonrpc":"2.0","method":"subscription","params":{"channel":"user.orders.any.any.raw","data":{"order_id":"ETH-1"}}})"},
+    {5, R"({"jsonrpc":"2.0","method":"subscription","params":{"channel":"user.trades.any.any.raw","data":[]}})"},
+    {5, R"({"jsonrpc":"2.0","method":"subscription","params":{"channel":"user.portfolio.btc","data":{}}})"},
+    {5, R"({"jsonrpc":"2.0","method":"subscription","params":{"channel":"deribit_price_index.btc_usd","data":{"price":60000}}})"},
+    {2, R"({"jsonrpc":"2.0","method":"subscription","params":{"channel":"markprice.options.btc_usd","data":[]}})"},
+    {5, R"({"jsonrpc":"2.0","method":"heartbeat","params":{"type":"test_request"}})"},
+    {5, R"({"jsonrpc":"2.0","id":42,"result":{"order":{"order_id":"ETH-2"}}})"}
+};
+
+/**
+ * @brief The same routing as `FrameRouter`, keyed by `std::string` in hash maps: the method name
+ *        and channel prefixes are copied into strings and hashed on every frame.
+ */
+class MapRouter {
+public:
+    void onChannel(const std::string& prefix, FrameRouter::ChannelHandler handler) {
+        channelHandlers[prefix] = std::move(handler);
+    }
+
+    void onMethod(const std::string& method, FrameRouter::MethodHandler handler) {
+        methodHandlers[method] = std::move(handler);
+    }
+
+    void onResponse(FrameRouter::ResponseHandler handler) {
+        responseHandler = std::move(handler);
+    }
+
+    /** @brief Same lookup order as `FrameRouter::channelKindOf`: first segment, then first two. */
+    const FrameRouter::ChannelHandler* channelHandler(const std::string& channel) const {
+        const std::size_t first = channel.find('.');
+        if (first == std::string::npos) {
+            return nullptr;
+        }
+        auto it = channelHandlers.find(channel.substr(0, first));
+        if (it == channelHandlers.end()) {
+            it = channelHandlers.find(channel.substr(0, channel.find('.', first + 1)));
+        }
+        return it == channelHandlers.end() ? nullptr : &it->second;
+    }
+
+    bool route(const json& frame) const {
+        if (!frame.is_object()) {
+            return false;
+        }
+        const auto method = frame.find("method");
+        if (method == frame.end() || !method->is_string()) {
+            if (responseHandler && frame.contains("id")) {
+                responseHandler(frame);
+                return true;
+            }
+            return false;
+        }
+
+        const std::string& name = method->get_ref<const std::string&>();
+        if (name != "subscription") {
+            auto handler = methodHandlers.find(name);
+            if (handler == methodHandlers.end()) {
+                return false;
+            }
+            handler->second(frame);
+            return true;
+        }
+
+        const auto params = frame.find("params");
+        if (params == frame.end() || !params->is_object()) {
+            return false;
+        }
+        const auto channel = params->find("channel");
+        if (channel == params->end() || !channel->is_string()) {
+            return false;
+        }
+        const std::string& channelName = channel->get_ref<const std::string&>();
+        const FrameRouter::ChannelHandler* handler = channelHandler(channelName);
+        if (!handler) {
+            return false;
+        }
+        (*handler)(channelName, *params);
+        return true;
+    }
+
+    std::unordered_map<std::string, FrameRouter::MethodHandler> methodHandlers;
+    std::unordered_map<std::string, FrameRouter::ChannelHandler> channelHandlers;
+    FrameRouter::ResponseHandler responseHandler;
+};
+
+/** @brief Prints one result line; `handled` keeps the measured work from being optimized away. */
+void report(const char* name, std::size_t operations, std::chrono::steady_clock::duration elapsed, uint64_t handled) {
+    const double nanos = static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count());
+    std::cout << fmt::format(HIGHLIGHT_COLOR, "{:<30}", name)
+              << fmt::format("{} ops, {:.1f} ns/op (handled {})\n", operations,
+                             operations > 0 ? nanos / static_cast<double>(operations) : 0.0, handled);
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    const std::size_t frameCount = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 100000;
+    const std::size_t rounds = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 20;
+
+    // Record the mix: frames drawn by weight, parsed once
+    std::vector<int> weights;
+    for (const auto& entry : MIX) {
+        weights.push_back(entry.weight);
+    }
+    std::discrete_distribution<std::size_t> pick(weights.begin(), weights.end());
+    std::mt19937_64 random(7);
+    std::vector<json> frames;
+    std::vector<std::string> methods;
+    std::vector<std::string> channels;
+    frames.reserve(frameCount);
+    for (std::size_t i = 0; i < frameCount; ++i) {
+        frames.push_back(json::parse(MIX[pick(random)].frame));
+        const json& frame = frames.back();
+        methods.push_back(frame.value("method", ""));
+        channels.push_back(frame.contains("params") ? frame["params"].value("channel", "") : "");
+    }
+
+    uint64_t handled = 0;
+    FrameRouter router;
+    for (std::size_t kind = 0; kind < static_cast<std::size_t>(ChannelKind::Count); ++kind) {
+        router.onChannel(static_cast<ChannelKind>(kind), [&handled](const std::string&, const json&) { ++handled; });
+    }
+    router.onMethod(RpcMethod::Heartbeat, [&handled](const json&) { ++handled; });
+    router.onResponse([&handled](const json&) { ++handled; });
+
+    MapRouter mapRouter;
+    for (const char* prefix : {"book", "ticker", "trades", "quote", "incremental_ticker", "perpetual", "deribit_price_index",
+                               "instrument.state", "markprice.options", "user.orders", "user.trades", "user.changes", "user.portfolio"}) {
+        mapRouter.onChannel(prefix, [&handled](const std::string&, const json&) { ++handled; });
+    }
+    mapRouter.onMethod("heartbeat", [&handled](const json&) { ++handled; });
+    mapRouter.onResponse([&handled](const json&) { ++handled; });
+
+    std::cout << fmt::format(INFO_COLOR, "{} recorded frames, {} rounds\n", frameCount, rounds);
+
+    auto start = std::chrono::steady_clock::now();
+    for (std::size_t round = 0; round < rounds; ++round) {
+        for (const auto& frame : frames) {
+            router.route(frame);
+        }
+    }
+    report("FrameRouter::route", frameCount * rounds, std::chrono::steady_clock::now() - start, handled);
+
+    handled = 0;
+    start = std::chrono::steady_clock::now();
+    for (std::size_t round = 0; round < rounds; ++round) {
+        for (const auto& frame : frames) {
+            mapRouter.route(frame);
+        }
+    }
+    report("unordered_map route", frameCount * rounds, std::chrono::steady_clock::now() - start, handled);
+
+    // Name resolution alone: the method, then the channel family of subscriptions
+    uint64_t resolved = 0;
+    start = std::chrono::steady_clock::now();
+    for (std::size_t round = 0; round < rounds; ++round) {
+        for (std::size_t i = 0; i < frameCount; ++i) {
+            resolved += static_cast<uint64_t>(FrameRouter::methodOf(methods[i]));
+            if (!channels[i].empty()) {
+                resolved += static_cast<uint64_t>(FrameRouter::channelKindOf(channels[i]));
+            }
+        }
+    }
+    report("PerfectHash resolve", frameCount * rounds, std::chrono::steady_clock::now() - start, resolved);
+
+    resolved = 0;
+    start = std::chrono::steady_clock::now();
+    for (std::size_t round = 0; round < rounds; ++round) {
+        for (std::size_t i = 0; i < frameCount; ++i) {
+            resolved += mapRouter.methodHandlers.count(methods[i]);
+            if (!channels[i].empty()) {
+                resolved += mapRouter.channelHandler(channels[i]) != nullptr;
+            }
+        }
+    }
+    report("unordered_map resolve", frameCount * rounds, std::chrono::steady_clock::now() - start, resolved);
+
+    if (frames.empty()) {
+        std::cerr << fmt::format(ERROR_COLOR, "No frames recorded\n");
+        return 1;
+    }
+    std::cout << fmt::format(SUCCESS_COLOR, "Benchmark finished\n");
+    return 0;
+}
@@ -0,0 +1,232 @@
+#include "FixCodec.h"
+#include <charconv>
+#include <cstring>
+
+/**
+ * @file FixCodec.cpp
+ *
+ * @brief Implements the allocation-free FIX 4.4 encoder and decoder.
+ */
+
+namespace {
+
+constexpr char SOH = '\x01';
+constexpr std::string_view BEGIN_STRING = "8=FIX.4.4\x01";
+
+/** @brief Parses a non-negative decimal integer; false on any other character. */
+bool parseUnsigned(std::string_view text, uint64_t& out) {
+    if (text.empty()) {
+        return false;
+    }
+    auto result = std::from_chars(text.data(), text.data() + text.size(), out);
+    return result.ec == std::errc() && result.ptr == text.data() + text.size();
+}
+
+unsigned checksumOf(const char* data, std::size_t length) {
+    unsigned sum = 0;
+    for (std::size_t i = 0; i < length; ++i) {
+        sum += static_cast<unsigned char>(data[i]);
+    }
+    return sum % 256;
+}
+
+} // namespace
+
+void FixWriter::begin(std::string_view msgType) {
+    start = HEADER_RESERVE;
+    end = HEADER_RESERVE;
+    overflow = false;
+    add(FixTag::MsgType, msgType);
+}
+
+void FixWriter::append(std::string_view text) {
+    if (overflow || end + text.size() > CAPACITY - 7) { // Keep room for "10=NNN|"
+        overflow = true;
+        return;
+    }
+    std::memcpy(buffer.data() + end, text.data(), text.size());
+    end += text.size();
+}
+
+void FixWriter::appendTag(int tag) {
+    char digits[16];
+    auto result = std::to_chars(digits, digits + sizeof(digits) - 1, tag);
+    *result.ptr++ = '=';
+    append(std::string_view(digits, static_cast<std::size_t>(result.ptr - digits)));
+}
+
+void FixWriter::add(int tag, std::string_view value) {
+    appendTag(tag);
+    append(value);
+    append(std::string_view(&SOH, 1));
+}
+
+void FixWriter::add(int tag, int64_t value) {
+    char digits[24];
+    auto result = std::to_chars(digits, digits + sizeof(digits), value);
+    add(tag, std::string_view(digits, static_cast<std::size_t>(result.ptr - digits)));
+}
+
+void FixWriter::add(int tag, double value) {
+    // Shortest representation that round-trips, never in exponent form
+    char digits[64];
+    auto result = std::to_chars(digits, digits + sizeof(digits), value, std::chars_format::fixed);
+    if (result.ec != std::errc()) {
+        overflow = true;
+        return;
+    }
+    add(tag, std::string_view(digits, static_cast<std::size_t>(result.ptr - digits)));
+}
+
+void FixWriter::add(int tag, char value) {
+    add(tag, std::string_view(&value, 1));
+}
+
+void FixWriter::addRaw(std::string_view fields) {
+    append(fields);
+}
+
+std::size_t FixWriter::mark() const {
+    return end;
+}
+
+std::string_view FixWriter::since(std::size_t mark) const {
+    return std::string_view(buffer.data() + mark, end - mark);
+}
+
+/**
+ * @brief The body was written after `HEADER_RESERVE` bytes, so the header is formatted right in
+ *        front of it and no byte of the body moves.
+ */
+std::string_view FixWriter::finish() {
+    if (overflow) {
+        return {};
+    }
+
+    char header[HEADER_RESERVE];
+    std::memcpy(header, BEGIN_STRING.data(), BEGIN_STRING.size());
+    std::size_t headerLength = BEGIN_STRING.size();
+    header[headerLength++] = '9';
+    header[headerLength++] = '=';
+    auto result = std::to_chars(header + headerLength, header + sizeof(header) - 1, end - HEADER_RESERVE);
+    headerLength = static_cast<std::size_t>(result.ptr - header);
+    header[headerLength++] = SOH;
+
+    start = HEADER_RESERVE - headerLength;
+    std::memcpy(buffer.data() + start, header, headerLength);
+
+    const unsigned checksum = checksumOf(buffer.data() + start, end - start);
+    char* trailer = buffer.data() + end;
+    trailer[0] = '1';
+    trailer[1] = '0';
+    trailer[2] = '=';
+    trailer[3] = static_cast<char>('0' + checksum / 100);
+    trailer[4] = static_cast<char>('0' + checksum / 10 % 10);
+    trailer[5] = static_cast<char>('0' + checksum % 10);
+    trailer[6] = SOH;
+    return std::string_view(buffer.data() + start, end + 7 - start);
+}
+
+bool FixWriter::overflowed() const {
+    return overflow;
+}
+
+/**
+ * @brief A message is "8=...|9=<n>|" followed by n body bytes and the 7-byte "10=NNN|" trailer.
+ */
+std::size_t FixMessage::frameLength(std::string_view data) {
+    if (data.size() < 2) {
+        return 0;
+    }
+    if (data[0] != '8' || data[1] != '=') {
+        return INVALID;
+    }
+
+    const std::size_t lengthTag = data.find("\x01" "9=");
+    if (lengthTag == std::string_view::npos) {
+        return data.size() > 32 ? INVALID : 0;
+    }
+    const std::size_t valueStart = lengthTag + 3;
+    const std::size_t valueEnd = data.find(SOH, valueStart);
+    if (valueEnd == std::string_view::npos) {
+        return data.size() - valueStart > 8 ? INVALID : 0;
+    }
+
+    uint64_t bodyLength = 0;
+    if (!parseUnsigned(data.substr(valueStart, valueEnd - valueStart), bodyLength)) {
+        return INVALID;
+    }
+    const std::size_t total = valueEnd + 1 + static_cast<std::size_t>(bodyLength) + 7;
+    return data.size() >= total ? total : 0;
+}
+
+bool FixMessage::parse(std::string_view data) {
+    count = 0;
+    if (data.size() < 7 || data.compare(data.size() - 7, 3, "10=") != 0 || data.back() != SOH) {
+        return false;
+    }
+
+    uint64_t expected = 0;
+    if (!parseUnsigned(data.substr(data.size() - 4, 3), expected) ||
+        checksumOf(data.data(), data.size() - 7) != expected) {
+        return false;
+    }
+
+    std::size_t position = 0;
+    while (position < data.size()) {
+        const std::size_t equals = data.find('=', position);
+        const std::size_t delimiter = data.find(SOH, position);
+        if (equals == std::string_view::npos || delimiter == std::string_view::npos || equals > delimiter) {
+            return false;
+        }
+
+        uint64_t tag = 0;
+        if (!parseUnsigned(data.substr(position, equals - position), tag) || count == MAX_FIELDS) {
+            return false;
+        }
+        fields[count++] = Field{static_cast<int>(tag), data.substr(equals + 1, delimiter - equals - 1)};
+        position = delimiter + 1;
+    }
+    return count >= 3 && fields[0].tag == FixTag::BeginString && fields[1].tag == FixTag::BodyLength &&
+           fields[2].tag == FixTag::MsgType;
+}
+
+std::string_view FixMessage::get(int tag) const {
+    for (std::size_t i = 0; i < count; ++i) {
+        if (fields[i].tag == tag) {
+            return fields[i].value;
+        }
+    }
+    return {};
+}
+
+bool FixMessage::has(int tag) const {
+    for (std::size_t i = 0; i < count; ++i) {
+        if (fields[i].tag == tag) {
+            return true;
+        }
+    }
+    return false;
+}
+
+int64_t FixMessage::getInt(int tag, int64_t fallback) const {
+    const std::string_view value = get(tag);
+    int64_t parsed = 0;
+    auto result = std::from_chars(value.data(), value.data() + value.size(), parsed);
+    return !value.empty() && result.ec == std::errc() ? parsed : fallback;
+}
+
+double FixMessage::getDouble(int tag, double fallback) const {
+    const std::string_view value = get(tag);
+    double parsed = 0.0;
+    auto result = std::from_chars(value.data(), value.data() + value.size(), parsed);
+    return !value.empty() && result.ec == std::errc() ? parsed : fallback;
+}
+
+std::string_view FixMessage::msgType() const {
+    return count >= 3 ? fields[2].value : std::string_view();
+}
+
+uint64_t FixMessage::seqNum() const {
+    return static_cast<uint64_t>(getInt(FixTag::MsgSeqNum, 0));
+}
@@ -0,0 +1,175 @@
+#ifndef FIX_CODEC_H
+#define FIX_CODEC_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+/**
+ * @file FixCodec.h
+ *
+ * @brief Defines the FIX 4.4 tag=value encoder (`FixWriter`) and decoder (`FixMessage`).
+ *
+ * Neither class allocates: the writer formats into a fixed buffer it owns, and the decoder
+ * records `(tag, value)` views into the caller's receive buffer in a fixed-size field array.
+ * BodyLength (9) and CheckSum (10) are computed and verified here, so the session layer only deals
+ * with header and application fields.
+ */
+
+/**
+ * @struct FixTag
+ *
+ * @brief Tag numbers used by the FIX session and order entry.
+ */
+struct FixTag {
+    static constexpr int BeginSeqNo = 7;
+    static constexpr int BeginString = 8;
+    static constexpr int BodyLength = 9;
+    static constexpr int CheckSum = 10;
+    static constexpr int ClOrdID = 11;
+    static constexpr int CumQty = 14;
+    static constexpr int EndSeqNo = 16;
+    static constexpr int MsgSeqNum = 34;
+    static constexpr int MsgType = 35;
+    static constexpr int NewSeqNo = 36;
+    static constexpr int OrderID = 37;
+    static constexpr int OrderQty = 38;
+    static constexpr int OrdStatus = 39;
+    static constexpr int OrdType = 40;
+    static constexpr int OrigClOrdID = 41;
+    static constexpr int PossDupFlag = 43;
+    static constexpr int Price = 44;
+    static constexpr int RefSeqNum = 45;
+    static constexpr int SenderCompID = 49;
+    static constexpr int SendingTime = 52;
+    static constexpr int Side = 54;
+    static constexpr int Symbol = 55;
+    static constexpr int TargetCompID = 56;
+    static constexpr int Text = 58;
+    static constexpr int RawDataLength = 95;
+    static constexpr int RawData = 96;
+    static constexpr int EncryptMethod = 98;
+    static constexpr int HeartBtInt = 108;
+    static constexpr int TestReqID = 112;
+    static constexpr int OrigSendingTime = 122;
+    static constexpr int GapFillFlag = 123;
+    static constexpr int ResetSeqNumFlag = 141;
+    static constexpr int MassCancelRequestType = 530;
+    static constexpr int MassCancelResponse = 531;
+    static constexpr int TotalAffectedOrders = 533;
+    static constexpr int Username = 553;
+    static constexpr int Password = 554;
+    static constexpr int OrdStatusReqID = 790;
+    static constexpr int CancelOnDisconnect = 9001; /**< Deribit extension on Logon. */
+};
+
+/**
+ * @class FixWriter
+ *
+ * @brief Formats one FIX message into an internal fixed buffer.
+ *
+ * ### Example:
+ * ```
+ * FixWriter writer;
+ * writer.begin("D");
+ * writer.add(FixTag::ClOrdID, "order-1");
+ * writer.add(FixTag::Price, 30000.5);
+ * std::string_view wire = writer.finish(); // 8=FIX.4.4|9=..|35=D|11=order-1|44=30000.5|10=..|
+ * ```
+ */
+class FixWriter {
+public:
+    static constexpr std::size_t CAPACITY = 4096;
+
+    /** @brief Starts a new message with its MsgType (35). */
+    void begin(std::string_view msgType);
+
+    void add(int tag, std::string_view value);
+    void add(int tag, int64_t value);
+    void add(int tag, double value);
+    void add(int tag, char value);
+
+    /** @brief Appends pre-formatted `tag=value<SOH>` fields (used when resending stored messages). */
+    void addRaw(std::string_view fields);
+
+    /** @brief Returns the current end of the body, to be passed to `since`. */
+    std::size_t mark() const;
+
+    /** @brief Returns the fields written after a `mark`. */
+    std::string_view since(std::size_t mark) const;
+
+    /**
+     * @brief Prepends BeginString and BodyLength, appends CheckSum and returns the wire message.
+     *
+     * @return The complete message, or an empty view if the buffer overflowed.
+     */
+    std::string_view finish();
+
+    /** @brief Returns true if a field did not fit; the message is then discarded by `finish`. */
+    bool overflowed() const;
+
+private:
+    static constexpr std::size_t HEADER_RESERVE = 32; /**< Room for "8=FIX.4.4|9=NNNN|". */
+
+    void append(std::string_view text);
+    void appendTag(int tag);
+
+    std::array<char, CAPACITY> buffer{};
+    std::size_t start{HEADER_RESERVE}; /**< First byte of the finished message. */
+    std::size_t end{HEADER_RESERVE};   /**< One past the last byte written. */
+    bool overflow{false};
+};
+
+/**
+ * @class FixMessage
+ *
+ * @brief A decoded FIX message whose field values view the receive buffer.
+ *
+ * The viewed buffer must stay unchanged while the message is in use.
+ */
+class FixMessage {
+public:
+    static constexpr std::size_t MAX_FIELDS = 256;
+
+    /**
+     * @brief Returns the length of the first complete message in a buffer.
+     *
+     * @return The length, 0 if more data is needed, or `INVALID` if the buffer does not start
+     *         with a FIX header.
+     */
+    static std::size_t frameLength(std::string_view data);
+
+    static constexpr std::size_t INVALID = static_cast<std::size_t>(-1);
+
+    /**
+     * @brief Decodes one complete message (as delimited by `frameLength`).
+     *
+     * @return False if the message is malformed, has too many fields or a wrong checksum.
+     */
+    bool parse(std::string_view data);
+
+    /** @brief Returns the value of the first occurrence of a tag, or an empty view. */
+    std::string_view get(int tag) const;
+
+    bool has(int tag) const;
+    int64_t getInt(int tag, int64_t fallback = 0) const;
+    double getDouble(int tag, double fallback = 0.0) const;
+
+    /** @brief Returns MsgType (35). */
+    std::string_view msgType() const;
+
+    /** @brief Returns MsgSeqNum (34). */
+    uint64_t seqNum() const;
+
+private:
+    struct Field {
+        int tag;
+        std::string_view value;
+    };
+
+    std::array<Field, MAX_FIELDS> fields{};
+    std::size_t count{0};
+};
+
+#endif // FIX_CODEC_H
@@ -0,0 +1,218 @@
+#include "FixOrderManager.h"
+#include "FixSession.h"
+#include <nlohmann/json.hpp>
+
+using json = nlohmann::json;
+
+/**
+ * @file FixOrderManager.cpp
+ *
+ * @brief Implements the `FixOrderManager` class: FIX order requests and their conversion to
+ *        Deribit JSON-RPC responses.
+ */
+
+namespace {
+
+/** @brief Maps OrdStatus (39) to Deribit's `order_state`. */
+const char* orderState(std::string_view ordStatus) {
+    if (ordStatus == "2") {
+        return "filled";
+    }
+    if (ordStatus == "4") {
+        return "cancelled";
+    }
+    if (ordStatus == "8") {
+        return "rejected";
+    }
+    return "open"; // New, partially filled, pending cancel/replace
+}
+
+std::string errorResponse(std::string_view message) {
+    return json{{"error", {{"message", std::string(message)}}}}.dump();
+}
+
+/** @brief Converts an ExecutionReport to the `private/buy` style response. */
+std::string executionResponse(const FixMessage& message) {
+    if (message.get(FixTag::OrdStatus) == "8") {
+        const std::string_view text = message.get(FixTag::Text);
+        return errorResponse(text.empty() ? "Order rejected" : text);
+    }
+    json order = {
+        {"order_id", std::string(message.get(FixTag::OrderID))},
+        {"order_state", orderState(message.get(FixTag::OrdStatus))},
+        {"instrument_name", std::string(message.get(FixTag::Symbol))},
+        {"direction", message.get(FixTag::Side) == "2" ? "sell" : "buy"},
+        {"amount", message.getDouble(FixTag::OrderQty)},
+        {"filled_amount", message.getDouble(FixTag::CumQty)},
+        {"price", message.getDouble(FixTag::Price)}
+    };
+    return json{{"result", {{"order", order}}}}.dump();
+}
+
+} // namespace
+
+FixOrderManager::FixOrderManager(FixSession& session, std::chrono::milliseconds timeout)
+    : session(session), timeout(timeout) {}
+
+/**
+ * @brief The lock is held while sending so the answer cannot be handled before the request is
+ *        registered; the session thread never holds its send lock while calling `onMessage`.
+ */
+template <typename Fill>
+std::string FixOrderManager::request(const char* msgType, const std::string& key, Fill&& fill) {
+    std::unique_lock<std::mutex> lock(mutex);
+    const uint64_t seq = session.send(msgType, std::forward<Fill>(fill));
+    if (seq == 0) {
+        return errorResponse("FIX session is not connected");
+    }
+    pending[key];
+    bySequence[seq] = key;
+
+    const bool done = answered.wait_for(lock, timeout, [this, &key]() { return pending[key].done; });
+    std::string response = done ? std::move(pending[key].response) : errorResponse("No answer from the FIX session");
+    pending.erase(key);
+    bySequence.erase(seq);
+    return response;
+}
+
+void FixOrderManager::complete(const std::string& key, std::string response) {
+    auto it = pending.find(key);
+    if (it == pending.end() || it->second.done) {
+        return;
+    }
+    it->second.done = true;
+    it->second.response = std::move(response);
+    answered.notify_all();
+}
+
+std::string FixOrderManager::nextClOrdId() {
+    return "goquant-" + std::to_string(++requestCounter);
+}
+
+std::string FixOrderManager::placeOrder(const std::string& instrument, const std::string& side, double quantity, double price) {
+    if (side != "buy" && side != "sell") {
+        return errorResponse("Invalid side: " + side);
+    }
+    std::string clOrdId;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        clOrdId = nextClOrdId();
+    }
+    return request("D", clOrdId, [&](FixWriter& w) {
+        w.add(FixTag::ClOrdID, clOrdId);
+        w.add(FixTag::Symbol, instrument);
+        w.add(FixTag::Side, side == "buy" ? '1' : '2');
+        w.add(FixTag::OrderQty, quantity);
+        w.add(FixTag::Price, price);
+        w.add(FixTag::OrdType, '2');
+    });
+}
+
+/**
+ * @brief OrderCancelReplaceRequest must repeat the instrument and side, which are taken from the
+ *        execution reports seen for the order.
+ */
+std::string FixOrderManager::modifyOrder(const std::string& orderId, double newQuantity, double newPrice) {
+    std::string clOrdId;
+    KnownOrder known;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto it = knownOrders.find(orderId);
+        if (it == knownOrders.end()) {
+            return errorResponse("Unknown order on this FIX session: " + orderId);
+        }
+        known = it->second;
+        clOrdId = nextClOrdId();
+    }
+    return request("G", clOrdId, [&](FixWriter& w) {
+        w.add(FixTag::OrigClOrdID, orderId);
+        w.add(FixTag::ClOrdID, clOrdId);
+        w.add(FixTag::Side, known.side);
+        w.add(FixTag::OrderQty, newQuantity);
+        w.add(FixTag::Price, newPrice);
+        w.add(FixTag::Symbol, known.symbol);
+        w.add(FixTag::OrdType, '2');
+    });
+}
+
+std::string FixOrderManager::cancelOrder(const std::string& orderId) {
+    std::string clOrdId;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        clOrdId = nextClOrdId();
+    }
+    return request("F", clOrdId, [&](FixWriter& w) {
+        w.add(FixTag::OrigClOrdID, orderId);
+        w.add(FixTag::ClOrdID, clOrdId);
+    });
+}
+
+std::string FixOrderManager::cancelAllOrders(const std::string& instrument) {
+    std::string clOrdId;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        clOrdId = nextClOrdId();
+    }
+    return request("q", clOrdId, [&](FixWriter& w) {
+        w.add(FixTag::ClOrdID, clOrdId);
+        if (instrument.empty()) {
+            w.add(FixTag::MassCancelRequestType, '7'); // All orders
+        } else {
+            w.add(FixTag::MassCancelRequestType, '1'); // By security
+            w.add(FixTag::Symbol, instrument);
+        }
+    });
+}
+
+std::string FixOrderManager::getOrderState(const std::string& orderId) {
+    std::string requestId;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        requestId = nextClOrdId();
+    }
+    return request("H", requestId, [&](FixWriter& w) {
+        w.add(FixTag::OrdStatusReqID, requestId);
+        w.add(FixTag::OrderID, orderId);
+    });
+}
+
+/**
+ * @brief Remembers the instrument and side of every live order seen, then completes the request
+ *        the message answers. Unsolicited execution reports (fills) only update the known orders;
+ *        an order is forgotten once it reaches a terminal state (filled, cancelled or rejected).
+ */
+void FixOrderManager::onMessage(const FixMessage& message) {
+    const std::string_view type = message.msgType();
+    std::lock_guard<std::mutex> lock(mutex);
+
+    if (type == "8") { // ExecutionReport
+        const std::string_view orderId = message.get(FixTag::OrderID);
+        const std::string_view side = message.get(FixTag::Side);
+        const std::string_view status = message.get(FixTag::OrdStatus);
+        if (status == "2" || status == "4" || status == "8") {
+            knownOrders.erase(std::string(orderId));
+        } else if (!orderId.empty() && message.has(FixTag::Symbol) && !side.empty()) {
+            knownOrders[std::string(orderId)] = KnownOrder{std::string(message.get(FixTag::Symbol)), side[0]};
+        }
+        const std::string_view statusRequest = message.get(FixTag::OrdStatusReqID);
+        const std::string key(statusRequest.empty() ? message.get(FixTag::ClOrdID) : statusRequest);
+        complete(key, executionResponse(message));
+    } else if (type == "9") { // OrderCancelReject
+        const std::string_view text = message.get(FixTag::Text);
+        complete(std::string(message.get(FixTag::ClOrdID)), errorResponse(text.empty() ? "Cancel rejected" : text));
+    } else if (type == "r") { // OrderMassCancelReport
+        const std::string key(message.get(FixTag::ClOrdID));
+        if (message.get(FixTag::MassCancelResponse) == "0") {
+            const std::string_view text = message.get(FixTag::Text);
+            complete(key, errorResponse(text.empty() ? "Mass cancel rejected" : text));
+        } else {
+            complete(key, json{{"result", message.getInt(FixTag::TotalAffectedOrders)}}.dump());
+        }
+    } else if (type == "3") { // Session-level Reject of one of our requests
+        auto it = bySequence.find(static_cast<uint64_t>(message.getInt(FixTag::RefSeqNum)));
+        if (it != bySequence.end()) {
+            const std::string_view text = message.get(FixTag::Text);
+            complete(it->second, errorResponse(text.empty() ? "Rejected by the FIX session" : text));
+        }
+    }
+}
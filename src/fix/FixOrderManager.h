@@ -0,0 +1,103 @@
+#ifndef FIX_ORDER_MANAGER_H
+#define FIX_ORDER_MANAGER_H
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include "../order_management/OrderEntry.h"
+
+class FixSession;
+class FixMessage;
+
+/**
+ * @file FixOrderManager.h
+ *
+ * @brief Defines the `FixOrderManager` class, order entry over a FIX session.
+ *
+ * Each call sends the matching FIX request and blocks until the exchange answers it (or the
+ * timeout expires), then converts the answer to the Deribit JSON-RPC response format used by
+ * `OrderManager`. Requests are matched to answers by ClOrdID (11), OrdStatusReqID (790) or, for
+ * session-level rejects, by RefSeqNum (45).
+ *
+ * | Call              | FIX request                          | Answer                                |
+ * |-------------------|--------------------------------------|---------------------------------------|
+ * | `placeOrder`      | NewOrderSingle (D)                   | ExecutionReport (8)                   |
+ * | `modifyOrder`     | OrderCancelReplaceRequest (G)        | ExecutionReport / OrderCancelReject (9) |
+ * | `cancelOrder`     | OrderCancelRequest (F)               | ExecutionReport / OrderCancelReject   |
+ * | `cancelAllOrders` | OrderMassCancelRequest (q)           | OrderMassCancelReport (r)             |
+ * | `getOrderState`   | OrderStatusRequest (H)               | ExecutionReport                       |
+ */
+
+/**
+ * @class FixOrderManager
+ *
+ * @brief `OrderEntry` implementation that trades over a logged-on `FixSession`.
+ *
+ * ### Example:
+ * ```
+ * FixOrderManager fixOrders(session);
+ * session.setMessageHandler([&](const FixMessage& message) { fixOrders.onMessage(message); });
+ * std::string response = fixOrders.placeOrder("BTC-PERPETUAL", "buy", 10, 30000);
+ * ```
+ */
+class FixOrderManager : public OrderEntry {
+public:
+    /**
+     * @brief Constructs the order manager.
+     *
+     * @param session The FIX session; it must outlive the manager and route its application
+     *                messages to `onMessage`.
+     * @param timeout How long a call waits for the exchange's answer.
+     */
+    explicit FixOrderManager(FixSession& session, std::chrono::milliseconds timeout = std::chrono::seconds(5));
+
+    std::string placeOrder(const std::string& instrument, const std::string& side, double quantity, double price) override;
+    std::string modifyOrder(const std::string& orderId, double newQuantity, double newPrice) override;
+    std::string cancelOrder(const std::string& orderId) override;
+    std::string cancelAllOrders(const std::string& instrument = "") override;
+    std::string getOrderState(const std::string& orderId) override;
+
+    /** @brief Handles an application message of the session (called on the session thread). */
+    void onMessage(const FixMessage& message);
+
+private:
+    /** @brief Instrument and side of an order, needed by OrderCancelReplaceRequest. */
+    struct KnownOrder {
+        std::string symbol;
+        char side;
+    };
+
+    /** @brief A request waiting for its answer. */
+    struct Pending {
+        bool done{false};
+        std::string response;
+    };
+
+    /**
+     * @brief Sends a request and waits for the answer correlated by `key`.
+     *
+     * @param fill Writes the request's body fields.
+     */
+    template <typename Fill>
+    std::string request(const char* msgType, const std::string& key, Fill&& fill);
+
+    /** @brief Completes the pending request `key` with a response, if it is still waiting. */
+    void complete(const std::string& key, std::string response);
+
+    /** @brief Returns a new, session-unique ClOrdID. */
+    std::string nextClOrdId();
+
+    FixSession& session;
+    std::chrono::milliseconds timeout;
+    std::mutex mutex;
+    std::condition_variable answered;
+    std::unordered_map<std::string, Pending> pending;       /**< Keyed by ClOrdID or OrdStatusReqID. */
+    std::unordered_map<uint64_t, std::string> bySequence;   /**< MsgSeqNum of a pending request -> its key. */
+    std::unordered_map<std::string, KnownOrder> knownOrders; /**< OrderID -> instrument and side. */
+    uint64_t requestCounter{0};
+};
+
+#endif // FIX_ORDER_MANAGER_H
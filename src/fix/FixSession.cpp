@@ -0,0 +1,550 @@
+#include "FixSession.h"
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+#include <iostream>
+#include <fcntl.h>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <openssl/evp.h>
+#include <openssl/rand.h>
+#include <fmt/color.h>
+#include <fmt/format.h>
+
+// Define color constants for clarity
+const auto ERROR_COLOR = fmt::fg(fmt::color::red);
+const auto SUCCESS_COLOR = fmt::fg(fmt::color::cyan);
+const auto INFO_COLOR = fmt::fg(fmt::color::blue);
+const auto HIGHLIGHT_COLOR = fmt::fg(fmt::color::yellow);
+
+/**
+ * @file FixSession.cpp
+ *
+ * @brief Implements the `FixSession` class: connection, Logon, heartbeats, sequence persistence and
+ *        resend handling.
+ */
+
+namespace {
+
+/** @brief Width of one sequence number record in the sequence file ("%020llu\n"). */
+constexpr std::size_t SEQUENCE_RECORD = 21;
+
+int64_t steadyNowNs() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+/** @brief Formats the current UTC time as YYYYMMDD-HH:MM:SS.sss. */
+void formatSendingTime(char (&out)[24]) {
+    const auto now = std::chrono::system_clock::now();
+    const auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(now.time_since_epoch()).count();
+    const std::time_t seconds = static_cast<std::time_t>(ms / 1000);
+    std::tm utc{};
+    gmtime_r(&seconds, &utc);
+    const auto end = fmt::format_to_n(out, sizeof(out) - 1, "{:04}{:02}{:02}-{:02}:{:02}:{:02}.{:03}", utc.tm_year + 1900,
+                                      utc.tm_mon + 1, utc.tm_mday, utc.tm_hour, utc.tm_min, utc.tm_sec, ms % 1000).out;
+    *end = '\0';
+}
+
+std::string base64(const unsigned char* data, std::size_t length) {
+    std::string encoded(4 * ((length + 2) / 3), '\0');
+    const int written = EVP_EncodeBlock(reinterpret_cast<unsigned char*>(&encoded[0]), data, static_cast<int>(length));
+    encoded.resize(static_cast<std::size_t>(std::max(written, 0)));
+    return encoded;
+}
+
+/** @brief Deribit Logon signature: base64(sha256(RawData ++ client_secret)). */
+std::string signLogon(const std::string& rawData, const std::string& secret) {
+    const std::string input = rawData + secret;
+    unsigned char digest[EVP_MAX_MD_SIZE];
+    unsigned int digestLength = 0;
+    EVP_Digest(input.data(), input.size(), digest, &digestLength, EVP_sha256(), nullptr);
+    return base64(digest, digestLength);
+}
+
+int connectTcp(const std::string& host, const std::string& port) {
+    addrinfo hints{};
+    hints.ai_family = AF_UNSPEC;
+    hints.ai_socktype = SOCK_STREAM;
+    addrinfo* results = nullptr;
+    if (getaddrinfo(host.c_str(), port.c_str(), &hints, &results) != 0) {
+        return -1;
+    }
+
+    int fd = -1;
+    for (addrinfo* entry = results; entry; entry = entry->ai_next) {
+        fd = ::socket(entry->ai_family, entry->ai_socktype | SOCK_CLOEXEC, entry->ai_protocol);
+        if (fd < 0) {
+            continue;
+        }
+        if (::connect(fd, entry->ai_addr, entry->ai_addrlen) == 0) {
+            break;
+        }
+        ::close(fd);
+        fd = -1;
+    }
+    freeaddrinfo(results);
+
+    if (fd >= 0) {
+        const int enable = 1;
+        setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &enable, sizeof(enable));
+    }
+    return fd;
+}
+
+} // namespace
+
+FixSession::FixSession(FixSessionConfig sessionConfig)
+    : config(std::move(sessionConfig)), store(STORE_CAPACITY) {
+    if (config.sequenceFile.empty()) {
+        config.sequenceFile = config.senderCompId + "-" + config.targetCompId + ".seq";
+    }
+}
+
+FixSession::~FixSession() {
+    logout();
+    if (sequenceFd >= 0) {
+        ::close(sequenceFd);
+    }
+}
+
+void FixSession::setMessageHandler(MessageHandler handler) {
+    onMessage = std::move(handler);
+}
+
+/**
+ * @brief RawData is "<timestamp ms>.<base64 nonce>" and Password its signature with the client
+ *        secret, as required by Deribit's FIX Logon.
+ */
+bool FixSession::logon(std::chrono::seconds timeout) {
+    if (running) {
+        return loggedOn;
+    }
+
+    loadSequences();
+    if (config.resetOnLogon) {
+        nextOutSeq = 1;
+        nextInSeq = 1;
+        persistSequence(true, 1);
+        persistSequence(false, 1);
+    }
+
+    const int socket = connectTcp(config.host, config.port);
+    if (socket < 0) {
+        std::cerr << fmt::format(ERROR_COLOR, "FIX connection to {}:{} failed\n", config.host, config.port);
+        return false;
+    }
+    {
+        std::lock_guard<std::mutex> lock(sendMutex);
+        fd = socket;
+    }
+
+    loggedOn = false;
+    logoutSent = false;
+    resendPending = false;
+    testRequestPending = false;
+    running = true;
+    sessionThread = std::thread([this]() { run(); });
+
+    unsigned char nonce[32];
+    RAND_bytes(nonce, sizeof(nonce));
+    const auto nowMs = std::chrono::duration_cast<std::chrono::milliseconds>(
+                           std::chrono::system_clock::now().time_since_epoch()).count();
+    const std::string rawData = std::to_string(nowMs) + "." + base64(nonce, sizeof(nonce));
+    const std::string password = signLogon(rawData, config.clientSecret);
+
+    sendAdmin("A", [&](FixWriter& w) {
+        w.add(FixTag::EncryptMethod, int64_t{0});
+        w.add(FixTag::HeartBtInt, int64_t{config.heartbeatInterval});
+        w.add(FixTag::RawDataLength, static_cast<int64_t>(rawData.size()));
+        w.add(FixTag::RawData, rawData);
+        w.add(FixTag::Username, config.clientId);
+        w.add(FixTag::Password, password);
+        if (config.resetOnLogon) {
+            w.add(FixTag::ResetSeqNumFlag, 'Y');
+        }
+        w.add(FixTag::CancelOnDisconnect, config.cancelOnDisconnect ? 'Y' : 'N');
+    });
+
+    std::unique_lock<std::mutex> lock(stateMutex);
+    stateChanged.wait_for(lock, timeout, [this]() { return loggedOn || !running; });
+    const bool success = loggedOn;
+    lock.unlock();
+
+    if (!success) {
+        std::cerr << fmt::format(ERROR_COLOR, "FIX logon to {} was not acknowledged\n", config.targetCompId);
+        logout();
+        return false;
+    }
+    fmt::print(SUCCESS_COLOR, "FIX session {} -> {} logged on (next seq out {}, in {})\n", config.senderCompId,
+               config.targetCompId, nextSenderSeq(), nextTargetSeq());
+    return true;
+}
+
+void FixSession::logout() {
+    if (!running && !sessionThread.joinable()) {
+        return;
+    }
+
+    if (loggedOn && !logoutSent.exchange(true)) {
+        sendAdmin("5", [](FixWriter&) {});
+        std::unique_lock<std::mutex> lock(stateMutex);
+        stateChanged.wait_for(lock, std::chrono::seconds(2), [this]() { return !loggedOn || !running; });
+    }
+
+    running = false;
+    closeSocket();
+    if (sessionThread.joinable()) {
+        sessionThread.join();
+    }
+    loggedOn = false;
+}
+
+bool FixSession::isLoggedOn() const {
+    return loggedOn;
+}
+
+uint64_t FixSession::nextSenderSeq() const {
+    std::lock_guard<std::mutex> lock(sendMutex);
+    return nextOutSeq;
+}
+
+uint64_t FixSession::nextTargetSeq() const {
+    return nextInSeq;
+}
+
+void FixSession::writeHeader(std::string_view msgType, uint64_t seq, bool possDup, std::string_view origSendingTime) {
+    formatSendingTime(sendingTime);
+    writer.begin(msgType);
+    writer.add(FixTag::SenderCompID, config.senderCompId);
+    writer.add(FixTag::TargetCompID, config.targetCompId);
+    writer.add(FixTag::MsgSeqNum, static_cast<int64_t>(seq));
+    if (possDup) {
+        writer.add(FixTag::PossDupFlag, 'Y');
+    }
+    writer.add(FixTag::SendingTime, std::string_view(sendingTime));
+    if (possDup && !origSendingTime.empty()) {
+        writer.add(FixTag::OrigSendingTime, origSendingTime);
+    }
+}
+
+/**
+ * @brief The message is stored for resend before it is written, and the sequence number is
+ *        persisted right after, so a crash never reuses a number the exchange may have seen.
+ */
+bool FixSession::transmit(std::string_view msgType, uint64_t seq, std::size_t bodyStart, bool storeForResend) {
+    const std::string_view body = writer.since(bodyStart);
+    const std::string_view wire = writer.finish();
+    if (wire.empty()) {
+        std::cerr << fmt::format(ERROR_COLOR, "FIX message {} exceeds the writer capacity\n", msgType);
+        return false;
+    }
+
+    StoredMessage& slot = store[seq % STORE_CAPACITY];
+    slot.seq = 0;
+    if (storeForResend && body.size() <= STORED_BODY_SIZE && msgType.size() < sizeof(slot.msgType)) {
+        slot.seq = seq;
+        std::memcpy(slot.msgType, msgType.data(), msgType.size());
+        slot.msgType[msgType.size()] = '\0';
+        std::memcpy(slot.sendingTime, sendingTime, sizeof(sendingTime));
+        std::memcpy(slot.body, body.data(), body.size());
+        slot.length = static_cast<uint16_t>(body.size());
+    }
+
+    nextOutSeq = seq + 1;
+    persistSequence(true, nextOutSeq);
+    lastSentNs = steadyNowNs();
+    return writeAll(wire);
+}
+
+bool FixSession::writeAll(std::string_view data) {
+    while (!data.empty()) {
+        const ssize_t written = ::send(fd, data.data(), data.size(), MSG_NOSIGNAL);
+        if (written < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            std::cerr << fmt::format(ERROR_COLOR, "FIX send failed: {}\n", std::strerror(errno));
+            return false;
+        }
+        data.remove_prefix(static_cast<std::size_t>(written));
+    }
+    return true;
+}
+
+/**
+ * @brief Stored application messages are resent with PossDupFlag and their original SendingTime;
+ *        every run of admin or evicted sequence numbers collapses into one SequenceReset-GapFill.
+ */
+void FixSession::resend(uint64_t begin, uint64_t end) {
+    std::lock_guard<std::mutex> lock(sendMutex);
+    const uint64_t last = (end == 0 || end >= nextOutSeq) ? nextOutSeq - 1 : end;
+    uint64_t gapStart = 0;
+
+    auto flushGap = [this, &gapStart](uint64_t newSeq) {
+        if (gapStart == 0) {
+            return;
+        }
+        writeHeader("4", gapStart, true, {});
+        writer.add(FixTag::GapFillFlag, 'Y');
+        writer.add(FixTag::NewSeqNo, static_cast<int64_t>(newSeq));
+        const std::string_view wire = writer.finish();
+        if (!wire.empty()) {
+            writeAll(wire);
+        }
+        gapStart = 0;
+    };
+
+    for (uint64_t seq = std::max<uint64_t>(begin, 1); seq <= last; ++seq) {
+        const StoredMessage& slot = store[seq % STORE_CAPACITY];
+        if (slot.seq != seq) {
+            if (gapStart == 0) {
+                gapStart = seq;
+            }
+            continue;
+        }
+
+        flushGap(seq);
+        writeHeader(slot.msgType, seq, true, slot.sendingTime);
+        writer.addRaw(std::string_view(slot.body, slot.length));
+        const std::string_view wire = writer.finish();
+        if (!wire.empty()) {
+            writeAll(wire);
+        }
+    }
+    flushGap(last + 1);
+    lastSentNs = steadyNowNs();
+}
+
+void FixSession::loadSequences() {
+    if (sequenceFd < 0) {
+        sequenceFd = ::open(config.sequenceFile.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0600);
+        if (sequenceFd < 0) {
+            std::cerr << fmt::format(ERROR_COLOR, "Cannot open FIX sequence file {}: {}\n", config.sequenceFile, std::strerror(errno));
+            return;
+        }
+    }
+
+    char record[2 * SEQUENCE_RECORD + 1] = {};
+    const ssize_t length = ::pread(sequenceFd, record, 2 * SEQUENCE_RECORD, 0);
+    unsigned long long outbound = 1;
+    unsigned long long inbound = 1;
+    if (length == static_cast<ssize_t>(2 * SEQUENCE_RECORD) && std::sscanf(record, "%llu %llu", &outbound, &inbound) == 2) {
+        std::lock_guard<std::mutex> lock(sendMutex);
+        nextOutSeq = std::max<unsigned long long>(outbound, 1);
+        nextInSeq = std::max<unsigned long long>(inbound, 1);
+    } else {
+        persistSequence(true, 1);
+        persistSequence(false, 1);
+    }
+}
+
+/**
+ * @brief Each direction has its own fixed-width record, so the sending threads and the session
+ *        thread never overwrite each other's value. The page cache absorbs the writes; the file
+ *        survives a process crash, not a power loss.
+ */
+void FixSession::persistSequence(bool outbound, uint64_t value) {
+    if (sequenceFd < 0) {
+        return;
+    }
+    char record[SEQUENCE_RECORD + 1];
+    std::snprintf(record, sizeof(record), "%020llu\n", static_cast<unsigned long long>(value));
+    if (::pwrite(sequenceFd, record, SEQUENCE_RECORD, outbound ? 0 : SEQUENCE_RECORD) < 0) {
+        std::cerr << fmt::format(ERROR_COLOR, "Cannot persist FIX sequence number: {}\n", std::strerror(errno));
+    }
+}
+
+void FixSession::closeSocket() {
+    std::lock_guard<std::mutex> lock(sendMutex);
+    if (fd >= 0) {
+        ::shutdown(fd, SHUT_RDWR);
+        ::close(fd);
+        fd = -1;
+    }
+}
+
+/**
+ * @brief Reads with a one-second poll timeout so heartbeats go out and a silent peer is noticed
+ *        (TestRequest after 1.2 x HeartBtInt, disconnect after 2 x HeartBtInt).
+ */
+void FixSession::run() {
+    std::vector<char> buffer(64 * 1024);
+    std::size_t used = 0;
+    int socket;
+    {
+        std::lock_guard<std::mutex> lock(sendMutex);
+        socket = fd;
+    }
+    auto lastReceived = std::chrono::steady_clock::now();
+    const auto interval = std::chrono::seconds(config.heartbeatInterval);
+
+    while (running) {
+        pollfd descriptor{socket, POLLIN, 0};
+        const int ready = ::poll(&descriptor, 1, 1000);
+        if (ready < 0 && errno != EINTR) {
+            break;
+        }
+
+        if (ready > 0) {
+            if (used == buffer.size()) {
+                buffer.resize(buffer.size() * 2);
+            }
+            const ssize_t received = ::recv(socket, buffer.data() + used, buffer.size() - used, 0);
+            if (received <= 0) {
+                if (running) {
+                    std::cerr << fmt::format(ERROR_COLOR, "FIX connection closed by {}\n", config.targetCompId);
+                }
+                break;
+            }
+            used += static_cast<std::size_t>(received);
+            lastReceived = std::chrono::steady_clock::now();
+            testRequestPending = false;
+
+            std::size_t consumed = 0;
+            FixMessage message;
+            while (consumed < used) {
+                const std::string_view pending(buffer.data() + consumed, used - consumed);
+                const std::size_t length = FixMessage::frameLength(pending);
+                if (length == 0) {
+                    break;
+                }
+                if (length == FixMessage::INVALID || !message.parse(pending.substr(0, length))) {
+                    std::cerr << fmt::format(ERROR_COLOR, "Malformed FIX message from {}, disconnecting\n", config.targetCompId);
+                    running = false;
+                    break;
+                }
+                handle(message);
+                consumed += length;
+            }
+            std::memmove(buffer.data(), buffer.data() + consumed, used - consumed);
+            used -= consumed;
+        }
+
+        if (!loggedOn) {
+            continue;
+        }
+        const auto now = std::chrono::steady_clock::now();
+        if (std::chrono::nanoseconds(steadyNowNs() - lastSentNs.load()) >= interval) {
+            sendAdmin("0", [](FixWriter&) {});
+        }
+        if (now - lastReceived >= interval * 2) {
+            std::cerr << fmt::format(ERROR_COLOR, "FIX peer {} silent for {} s, disconnecting\n", config.targetCompId,
+                                     2 * config.heartbeatInterval);
+            break;
+        }
+        if (now - lastReceived >= interval + interval / 5 && !testRequestPending) {
+            sendAdmin("1", [](FixWriter& w) { w.add(FixTag::TestReqID, std::string_view("TEST")); });
+            testRequestPending = true;
+        }
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(stateMutex);
+        loggedOn = false;
+        running = false;
+    }
+    stateChanged.notify_all();
+}
+
+/**
+ * @brief Enforces MsgSeqNum order: a gap triggers one ResendRequest and later messages are dropped
+ *        until the resent ones arrive; PossDup duplicates are ignored.
+ *
+ * A SequenceReset in Reset mode applies unconditionally. A GapFill is sequenced like any other
+ * message: it only moves the expected number when its own MsgSeqNum is the expected one, and one
+ * that arrives after a gap is itself the sign of a gap (the messages before it are requested).
+ */
+void FixSession::handle(const FixMessage& message) {
+    const std::string_view type = message.msgType();
+    const uint64_t seq = message.seqNum();
+
+    if (type == "4" && message.get(FixTag::GapFillFlag) != "Y") { // SequenceReset-Reset
+        const uint64_t newSeq = static_cast<uint64_t>(message.getInt(FixTag::NewSeqNo, 0));
+        if (newSeq > 0) {
+            nextInSeq = newSeq;
+            persistSequence(false, newSeq);
+            resendPending = false;
+        }
+        return;
+    }
+
+    if (type == "A" && message.get(FixTag::ResetSeqNumFlag) == "Y") {
+        nextInSeq = seq;
+    }
+
+    if (seq > nextInSeq) {
+        if (!resendPending) {
+            const uint64_t from = nextInSeq;
+            sendAdmin("2", [from](FixWriter& w) {
+                w.add(FixTag::BeginSeqNo, static_cast<int64_t>(from));
+                w.add(FixTag::EndSeqNo, int64_t{0});
+            });
+            resendPending = true;
+        }
+        if (type == "2") {
+            resend(static_cast<uint64_t>(message.getInt(FixTag::BeginSeqNo, 1)), static_cast<uint64_t>(message.getInt(FixTag::EndSeqNo, 0)));
+        }
+        if (type != "A" && type != "5") {
+            return; // Redelivered by the resend
+        }
+    } else if (seq < nextInSeq) {
+        if (message.get(FixTag::PossDupFlag) != "Y") {
+            std::cerr << fmt::format(ERROR_COLOR, "FIX MsgSeqNum {} lower than expected {}, logging out\n", seq, nextInSeq.load());
+            running = false;
+        }
+        return;
+    } else {
+        nextInSeq = seq + 1;
+        persistSequence(false, seq + 1);
+        if (message.get(FixTag::PossDupFlag) != "Y") {
+            resendPending = false;
+        }
+    }
+
+    if (type == "A") {
+        {
+            std::lock_guard<std::mutex> lock(stateMutex);
+            loggedOn = true;
+        }
+        stateChanged.notify_all();
+    } else if (type == "1") { // TestRequest
+        const std::string testReqId(message.get(FixTag::TestReqID));
+        sendAdmin("0", [&testReqId](FixWriter& w) { w.add(FixTag::TestReqID, testReqId); });
+    } else if (type == "2") { // ResendRequest
+        resend(static_cast<uint64_t>(message.getInt(FixTag::BeginSeqNo, 1)), static_cast<uint64_t>(message.getInt(FixTag::EndSeqNo, 0)));
+    } else if (type == "5") { // Logout
+        const std::string_view text = message.get(FixTag::Text);
+        if (!text.empty()) {
+            std::cerr << fmt::format(HIGHLIGHT_COLOR, "FIX logout from {}: {}\n", config.targetCompId, text);
+        }
+        if (!logoutSent.exchange(true)) {
+            sendAdmin("5", [](FixWriter&) {});
+        }
+        {
+            std::lock_guard<std::mutex> lock(stateMutex);
+            loggedOn = false;
+            running = false;
+        }
+        stateChanged.notify_all();
+    } else if (type == "4") { // SequenceReset-GapFill, in sequence
+        const uint64_t newSeq = static_cast<uint64_t>(message.getInt(FixTag::NewSeqNo, 0));
+        if (newSeq > nextInSeq) {
+            nextInSeq = newSeq;
+            persistSequence(false, newSeq);
+        }
+        resendPending = false; // A gap still left open is requested again by the next message
+    } else if (type != "0") {
+        if (type == "3") {
+            std::cerr << fmt::format(ERROR_COLOR, "FIX reject of message {}: {}\n", message.get(FixTag::RefSeqNum), message.get(FixTag::Text));
+        }
+        if (onMessage) {
+            onMessage(message);
+        }
+    }
+}
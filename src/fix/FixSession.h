@@ -0,0 +1,202 @@
+#ifndef FIX_SESSION_H
+#define FIX_SESSION_H
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+#include "FixCodec.h"
+
+/**
+ * @file FixSession.h
+ *
+ * @brief Defines the `FixSession` class, a FIX 4.4 initiator session for Deribit order entry.
+ *
+ * The session owns one TCP connection and implements the session layer: Logon with Deribit's
+ * signature-based authentication, heartbeats and test requests, sequence numbers persisted to a
+ * file so a restart continues where it left off, gap detection with ResendRequest, and answering
+ * the counterparty's ResendRequest from a ring of recently sent application messages (admin
+ * messages and evicted messages are replaced by SequenceReset-GapFill).
+ *
+ * ### Key Responsibilities:
+ * - Log on, keep the session alive and log out.
+ * - Assign, persist and verify sequence numbers; recover gaps in both directions.
+ * - Deliver application messages (execution reports, rejects, ...) to a handler.
+ */
+
+/**
+ * @struct FixSessionConfig
+ *
+ * @brief Connection and session settings.
+ */
+struct FixSessionConfig {
+    std::string host{"test.deribit.com"};   /**< FIX gateway host (plain TCP; use a TLS tunnel if required). */
+    std::string port{"9881"};               /**< FIX gateway port. */
+    std::string senderCompId;               /**< Our CompID (any ID chosen by the client). */
+    std::string targetCompId{"DERIBITSERVER"}; /**< The exchange's CompID. */
+    std::string clientId;                   /**< API key client ID (Username). */
+    std::string clientSecret;               /**< API key client secret (signs the Logon). */
+    int heartbeatInterval{30};              /**< HeartBtInt in seconds. */
+    std::string sequenceFile;               /**< Sequence number file; empty for "<sender>-<target>.seq". */
+    bool resetOnLogon{false};               /**< Start both sequences at 1 (ResetSeqNumFlag). */
+    bool cancelOnDisconnect{false};         /**< Ask the exchange to cancel our orders if the session drops. */
+};
+
+/**
+ * @class FixSession
+ *
+ * @brief FIX 4.4 initiator with persistent sequence numbers and resend support.
+ *
+ * ### Workflow:
+ * 1. `logon` connects, loads the sequence numbers, sends Logon and waits for the acknowledgement.
+ * 2. `send` transmits application messages from any thread; the session thread reads, answers
+ *    admin messages, sends heartbeats and passes application messages to the handler.
+ * 3. `logout` ends the session.
+ *
+ * ### Example:
+ * ```
+ * FixSession session(FixSessionConfig{"test.deribit.com", "9881", "GOQUANT", "DERIBITSERVER", id, secret});
+ * session.setMessageHandler([](const FixMessage& message) { ... });
+ * if (session.logon()) {
+ *     session.send("D", [](FixWriter& w) { w.add(FixTag::ClOrdID, "1"); ... });
+ * }
+ * ```
+ */
+class FixSession {
+public:
+    using MessageHandler = std::function<void(const FixMessage&)>;
+
+    static constexpr std::size_t STORE_CAPACITY = 4096;    /**< Sent application messages kept for resend. */
+    static constexpr std::size_t STORED_BODY_SIZE = 480;   /**< Larger bodies are gap-filled on resend. */
+
+    explicit FixSession(FixSessionConfig config);
+
+    /** @brief Logs out and closes the connection. */
+    ~FixSession();
+
+    FixSession(const FixSession&) = delete;
+    FixSession& operator=(const FixSession&) = delete;
+
+    /** @brief Sets the handler of application messages; called on the session thread. */
+    void setMessageHandler(MessageHandler handler);
+
+    /**
+     * @brief Connects and logs on.
+     *
+     * @param timeout How long to wait for the Logon acknowledgement.
+     * @return True once the exchange acknowledged the Logon.
+     */
+    bool logon(std::chrono::seconds timeout = std::chrono::seconds(10));
+
+    /** @brief Sends Logout, waits briefly for the answer and closes the connection. */
+    void logout();
+
+    /** @brief Returns true between the Logon acknowledgement and the end of the session. */
+    bool isLoggedOn() const;
+
+    /**
+     * @brief Sends an application message.
+     *
+     * @param msgType The MsgType (e.g., "D").
+     * @param fill Called with the writer to add the body fields.
+     * @return The MsgSeqNum assigned to the message, or 0 if it could not be sent.
+     */
+    template <typename Fill>
+    uint64_t send(std::string_view msgType, Fill&& fill) {
+        std::lock_guard<std::mutex> lock(sendMutex);
+        if (fd < 0) {
+            return 0;
+        }
+        const uint64_t seq = nextOutSeq;
+        writeHeader(msgType, seq, false, {});
+        const std::size_t bodyStart = writer.mark();
+        fill(writer);
+        return transmit(msgType, seq, bodyStart, true) ? seq : 0;
+    }
+
+    /** @brief Returns the next MsgSeqNum we will send. */
+    uint64_t nextSenderSeq() const;
+
+    /** @brief Returns the next MsgSeqNum expected from the exchange. */
+    uint64_t nextTargetSeq() const;
+
+private:
+    /** @brief A sent application message kept for resend. */
+    struct StoredMessage {
+        uint64_t seq{0};
+        char msgType[4]{};
+        char sendingTime[24]{};
+        uint16_t length{0};
+        char body[STORED_BODY_SIZE]{};
+    };
+
+    /** @brief Session thread: reads, dispatches and keeps the heartbeat schedule. */
+    void run();
+
+    /** @brief Applies sequence checks to one message and dispatches it. */
+    void handle(const FixMessage& message);
+
+    /** @brief Sends an admin message (not stored for resend). Takes `sendMutex`. */
+    template <typename Fill>
+    bool sendAdmin(std::string_view msgType, Fill&& fill) {
+        std::lock_guard<std::mutex> lock(sendMutex);
+        if (fd < 0) {
+            return false;
+        }
+        const uint64_t seq = nextOutSeq;
+        writeHeader(msgType, seq, false, {});
+        const std::size_t bodyStart = writer.mark();
+        fill(writer);
+        return transmit(msgType, seq, bodyStart, false);
+    }
+
+    /** @brief Starts a message with the standard header. Requires `sendMutex`. */
+    void writeHeader(std::string_view msgType, uint64_t seq, bool possDup, std::string_view origSendingTime);
+
+    /** @brief Finishes and writes the message; a new sequence number is consumed. Requires `sendMutex`. */
+    bool transmit(std::string_view msgType, uint64_t seq, std::size_t bodyStart, bool store);
+
+    /** @brief Writes raw bytes to the socket. Requires `sendMutex`. */
+    bool writeAll(std::string_view data);
+
+    /** @brief Answers a ResendRequest for [begin, end] (end 0 = up to the latest). */
+    void resend(uint64_t begin, uint64_t end);
+
+    /** @brief Loads the sequence numbers from the sequence file. */
+    void loadSequences();
+
+    /** @brief Writes one sequence number to its slot in the sequence file. */
+    void persistSequence(bool outbound, uint64_t value);
+
+    /** @brief Closes the socket (the session thread then exits). */
+    void closeSocket();
+
+    FixSessionConfig config;
+    int fd{-1};                            /**< Connected socket (guarded by `sendMutex` for writes). */
+    int sequenceFd{-1};                    /**< Sequence file. */
+    FixWriter writer;                      /**< Outbound message buffer (guarded by `sendMutex`). */
+    char sendingTime[24]{};                /**< SendingTime of the message being written. */
+    mutable std::mutex sendMutex;
+    uint64_t nextOutSeq{1};                /**< Guarded by `sendMutex`. */
+    std::atomic<uint64_t> nextInSeq{1};    /**< Written by the session thread only. */
+    std::vector<StoredMessage> store;      /**< Ring indexed by seq % STORE_CAPACITY (guarded by `sendMutex`). */
+    MessageHandler onMessage;
+    std::thread sessionThread;
+    std::atomic<bool> running{false};
+    std::atomic<bool> loggedOn{false};
+    std::atomic<bool> logoutSent{false};
+    std::atomic<int64_t> lastSentNs{0};
+    std::mutex stateMutex;
+    std::condition_variable stateChanged;  /**< Signals Logon/Logout acknowledgements. */
+    bool resendPending{false};             /**< Session thread only. */
+    bool testRequestPending{false};        /**< Session thread only. */
+};
+
+#endif // FIX_SESSION_H
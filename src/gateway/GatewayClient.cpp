@@ -0,0 +1,176 @@
+#include "GatewayClient.h"
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+/**
+ * @file GatewayClient.cpp
+ *
+ * @brief Implements the `GatewayClient` class for the shared memory and socket transports.
+ */
+
+GatewayClient::GatewayClient() : region(nullptr), slot(0), generation(0), socketFd(-1), mode(Transport::None) {}
+
+GatewayClient::~GatewayClient() {
+    close();
+}
+
+GatewayClient::Transport GatewayClient::connect() {
+    if (mode != Transport::None) {
+        return mode;
+    }
+    if (attachSharedMemory()) {
+        mode = Transport::SharedMemory;
+    } else if (connectSocket()) {
+        mode = Transport::Socket;
+    }
+    return mode;
+}
+
+/**
+ * @brief Maps the gateway's region and claims a free client slot with a CAS.
+ *
+ * The pid is published before the generation is bumped, so the gateway's liveness check never
+ * sees a claimed slot of a new generation without an owner. Events left in the slot by a previous
+ * client are drained (not reset), because the gateway may still be producing into the ring; any
+ * that slip in afterwards carry the old generation and are skipped by `poll`.
+ */
+bool GatewayClient::attachSharedMemory() {
+    const int fd = ::shm_open(GatewayProtocol::SHM_NAME, O_RDWR, 0);
+    if (fd < 0) {
+        return false;
+    }
+
+    void* memory = ::mmap(nullptr, sizeof(GatewaySharedRegion), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (memory == MAP_FAILED) {
+        return false;
+    }
+
+    auto* shared = static_cast<GatewaySharedRegion*>(memory);
+    if (shared->magic.load(std::memory_order_acquire) != GatewayProtocol::MAGIC || shared->version != GatewayProtocol::VERSION) {
+        ::munmap(memory, sizeof(GatewaySharedRegion));
+        return false;
+    }
+
+    for (uint32_t i = 0; i < GatewayProtocol::MAX_CLIENTS; ++i) {
+        uint32_t expected = 0;
+        GatewayClientSlot& client = shared->clients[i];
+        if (client.inUse.compare_exchange_strong(expected, 1, std::memory_order_acq_rel)) {
+            client.pid.store(static_cast<int32_t>(::getpid()), std::memory_order_release);
+            generation = client.generation.fetch_add(1, std::memory_order_acq_rel) + 1;
+            GatewayEvent stale;
+            while (client.events.tryPop(stale)) {
+            }
+            region = shared;
+            slot = i;
+            return true;
+        }
+    }
+
+    ::munmap(memory, sizeof(GatewaySharedRegion)); // All slots taken: use the socket instead
+    return false;
+}
+
+bool GatewayClient::connectSocket() {
+    const int fd = ::socket(AF_UNIX, SOCK_SEQPACKET, 0);
+    if (fd < 0) {
+        return false;
+    }
+
+    sockaddr_un address{};
+    address.sun_family = AF_UNIX;
+    std::strncpy(address.sun_path, GatewayProtocol::SOCKET_PATH, sizeof(address.sun_path) - 1);
+    if (::connect(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0) {
+        ::close(fd);
+        return false;
+    }
+
+    socketFd = fd;
+    return true;
+}
+
+void GatewayClient::close() {
+    if (region) {
+        region->clients[slot].pid.store(0, std::memory_order_relaxed);
+        region->clients[slot].inUse.store(0, std::memory_order_release);
+        ::munmap(region, sizeof(GatewaySharedRegion));
+        region = nullptr;
+    }
+    if (socketFd >= 0) {
+        ::close(socketFd);
+        socketFd = -1;
+    }
+    mode = Transport::None;
+}
+
+bool GatewayClient::placeOrder(uint64_t requestId, const std::string& instrument, const std::string& side, double amount, double price) {
+    GatewayRequest request{};
+    request.requestId = requestId;
+    request.type = side == "sell" ? GatewayRequestType::Sell : GatewayRequestType::Buy;
+    GatewayProtocol::copyField(request.instrument, instrument);
+    request.amount = amount;
+    request.price = price;
+    return submit(request);
+}
+
+bool GatewayClient::cancelOrder(uint64_t requestId, const std::string& orderId) {
+    GatewayRequest request{};
+    request.requestId = requestId;
+    request.type = GatewayRequestType::Cancel;
+    GatewayProtocol::copyField(request.orderId, orderId);
+    return submit(request);
+}
+
+bool GatewayClient::modifyOrder(uint64_t requestId, const std::string& orderId, double amount, double price) {
+    GatewayRequest request{};
+    request.requestId = requestId;
+    request.type = GatewayRequestType::Edit;
+    GatewayProtocol::copyField(request.orderId, orderId);
+    request.amount = amount;
+    request.price = price;
+    return submit(request);
+}
+
+bool GatewayClient::cancelAll(uint64_t requestId, const std::string& instrument) {
+    GatewayRequest request{};
+    request.requestId = requestId;
+    request.type = GatewayRequestType::CancelAll;
+    GatewayProtocol::copyField(request.instrument, instrument);
+    return submit(request);
+}
+
+bool GatewayClient::submit(GatewayRequest& request) {
+    if (mode == Transport::SharedMemory) {
+        request.clientId = slot;
+        request.generation = generation;
+        return region->requests.tryPush(request);
+    }
+    if (mode == Transport::Socket) {
+        return ::send(socketFd, &request, sizeof(request), MSG_NOSIGNAL) == static_cast<ssize_t>(sizeof(request));
+    }
+    return false;
+}
+
+bool GatewayClient::poll(GatewayEvent& out) {
+    if (mode == Transport::SharedMemory) {
+        while (region->clients[slot].events.tryPop(out)) {
+            if (out.generation == generation) {
+                return true;
+            }
+        }
+        return false;
+    }
+    if (mode == Transport::Socket) {
+        return ::recv(socketFd, &out, sizeof(out), MSG_DONTWAIT) == static_cast<ssize_t>(sizeof(out));
+    }
+    return false;
+}
+
+GatewayClient::Transport GatewayClient::transport() const {
+    return mode;
+}
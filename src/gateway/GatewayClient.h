@@ -0,0 +1,119 @@
+#ifndef GATEWAY_CLIENT_H
+#define GATEWAY_CLIENT_H
+
+#include <cstdint>
+#include <string>
+#include "GatewayProtocol.h"
+
+/**
+ * @file GatewayClient.h
+ *
+ * @brief Defines the `GatewayClient` class, used by external strategy processes to trade through a
+ *        running `GoQuant --gateway`.
+ *
+ * The client prefers the shared memory transport (claims a client slot, pushes requests into the
+ * shared MPSC ring, polls its own event ring) and falls back to the Unix-domain socket when the
+ * shared memory object is missing or full. Both transports carry the same fixed-size messages.
+ */
+
+/**
+ * @class GatewayClient
+ *
+ * @brief Connection of one local process to the order gateway.
+ *
+ * ### Example:
+ * ```
+ * GatewayClient client;
+ * if (client.connect() != GatewayClient::Transport::None) {
+ *     client.placeOrder(1, "BTC-PERPETUAL", "buy", 10, 30000);
+ *     GatewayEvent event;
+ *     while (!client.poll(event)) {}
+ *     std::cout << event.orderId << std::endl;
+ * }
+ * ```
+ */
+class GatewayClient {
+public:
+    enum class Transport {
+        None,          /**< Not connected. */
+        SharedMemory,  /**< Attached to the shared memory rings. */
+        Socket         /**< Connected over the Unix-domain socket. */
+    };
+
+    GatewayClient();
+
+    /** @brief Detaches from the gateway. */
+    ~GatewayClient();
+
+    GatewayClient(const GatewayClient&) = delete;
+    GatewayClient& operator=(const GatewayClient&) = delete;
+
+    /**
+     * @brief Attaches over shared memory, or connects over the socket if that fails.
+     *
+     * @return The transport in use, or `Transport::None` if the gateway is not running.
+     */
+    Transport connect();
+
+    /** @brief Releases the client slot or closes the socket. */
+    void close();
+
+    /**
+     * @brief Submits a limit order.
+     *
+     * @param requestId Client-chosen ID echoed in the resulting events.
+     * @param side "buy" or "sell".
+     * @return False if not connected or the request ring is full.
+     */
+    bool placeOrder(uint64_t requestId, const std::string& instrument, const std::string& side, double amount, double price);
+
+    /**
+     * @brief Submits a cancellation.
+     *
+     * @return False if not connected or the request ring is full.
+     */
+    bool cancelOrder(uint64_t requestId, const std::string& orderId);
+
+    /**
+     * @brief Submits an edit of a resting order.
+     *
+     * Edits of the same order are conflated by the gateway: an edit still waiting to be sent is
+     * replaced by a newer one (and rejected as superseded).
+     *
+     * @return False if not connected or the request ring is full.
+     */
+    bool modifyOrder(uint64_t requestId, const std::string& orderId, double amount, double price);
+
+    /**
+     * @brief Submits the kill switch; it is sent ahead of every queued edit and new order.
+     *
+     * @param instrument Limits the cancellation to one instrument; empty for every order of the account.
+     * @return False if not connected or the request ring is full.
+     */
+    bool cancelAll(uint64_t requestId, const std::string& instrument = "");
+
+    /**
+     * @brief Fetches the next event without blocking.
+     *
+     * Events addressed to a previous client of the same shared memory slot are skipped.
+     *
+     * @return True if an event was written to `out`.
+     */
+    bool poll(GatewayEvent& out);
+
+    /** @brief Returns the transport in use. */
+    Transport transport() const;
+
+private:
+    bool attachSharedMemory();
+    bool connectSocket();
+    bool submit(GatewayRequest& request);
+
+    GatewaySharedRegion* region; /**< Mapped region (shared memory transport). */
+    uint32_t slot;               /**< Claimed client slot (shared memory transport). */
+    uint32_t generation;         /**< Generation of the claimed slot (shared memory transport). */
+    int socketFd;                /**< Connected socket (socket transport). */
+    Transport mode;
+};
+
+#endif // GATEWAY_CLIENT_H
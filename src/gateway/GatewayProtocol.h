@@ -0,0 +1,135 @@
+#ifndef GATEWAY_PROTOCOL_H
+#define GATEWAY_PROTOCOL_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include "../utils/MpscRing.h"
+
+/**
+ * @file GatewayProtocol.h
+ *
+ * @brief Wire format shared by the order gateway (`GoQuant --gateway`) and its local clients.
+ *
+ * Messages are fixed-size, trivially copyable structs so that they can be copied into shared
+ * memory rings or sent as single `SOCK_SEQPACKET` datagrams without any serialization. The shared
+ * memory region holds one request ring (many clients -> gateway) and one event ring per client
+ * slot (gateway -> client).
+ *
+ * A slot is reused by later processes, so every attach bumps the slot's `generation`. Requests and
+ * events carry the generation they belong to: the gateway only delivers to the current generation
+ * of a slot, and a client ignores events stamped with an older one. The slot also records the
+ * owner's pid, which lets the gateway free slots of processes that exited without detaching.
+ */
+
+/**
+ * @struct GatewayProtocol
+ *
+ * @brief Names, limits and helpers shared by the gateway server and clients.
+ */
+struct GatewayProtocol {
+    /** @brief Name of the POSIX shared memory object created by the gateway. */
+    static constexpr const char* SHM_NAME = "/goquant_gateway";
+
+    /** @brief Path of the Unix-domain socket used when shared memory is unavailable. */
+    static constexpr const char* SOCKET_PATH = "/tmp/goquant_gateway.sock";
+
+    /** @brief Identifies a compatible shared memory layout. */
+    static constexpr uint32_t MAGIC = 0x47514757u; // "GQGW"
+    static constexpr uint32_t VERSION = 2;
+
+    /** @brief Maximum number of concurrently attached shared memory clients. */
+    static constexpr std::size_t MAX_CLIENTS = 16;
+
+    static constexpr std::size_t REQUEST_RING_SIZE = 4096;
+    static constexpr std::size_t EVENT_RING_SIZE = 1024;
+
+    /** @brief Client ID used for requests that arrive over the Unix-domain socket. */
+    static constexpr uint32_t SOCKET_CLIENT = 0xFFFFFFFFu;
+
+    /** @brief Copies a string into a fixed-size field, always leaving it NUL-terminated. */
+    template <std::size_t N>
+    static void copyField(char (&field)[N], const std::string& value) {
+        const std::size_t length = value.size() < N - 1 ? value.size() : N - 1;
+        std::memcpy(field, value.data(), length);
+        field[length] = '\0';
+    }
+};
+
+enum class GatewayRequestType : uint8_t {
+    Buy,
+    Sell,
+    Cancel,
+    Edit,      /**< New amount and price of a resting order. */
+    CancelAll  /**< Kill switch: every order of the account, or of one instrument. */
+};
+
+/**
+ * @struct GatewayRequest
+ *
+ * @brief An order instruction from a client.
+ */
+struct GatewayRequest {
+    uint64_t requestId;       /**< Client-chosen ID echoed in every event about this request. */
+    uint32_t clientId;        /**< Shared memory client slot (filled in by `GatewayClient`). */
+    uint32_t generation;      /**< Generation of the slot when the request was sent (filled in by `GatewayClient`). */
+    GatewayRequestType type;  /**< Buy, sell, edit, cancel or cancel all. */
+    char instrument[64];      /**< Instrument name (buy/sell; optional for cancel all). */
+    char orderId[64];         /**< Exchange order ID (edit/cancel). */
+    double amount;            /**< Order amount (buy/sell/edit). */
+    double price;             /**< Limit price (buy/sell/edit). */
+};
+
+enum class GatewayEventType : uint8_t {
+    Ack,       /**< Order (or edit) accepted by the exchange. */
+    Reject,    /**< Request refused by the gateway or the exchange. */
+    Fill,      /**< Trade on one of the client's orders. */
+    Cancelled  /**< Cancellation confirmed (also sent for each order removed by a cancel all). */
+};
+
+/**
+ * @struct GatewayEvent
+ *
+ * @brief An acknowledgement or fill sent back to a client.
+ */
+struct GatewayEvent {
+    uint64_t requestId;       /**< The `requestId` of the originating request. */
+    uint32_t generation;      /**< Slot generation of the originating request. */
+    GatewayEventType type;    /**< Event kind. */
+    char orderId[64];         /**< Exchange order ID, if known. */
+    char instrument[64];      /**< Instrument name. */
+    double amount;            /**< Filled amount (fills) or order amount (acks). */
+    double price;             /**< Fill price (fills) or limit price (acks). */
+    char message[128];        /**< Reject reason or order state. */
+};
+
+/**
+ * @struct GatewayClientSlot
+ *
+ * @brief Per-client event ring; `inUse` is claimed with a CAS when a client attaches.
+ *
+ * The attaching client stores its pid, then bumps `generation`. The gateway releases the slot
+ * (`inUse` back to 0) when the pid no longer exists.
+ */
+struct GatewayClientSlot {
+    std::atomic<uint32_t> inUse;
+    std::atomic<uint32_t> generation;
+    std::atomic<int32_t> pid;
+    MpscRing<GatewayEvent, GatewayProtocol::EVENT_RING_SIZE> events;
+};
+
+/**
+ * @struct GatewaySharedRegion
+ *
+ * @brief Layout of the shared memory object, constructed in place by the gateway.
+ */
+struct GatewaySharedRegion {
+    std::atomic<uint32_t> magic;
+    uint32_t version;
+    MpscRing<GatewayRequest, GatewayProtocol::REQUEST_RING_SIZE> requests;
+    GatewayClientSlot clients[GatewayProtocol::MAX_CLIENTS];
+};
+
+#endif // GATEWAY_PROTOCOL_H
@@ -0,0 +1,526 @@
+#include "GatewayServer.h"
+#include "../order_management/OrderSubmissionQueue.h"
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <csignal>
+#include <cstring>
+#include <iostream>
+#include <new>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include <nlohmann/json.hpp>
+#include <fmt/color.h>
+#include <fmt/format.h>
+
+// Define color constants for clarity
+const auto ERROR_COLOR = fmt::fg(fmt::color::red);
+const auto SUCCESS_COLOR = fmt::fg(fmt::color::cyan);
+const auto INFO_COLOR = fmt::fg(fmt::color::blue);
+const auto HIGHLIGHT_COLOR = fmt::fg(fmt::color::yellow);
+
+using json = nlohmann::json;
+
+/**
+ * @file GatewayServer.cpp
+ *
+ * @brief Implements the `GatewayServer` class: shared memory and Unix-domain socket transports,
+ *        request execution and event routing.
+ */
+
+namespace {
+
+/** @brief Reads a numeric field that may be missing or `null`. */
+double numberOr(const json& object, const char* key, double fallback) {
+    auto it = object.find(key);
+    return it != object.end() && it->is_number() ? it->get<double>() : fallback;
+}
+
+GatewayEvent makeEvent(uint64_t requestId, GatewayEventType type) {
+    GatewayEvent event{};
+    event.requestId = requestId;
+    event.type = type;
+    return event;
+}
+
+template <std::size_t N>
+std::string fieldString(const char (&field)[N]) {
+    return std::string(field, strnlen(field, N));
+}
+
+/** @brief How often the serving thread looks for exited shared memory clients. */
+constexpr std::chrono::seconds REAP_INTERVAL(1);
+
+} // namespace
+
+GatewayServer::GatewayServer(OrderSubmissionQueue& submissionQueue)
+    : queue(submissionQueue), strategy(OrderSubmissionQueue::INVALID_STRATEGY), region(nullptr), listenFd(-1),
+      nextTicket(1), running(false), requestCount(0) {}
+
+GatewayServer::~GatewayServer() {
+    stop();
+}
+
+bool GatewayServer::start() {
+    if (running) {
+        return true;
+    }
+
+    if (strategy == OrderSubmissionQueue::INVALID_STRATEGY) {
+        strategy = queue.registerStrategy();
+        if (strategy == OrderSubmissionQueue::INVALID_STRATEGY) {
+            std::cerr << fmt::format(ERROR_COLOR, "Gateway: the submission queue has no free strategy slot\n");
+            return false;
+        }
+    }
+
+    const bool shm = openSharedMemory();
+    const bool socket = openSocket();
+    if (!shm && !socket) {
+        std::cerr << fmt::format(ERROR_COLOR, "Gateway: no transport could be opened\n");
+        return false;
+    }
+
+    running = true;
+    loop = std::thread([this]() { run(); });
+    fmt::print(SUCCESS_COLOR, "Gateway listening (shared memory: {}, socket: {})\n",
+               shm ? GatewayProtocol::SHM_NAME : "unavailable", socket ? GatewayProtocol::SOCKET_PATH : "unavailable");
+    return true;
+}
+
+void GatewayServer::stop() {
+    if (running.exchange(false) && loop.joinable()) {
+        loop.join();
+    }
+
+    std::lock_guard<std::mutex> lock(clientsMutex);
+    for (int fd : socketClients) {
+        ::close(fd);
+    }
+    socketClients.clear();
+    pending.clear();
+    owners.clear();
+    unownedFills.clear();
+
+    if (listenFd >= 0) {
+        ::close(listenFd);
+        ::unlink(GatewayProtocol::SOCKET_PATH);
+        listenFd = -1;
+    }
+
+    if (region) {
+        region->magic.store(0, std::memory_order_release); // Tell attached clients the gateway is gone
+        region->~GatewaySharedRegion();
+        ::munmap(region, sizeof(GatewaySharedRegion));
+        ::shm_unlink(GatewayProtocol::SHM_NAME);
+        region = nullptr;
+    }
+}
+
+/**
+ * @brief Creates the shared memory object and constructs the rings in place.
+ *
+ * The magic number is published last, so clients never attach to a half-initialized region.
+ */
+bool GatewayServer::openSharedMemory() {
+    ::shm_unlink(GatewayProtocol::SHM_NAME); // Remove a region left behind by a crashed gateway
+
+    const int fd = ::shm_open(GatewayProtocol::SHM_NAME, O_CREAT | O_EXCL | O_RDWR, 0600);
+    if (fd < 0) {
+        std::cerr << fmt::format(ERROR_COLOR, "Gateway: shm_open failed: {}\n", std::strerror(errno));
+        return false;
+    }
+
+    if (::ftruncate(fd, sizeof(GatewaySharedRegion)) != 0) {
+        std::cerr << fmt::format(ERROR_COLOR, "Gateway: ftruncate failed: {}\n", std::strerror(errno));
+        ::close(fd);
+        ::shm_unlink(GatewayProtocol::SHM_NAME);
+        return false;
+    }
+
+    void* memory = ::mmap(nullptr, sizeof(GatewaySharedRegion), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (memory == MAP_FAILED) {
+        std::cerr << fmt::format(ERROR_COLOR, "Gateway: mmap failed: {}\n", std::strerror(errno));
+        ::shm_unlink(GatewayProtocol::SHM_NAME);
+        return false;
+    }
+
+    region = new (memory) GatewaySharedRegion();
+    region->version = GatewayProtocol::VERSION;
+    for (auto& client : region->clients) {
+        client.inUse.store(0, std::memory_order_relaxed);
+        client.generation.store(0, std::memory_order_relaxed);
+        client.pid.store(0, std::memory_order_relaxed);
+    }
+    region->magic.store(GatewayProtocol::MAGIC, std::memory_order_release);
+    return true;
+}
+
+bool GatewayServer::openSocket() {
+    const int fd = ::socket(AF_UNIX, SOCK_SEQPACKET | SOCK_NONBLOCK, 0);
+    if (fd < 0) {
+        return false;
+    }
+
+    sockaddr_un address{};
+    address.sun_family = AF_UNIX;
+    std::strncpy(address.sun_path, GatewayProtocol::SOCKET_PATH, sizeof(address.sun_path) - 1);
+    ::unlink(GatewayProtocol::SOCKET_PATH);
+
+    if (::bind(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0 || ::listen(fd, 16) != 0) {
+        std::cerr << fmt::format(ERROR_COLOR, "Gateway: socket setup failed: {}\n", std::strerror(errno));
+        ::close(fd);
+        return false;
+    }
+
+    listenFd = fd;
+    return true;
+}
+
+/**
+ * @brief Busy-polls both transports and the gateway's completion queue.
+ *
+ * Spinning keeps the shared memory round trip free of system calls and wake-up latency; the thread
+ * only yields its time slice when a pass found nothing to do. Exchange round trips run on the
+ * submission queue's I/O thread, so a slow request never holds up the next one's intake.
+ */
+void GatewayServer::run() {
+    GatewayRequest request;
+    auto lastReap = std::chrono::steady_clock::now();
+    while (running) {
+        bool busy = false;
+
+        if (region) {
+            while (region->requests.tryPop(request)) {
+                handle(request, -1);
+                busy = true;
+            }
+        }
+
+        if (listenFd >= 0 && pollSocket()) {
+            busy = true;
+        }
+
+        if (pollCompletions()) {
+            busy = true;
+        }
+
+        if (!busy) {
+            const auto now = std::chrono::steady_clock::now();
+            if (now - lastReap >= REAP_INTERVAL) {
+                reapClients();
+                lastReap = now;
+            }
+            std::this_thread::yield();
+        }
+    }
+}
+
+bool GatewayServer::pollSocket() {
+    bool busy = false;
+
+    const int client = ::accept4(listenFd, nullptr, nullptr, SOCK_NONBLOCK);
+    if (client >= 0) {
+        std::lock_guard<std::mutex> lock(clientsMutex);
+        socketClients.push_back(client);
+        busy = true;
+    }
+
+    std::vector<int> clients;
+    {
+        std::lock_guard<std::mutex> lock(clientsMutex);
+        clients = socketClients;
+    }
+
+    GatewayRequest request;
+    for (int fd : clients) {
+        const ssize_t received = ::recv(fd, &request, sizeof(request), MSG_DONTWAIT);
+        if (received == static_cast<ssize_t>(sizeof(request))) {
+            request.clientId = GatewayProtocol::SOCKET_CLIENT;
+            handle(request, fd);
+            busy = true;
+        } else if (received == 0 || (received < 0 && errno != EAGAIN && errno != EWOULDBLOCK)) {
+            // Client went away: forget it, the orders it owned and its unanswered requests, so a
+            // later client that is given the same descriptor receives none of its events
+            std::lock_guard<std::mutex> lock(clientsMutex);
+            socketClients.erase(std::remove(socketClients.begin(), socketClients.end(), fd), socketClients.end());
+            for (auto it = owners.begin(); it != owners.end();) {
+                it = it->second.socketFd == fd ? owners.erase(it) : std::next(it);
+            }
+            for (auto it = pending.begin(); it != pending.end();) {
+                it = it->second.socketFd == fd ? pending.erase(it) : std::next(it);
+            }
+            ::close(fd);
+        }
+    }
+    return busy;
+}
+
+/**
+ * @brief Checks the requester and enqueues the request under a gateway-wide queue request ID.
+ *
+ * Requests of a shared memory slot's previous generation (left in the ring by a client that has
+ * since detached) are dropped.
+ */
+void GatewayServer::handle(const GatewayRequest& request, int socketFd) {
+    ++requestCount;
+    const Owner owner{request.clientId, request.generation, socketFd, request.requestId, ""};
+
+    if (socketFd < 0 && (request.clientId >= GatewayProtocol::MAX_CLIENTS || !ownerAttached(owner))) {
+        return; // Malformed or stale shared memory request; there is nobody to answer
+    }
+
+    // Each type lands in its priority class of the queue: kill switch and cancels first, then edits, then new orders
+    const uint64_t ticket = nextTicket++;
+    bool queued = false;
+    switch (request.type) {
+    case GatewayRequestType::Buy:
+    case GatewayRequestType::Sell:
+        queued = queue.placeOrder(strategy, ticket, fieldString(request.instrument),
+                                  request.type == GatewayRequestType::Buy ? "buy" : "sell", request.amount, request.price);
+        break;
+    case GatewayRequestType::Edit:
+        queued = queue.modifyOrder(strategy, ticket, fieldString(request.orderId), request.amount, request.price);
+        break;
+    case GatewayRequestType::Cancel:
+        queued = queue.cancelOrder(strategy, ticket, fieldString(request.orderId));
+        break;
+    case GatewayRequestType::CancelAll:
+        queued = queue.cancelAll(strategy, ticket, fieldString(request.instrument));
+        break;
+    }
+
+    if (!queued) {
+        GatewayEvent reject = makeEvent(request.requestId, GatewayEventType::Reject);
+        GatewayProtocol::copyField(reject.message, "Order queue full");
+        std::lock_guard<std::mutex> lock(clientsMutex);
+        deliver(owner, reject);
+        return;
+    }
+    pending.emplace(ticket, owner);
+}
+
+bool GatewayServer::pollCompletions() {
+    bool busy = false;
+    OrderCompletion completion;
+    while (queue.poll(strategy, completion)) {
+        complete(completion);
+        busy = true;
+    }
+    return busy;
+}
+
+/**
+ * @brief Answers with an ack, cancel confirmation or reject. A new order's owner is recorded
+ *        before its ack is sent, then fills that raced ahead of the ack are released. A cancel all
+ *        also tells the owner of every affected gateway order that it was cancelled.
+ */
+void GatewayServer::complete(const OrderCompletion& completion) {
+    auto it = pending.find(completion.requestId);
+    if (it == pending.end()) {
+        return; // The requester disconnected while the request was queued
+    }
+    const Owner owner = it->second;
+    pending.erase(it);
+
+    std::lock_guard<std::mutex> lock(clientsMutex);
+    if (!completion.success) {
+        GatewayEvent reject = makeEvent(owner.requestId, GatewayEventType::Reject);
+        GatewayProtocol::copyField(reject.message, fieldString(completion.message));
+        deliver(owner, reject);
+        return;
+    }
+
+    if (completion.type == OrderIntent::Type::CancelAll) {
+        const std::string instrument = fieldString(completion.instrument);
+        GatewayEvent done = makeEvent(owner.requestId, GatewayEventType::Cancelled);
+        GatewayProtocol::copyField(done.instrument, instrument);
+        GatewayProtocol::copyField(done.message, fieldString(completion.message)); // Number of cancelled orders
+        deliver(owner, done);
+
+        for (auto it = owners.begin(); it != owners.end();) {
+            if (!instrument.empty() && it->second.instrument != instrument) {
+                ++it;
+                continue;
+            }
+            GatewayEvent cancelled = makeEvent(it->second.requestId, GatewayEventType::Cancelled);
+            GatewayProtocol::copyField(cancelled.orderId, it->first);
+            GatewayProtocol::copyField(cancelled.instrument, it->second.instrument);
+            GatewayProtocol::copyField(cancelled.message, "cancelled");
+            deliver(it->second, cancelled);
+            it = owners.erase(it);
+        }
+        return;
+    }
+
+    const bool cancel = completion.type == OrderIntent::Type::Cancel;
+    GatewayEvent ack = makeEvent(owner.requestId, cancel ? GatewayEventType::Cancelled : GatewayEventType::Ack);
+    GatewayProtocol::copyField(ack.orderId, fieldString(completion.orderId));
+    GatewayProtocol::copyField(ack.instrument, fieldString(completion.instrument));
+    GatewayProtocol::copyField(ack.message, fieldString(completion.orderState));
+    ack.amount = completion.amount;
+    ack.price = completion.price;
+
+    const std::string orderId = fieldString(completion.orderId);
+    if (cancel) {
+        owners.erase(orderId);
+        deliver(owner, ack);
+        return;
+    }
+
+    if (!deliver(owner, ack) || orderId.empty() || completion.type == OrderIntent::Type::Edit) {
+        return; // An edited order keeps the owner that placed it
+    }
+    Owner& placed = owners[orderId];
+    placed = owner;
+    placed.instrument = fieldString(completion.instrument);
+
+    for (auto fill = unownedFills.begin(); fill != unownedFills.end();) {
+        if (fill->orderId != orderId) {
+            ++fill;
+            continue;
+        }
+        const UnownedFill held = *fill;
+        fill = unownedFills.erase(fill);
+        deliverFillLocked(held.orderId, held.tradeId, held.event);
+    }
+}
+
+/**
+ * @brief Releases slots whose owning process no longer exists, then drops the orders of every
+ *        shared memory owner that is no longer attached (crashed or detached).
+ */
+void GatewayServer::reapClients() {
+    if (!region) {
+        return;
+    }
+
+    for (uint32_t i = 0; i < GatewayProtocol::MAX_CLIENTS; ++i) {
+        GatewayClientSlot& slot = region->clients[i];
+        const int32_t pid = slot.pid.load(std::memory_order_acquire);
+        if (slot.inUse.load(std::memory_order_acquire) == 0 || pid <= 0) {
+            continue; // Free, or claimed by a client that has not published its pid yet
+        }
+        if (::kill(pid, 0) != 0 && errno == ESRCH) {
+            fmt::print(INFO_COLOR, "Gateway: client {} (pid {}) exited without detaching, slot released\n", i, pid);
+            slot.pid.store(0, std::memory_order_relaxed);
+            slot.inUse.store(0, std::memory_order_release);
+        }
+    }
+
+    std::lock_guard<std::mutex> lock(clientsMutex);
+    for (auto it = owners.begin(); it != owners.end();) {
+        it = it->second.socketFd < 0 && !ownerAttached(it->second) ? owners.erase(it) : std::next(it);
+    }
+}
+
+bool GatewayServer::ownerAttached(const Owner& owner) const {
+    if (owner.socketFd >= 0) {
+        return true;
+    }
+    if (!region || owner.clientId >= GatewayProtocol::MAX_CLIENTS) {
+        return false;
+    }
+    const GatewayClientSlot& slot = region->clients[owner.clientId];
+    return slot.inUse.load(std::memory_order_acquire) != 0 && slot.generation.load(std::memory_order_acquire) == owner.generation;
+}
+
+void GatewayServer::onTrades(const json& trades) {
+    std::lock_guard<std::mutex> lock(clientsMutex);
+    deliverTradesLocked(trades);
+}
+
+void GatewayServer::deliverTradesLocked(const json& trades) {
+    if (!trades.is_array()) {
+        return;
+    }
+
+    for (const auto& trade : trades) {
+        const std::string tradeId = trade.value("trade_id", "");
+        if (deliveredTrades.count(tradeId) != 0) {
+            continue;
+        }
+
+        const std::string orderId = trade.value("order_id", "");
+        GatewayEvent fill = makeEvent(0, GatewayEventType::Fill);
+        GatewayProtocol::copyField(fill.orderId, orderId);
+        GatewayProtocol::copyField(fill.instrument, trade.value("instrument_name", ""));
+        GatewayProtocol::copyField(fill.message, trade.value("state", ""));
+        fill.amount = numberOr(trade, "amount", 0.0);
+        fill.price = numberOr(trade, "price", 0.0);
+
+        if (owners.count(orderId) != 0) {
+            deliverFillLocked(orderId, tradeId, fill);
+            continue;
+        }
+
+        // Possibly a gateway order whose ack is still queued; keep it briefly
+        if (std::none_of(unownedFills.begin(), unownedFills.end(), [&tradeId](const UnownedFill& held) { return held.tradeId == tradeId; })) {
+            unownedFills.push_back(UnownedFill{orderId, tradeId, fill});
+            if (unownedFills.size() > MAX_UNOWNED_FILLS) {
+                unownedFills.pop_front();
+            }
+        }
+    }
+}
+
+void GatewayServer::deliverFillLocked(const std::string& orderId, const std::string& tradeId, GatewayEvent fill) {
+    auto owner = owners.find(orderId);
+    if (owner == owners.end()) {
+        return;
+    }
+
+    fill.requestId = owner->second.requestId;
+    const bool delivered = deliver(owner->second, fill);
+    rememberTradeLocked(tradeId);
+    if (!delivered || std::strcmp(fill.message, "filled") == 0) {
+        owners.erase(owner); // Client gone, or no further trades can follow
+    }
+}
+
+void GatewayServer::rememberTradeLocked(const std::string& tradeId) {
+    if (!deliveredTrades.insert(tradeId).second) {
+        return;
+    }
+    deliveredOrder.push_back(tradeId);
+    if (deliveredOrder.size() > MAX_TRACKED_TRADES) {
+        deliveredTrades.erase(deliveredOrder.front());
+        deliveredOrder.pop_front();
+    }
+}
+
+/**
+ * @brief Shared memory events are stamped with the owner's slot generation and only pushed while
+ *        that generation is still attached.
+ */
+bool GatewayServer::deliver(const Owner& owner, GatewayEvent event) {
+    if (owner.socketFd >= 0) {
+        const ssize_t sent = ::send(owner.socketFd, &event, sizeof(event), MSG_DONTWAIT | MSG_NOSIGNAL);
+        return sent >= 0 || errno == EAGAIN || errno == EWOULDBLOCK; // A full buffer drops the event, not the client
+    }
+
+    if (!ownerAttached(owner)) {
+        return false;
+    }
+    event.generation = owner.generation;
+    if (!region->clients[owner.clientId].events.tryPush(event)) {
+        std::cerr << fmt::format(ERROR_COLOR, "Gateway: event ring of client {} is full, event dropped\n", owner.clientId);
+    }
+    return true;
+}
+
+bool GatewayServer::sharedMemoryActive() const {
+    return region != nullptr;
+}
+
+bool GatewayServer::socketActive() const {
+    return listenFd >= 0;
+}
+
+uint64_t GatewayServer::processed() const {
+    return requestCount.load(std::memory_order_relaxed);
+}
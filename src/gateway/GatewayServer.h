@@ -0,0 +1,186 @@
+#ifndef GATEWAY_SERVER_H
+#define GATEWAY_SERVER_H
+
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+#include <nlohmann/json_fwd.hpp>
+#include "GatewayProtocol.h"
+
+class OrderSubmissionQueue;
+struct OrderCompletion;
+
+/**
+ * @file GatewayServer.h
+ *
+ * @brief Defines the `GatewayServer` class, which lets local processes trade through this
+ *        process's exchange session.
+ *
+ * In gateway mode (`GoQuant --gateway`), this process owns the authenticated session, so rate
+ * limiting and connections are centralized. External strategy processes attach with
+ * `GatewayClient` and exchange fixed-size messages:
+ * - over a POSIX shared memory region holding a lock-free MPSC request ring and one event ring per
+ *   client (the fast path; no system calls per message), or
+ * - over a `SOCK_SEQPACKET` Unix-domain socket when shared memory cannot be used.
+ *
+ * ### Key Responsibilities:
+ * - Create and own the shared memory region and the listening socket.
+ * - Hand order requests to an `OrderSubmissionQueue`, whose I/O thread charges the rate limiter and
+ *   runs the HTTP or FIX round trip, so the serving thread never blocks on the exchange.
+ * - Turn completions into acks and rejects, and route fills (`user.trades` notifications) back to
+ *   the client that placed the order.
+ * - Free the slots of shared memory clients whose process has exited, and never deliver an event
+ *   to a later client of the same slot (see the slot generation in `GatewayProtocol.h`).
+ */
+
+/**
+ * @class GatewayServer
+ *
+ * @brief Serves order requests from local clients.
+ *
+ * ### Example:
+ * ```
+ * OrderManager orderManager(token);
+ * RateLimiter limiter(RateLimiter::Config{});
+ * OrderSubmissionQueue queue(orderManager, &limiter);
+ * queue.start();
+ * GatewayServer gateway(queue);
+ * if (gateway.start()) {
+ *     // ... feed user.trades notifications: gateway.onTrades(params["data"]);
+ *     gateway.stop();
+ * }
+ * ```
+ */
+class GatewayServer {
+public:
+    /**
+     * @brief Constructs a stopped gateway.
+     *
+     * @param queue The started submission queue that executes requests; it must outlive the gateway.
+     */
+    explicit GatewayServer(OrderSubmissionQueue& queue);
+
+    /** @brief Stops the gateway and releases its resources. */
+    ~GatewayServer();
+
+    GatewayServer(const GatewayServer&) = delete;
+    GatewayServer& operator=(const GatewayServer&) = delete;
+
+    /**
+     * @brief Opens the transports and starts the serving thread.
+     *
+     * @return False if the queue has no free strategy slot or neither shared memory nor the socket
+     *         could be opened.
+     */
+    bool start();
+
+    /** @brief Stops the serving thread, closes the socket and removes the shared memory object. */
+    void stop();
+
+    /**
+     * @brief Forwards trades of gateway orders to their clients as fills.
+     *
+     * @param trades The `data` array of a `user.trades.*` notification.
+     *
+     * Safe to call from another thread. Trades already delivered (by `trade_id`, over a bounded
+     * window of recent trades) are skipped. A trade of an order whose ack has not been processed
+     * yet is held back (boundedly) and delivered right after the ack.
+     */
+    void onTrades(const nlohmann::json& trades);
+
+    /** @brief Returns true if clients can attach over shared memory. */
+    bool sharedMemoryActive() const;
+
+    /** @brief Returns true if clients can connect over the Unix-domain socket. */
+    bool socketActive() const;
+
+    /** @brief Returns the number of requests processed since `start`. */
+    uint64_t processed() const;
+
+private:
+    /** @brief Number of recent trade IDs remembered to skip duplicates. */
+    static constexpr std::size_t MAX_TRACKED_TRADES = 4096;
+
+    /** @brief Number of fills held back while waiting for their order's ack. */
+    static constexpr std::size_t MAX_UNOWNED_FILLS = 256;
+
+    /** @brief Who placed an order: a shared memory slot (and its generation) or a socket descriptor. */
+    struct Owner {
+        uint32_t clientId;
+        uint32_t generation;
+        int socketFd;
+        uint64_t requestId;
+        std::string instrument; /**< Instrument of the owned order (kept for instrument-wide cancels). */
+    };
+
+    /** @brief A fill whose order has no known owner yet. */
+    struct UnownedFill {
+        std::string orderId;
+        std::string tradeId;
+        GatewayEvent event;
+    };
+
+    bool openSharedMemory();
+    bool openSocket();
+
+    /** @brief Serving loop: drains the request ring, services the socket and forwards completions. */
+    void run();
+
+    /** @brief Accepts connections and reads pending socket requests; returns true if any work was done. */
+    bool pollSocket();
+
+    /** @brief Validates one request and hands it to the submission queue. */
+    void handle(const GatewayRequest& request, int socketFd);
+
+    /** @brief Forwards queue completions as acks and rejects; returns true if any work was done. */
+    bool pollCompletions();
+
+    /** @brief Emits the events of one completion. */
+    void complete(const OrderCompletion& completion);
+
+    /** @brief Frees slots of exited client processes and forgets orders of departed clients. */
+    void reapClients();
+
+    /** @brief Returns true if the owner's shared memory slot still belongs to the same client. */
+    bool ownerAttached(const Owner& owner) const;
+
+    /** @brief Sends one event to a client over the transport it used; false if the client is gone. */
+    bool deliver(const Owner& owner, GatewayEvent event);
+
+    /** @brief Emits fills for trades of an owned order; the caller must hold `clientsMutex`. */
+    void deliverTradesLocked(const nlohmann::json& trades);
+
+    /** @brief Delivers one fill and forgets the order once it is filled; the caller must hold `clientsMutex`. */
+    void deliverFillLocked(const std::string& orderId, const std::string& tradeId, GatewayEvent fill);
+
+    /** @brief Remembers a delivered trade ID, evicting the oldest beyond `MAX_TRACKED_TRADES`. */
+    void rememberTradeLocked(const std::string& tradeId);
+
+    OrderSubmissionQueue& queue;
+    uint32_t strategy;                             /**< Completion queue of the gateway. */
+
+    GatewaySharedRegion* region;                   /**< Mapped shared memory, or nullptr. */
+    int listenFd;                                  /**< Listening socket, or -1. */
+    std::vector<int> socketClients;                /**< Connected socket clients. */
+
+    std::unordered_map<uint64_t, Owner> pending;   /**< Queue request ID -> requester (serving thread only). */
+    uint64_t nextTicket;                           /**< Queue request ID of the next request (serving thread only). */
+
+    std::mutex clientsMutex;                       /**< Guards socket clients, owners and trades. */
+    std::unordered_map<std::string, Owner> owners; /**< Order ID -> client that placed it. */
+    std::unordered_set<std::string> deliveredTrades; /**< Recently forwarded trade IDs. */
+    std::deque<std::string> deliveredOrder;        /**< `deliveredTrades` in delivery order, for eviction. */
+    std::deque<UnownedFill> unownedFills;          /**< Fills that arrived before their order's ack. */
+
+    std::atomic<bool> running;
+    std::atomic<uint64_t> requestCount;
+    std::thread loop;
+};
+
+#endif // GATEWAY_SERVER_H
@@ -4,12 +4,37 @@
 #include <atomic>
 #include <chrono>
 #include <limits>
+#include <memory>
+#include <algorithm>
+#include <unordered_map>
+#include <fstream>
+#include <functional>
+#include <utility>
 
 #include "auth/AuthManager.h"                  // Handles authentication
+#include "auth/SessionManager.h"               // Runs several accounts/subaccounts in one process
+#include "auth/RateLimiter.h"                  // Token bucket charged before every order request
 #include "order_management/OrderManager.h"     // Manages orders
+#include "order_management/OrderStore.h"       // Local store of our orders
+#include "order_management/OrderSubmissionQueue.h" // Prioritized order entry shared by menu and gateway
+#include "order_management/MassQuoteManager.h" // Mass quotes over the authorized WebSocket
 #include "account_management/AccountManager.h" // Retrieves account data
 #include "market_data/MarketDataManager.h"     // Fetches market data
+#include "market_data/OrderBook.h"             // Local order book built from book notifications
+#include "market_data/MicrostructureSignals.h" // Incremental order book signals
+#include "market_data/SubscriptionManager.h"   // Group subscriptions expanded from instrument metadata
+#include "market_data/BookChannelSelector.h"   // Per-instrument book interval (100ms/agg2/raw/adaptive)
+#include "market_data/GroupedBook.h"           // Fixed-depth snapshot books from grouped channels
+#include "market_data/MarkPriceTable.h"        // Bulk markprice.options decoding into per-instrument arrays
+#include "market_data/TopOfBookCache.h"        // Diffing top-of-book cache from bulk book summaries
+#include "market_data/FundingTracker.h"        // Perpetual funding and dated future basis from tickers
+#include "market_data/OptionChain.h"           // Option chain by underlying, expiry, strike and type
+#include "gateway/GatewayServer.h"            // Local order gateway for external strategy processes
+#include "fix/FixSession.h"                    // FIX 4.4 session layer
+#include "fix/FixOrderManager.h"               // Order entry over FIX
 #include "WebSocketClient.h"                   // Implements WebSocket communication
+#include "FrameRouter.h"                       // Perfect-hash dispatch of methods and channels
+#include "InflightRequests.h"                  // Request IDs, reply matching and timeouts per connection
 #include <nlohmann/json.hpp>                   // JSON parsing and serialization
 
 #include <fmt/color.h>
@@ -68,6 +93,55 @@ std::string beautifyJson(const std::string &jsonString)
     }
 }
 
+/**
+ * Waits for the completion of one request submitted to the order submission queue.
+ * Completions of earlier requests that timed out are skipped.
+ * Returns false if no completion arrives within the timeout.
+ */
+bool awaitCompletion(OrderSubmissionQueue &queue, uint32_t strategy, uint64_t requestId, OrderCompletion &completion)
+{
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+    while (std::chrono::steady_clock::now() < deadline)
+    {
+        if (!queue.poll(strategy, completion))
+            std::this_thread::sleep_for(std::chrono::microseconds(100));
+        else if (completion.requestId == requestId)
+            return true;
+    }
+    return false;
+}
+
+/**
+ * Prints the outcome of an order request executed by the order submission queue.
+ */
+void printCompletion(const std::string &title, const OrderCompletion &completion)
+{
+    if (!completion.success)
+        std::cerr << fmt::format(ERROR_COLOR, "{} Failed: {}\n", title, completion.message);
+    else if (completion.type == OrderIntent::Type::CancelAll)
+        fmt::print(SUCCESS_COLOR, "{} Response: {} orders cancelled\n", title, completion.message);
+    else
+        fmt::print(SUCCESS_COLOR, "{} Response: order {} ({}) {} {} @ {}, filled {}\n", title, completion.orderId,
+                   completion.instrument, completion.orderState, completion.amount, completion.price, completion.filledAmount);
+    fmt::print(INFO_COLOR, "Queue Delay: {} us\n", completion.queueDelayNs / 1000);
+}
+
+/**
+ * Prints the queueing delay of every priority class of the order submission queue.
+ */
+void printQueueMetrics(const OrderSubmissionQueue &queue)
+{
+    const std::pair<OrderPriority, const char *> classes[] = {
+        {OrderPriority::Cancel, "cancel"}, {OrderPriority::Edit, "edit"}, {OrderPriority::New, "new"}, {OrderPriority::Query, "query"}};
+    for (const auto &entry : classes)
+    {
+        const QueueDelayMetrics metrics = queue.metrics(entry.first);
+        fmt::print(INFO_COLOR, "Order queue {}: {} sent, {} rejected, avg delay {:.1f} us, max {} us\n", entry.second,
+                   metrics.sent, metrics.rejected, metrics.averageDelayUs(), metrics.maxDelayNs / 1000);
+    }
+    fmt::print(INFO_COLOR, "Order queue conflated edits: {}\n", queue.conflatedEdits());
+}
+
 /**
  * Displays the main menu for the Deribit Trading Management System.
  * Lists all available operations for user interaction.
@@ -87,18 +161,74 @@ void displayMenu()
     fmt::print(fmt::fg(fmt::color::green), "Enter your choice: ");
 }
 
-int main()
+int main(int argc, char *argv[])
 {
     /*
      * Step 1: Authenticate with Deribit API.
      * The system begins by requesting `client_id` and `client_secret` from the user.
      * These credentials are used to authenticate with the Deribit API and retrieve an access token.
+     *
+     * With `--accounts <file>`, the credentials of several accounts/subaccounts are read from a JSON
+     * array instead ([{"account_id", "client_id", "client_secret", "currencies", "connections"}, ...]).
+     * Every account gets its own session; the first one also drives the menu below. `"connections": N`
+     * opens N - 1 redundant connections for the account (listed as `{account_id}#2` ...), and its
+     * orders go over whichever connection currently has the lowest round trip.
+     *
+     * With `--gateway`, the menu is replaced by the local order gateway (see Step 3a).
+     *
+     * With `--mass-quote <file>`, the quote set in the file ({"quote_set_id", "mmp_group", "quotes"})
+     * is sent as one mass quote instead (see Step 3b).
+     *
+     * With `--fix <host:port>`, orders (menu options 1-3 and the gateway) go over a FIX 4.4 session
+     * logged on with the same credentials instead of HTTP (see Step 2).
      */
+    SessionManager sessionManager(WebSocketClient::Config{"test.deribit.com", "443", "/ws/api/v2"});
     std::string clientId, clientSecret;
-    std::cout << fmt::format(INFO_COLOR, "Enter your Deribit client_id: ");
-    std::getline(std::cin, clientId);
-    std::cout << fmt::format(INFO_COLOR, "Enter your Deribit client_secret: ");
-    std::getline(std::cin, clientSecret);
+    std::string accountsPath;
+    std::string massQuotePath;
+    std::string fixEndpoint;
+    std::string primaryAccountId;
+    bool gatewayMode = false;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        std::string argument = argv[i];
+        if (argument == "--gateway")
+            gatewayMode = true;
+        else if (argument == "--accounts" && i + 1 < argc)
+            accountsPath = argv[++i];
+        else if (argument == "--mass-quote" && i + 1 < argc)
+            massQuotePath = argv[++i];
+        else if (argument == "--fix" && i + 1 < argc)
+            fixEndpoint = argv[++i];
+    }
+
+    if (!accountsPath.empty())
+    {
+        std::ifstream accountsFile(accountsPath);
+        json accounts = json::parse(accountsFile, nullptr, false);
+        std::vector<SessionConfig> configs = SessionManager::parseConfigs(accounts);
+        if (configs.empty())
+        {
+            std::cerr << fmt::format(ERROR_COLOR, "No valid accounts found in {}\n", accountsPath);
+            return 1;
+        }
+
+        for (const auto &config : configs)
+            sessionManager.addSession(config);
+        sessionManager.start();
+
+        clientId = configs.front().clientId;
+        clientSecret = configs.front().clientSecret;
+        primaryAccountId = configs.front().accountId;
+    }
+    else
+    {
+        std::cout << fmt::format(INFO_COLOR, "Enter your Deribit client_id: ");
+        std::getline(std::cin, clientId);
+        std::cout << fmt::format(INFO_COLOR, "Enter your Deribit client_secret: ");
+        std::getline(std::cin, clientSecret);
+    }
 
     AuthManager authManager(clientId, clientSecret);
     std::string token = authManager.authenticate();
@@ -117,10 +247,70 @@ int main()
      * - OrderManager: Handles order placement, modification, and cancellation.
      * - AccountManager: Retrieves account summaries and open positions.
      * - MarketDataManager: Fetches order book and market data.
+     * - OrderStore: Local copy of our orders, filled by currency-wide order fetches.
+     * - FixOrderManager: With `--fix`, order entry over a FIX session instead of HTTP (`orderEntry`).
+     * - OrderSubmissionQueue: The one order path of the menu (options 1-3) and the gateway; each
+     *   registers its own strategy, and cancels are sent ahead of queued edits and new orders.
      */
     OrderManager orderManager(token);
     AccountManager accountManager(token);
     MarketDataManager marketDataManager;
+    OrderStore orderStore;
+
+    std::unique_ptr<FixSession> fixSession;
+    std::unique_ptr<FixOrderManager> fixOrderManager;
+    if (!fixEndpoint.empty())
+    {
+        FixSessionConfig fixConfig;
+        const std::size_t colon = fixEndpoint.rfind(':');
+        fixConfig.host = fixEndpoint.substr(0, colon);
+        if (colon != std::string::npos)
+            fixConfig.port = fixEndpoint.substr(colon + 1);
+        fixConfig.senderCompId = "GOQUANT-" + clientId;
+        fixConfig.clientId = clientId;
+        fixConfig.clientSecret = clientSecret;
+
+        fixSession = std::make_unique<FixSession>(fixConfig);
+        fixOrderManager = std::make_unique<FixOrderManager>(*fixSession);
+        fixSession->setMessageHandler([&fixOrderManager](const FixMessage &message)
+                                      { fixOrderManager->onMessage(message); });
+        if (!fixSession->logon())
+            return 1;
+    }
+    OrderEntry &orderEntry = fixOrderManager ? static_cast<OrderEntry &>(*fixOrderManager) : orderManager;
+
+    /*
+     * Every order request leaves through one queue: one I/O thread, cancels first, rate limited.
+     * With --accounts the menu trades as the first account, so the queue charges that account's
+     * bucket rather than a second one that would double its effective order rate.
+     */
+    RateLimiter orderLimiter(RateLimiter::Config{});
+    RateLimiter *queueLimiter = &orderLimiter;
+    if (Session *primary = primaryAccountId.empty() ? nullptr : sessionManager.session(primaryAccountId))
+        queueLimiter = primary->limiter.get();
+    OrderSubmissionQueue orderQueue(orderEntry, queueLimiter);
+    orderQueue.start();
+
+    // Startup reconciliation: one open-order request per currency, then the order history, pages in parallel
+    std::size_t reconciled = orderManager.reconcileOpenOrders({"BTC", "ETH"}, orderStore);
+    fmt::print(INFO_COLOR, "Reconciled {} open orders\n", reconciled);
+    std::size_t historical = 0;
+    if (orderManager.fetchOrderHistory({"BTC", "ETH"}, orderStore, historical))
+        fmt::print(INFO_COLOR, "Loaded {} orders from the order history\n", historical);
+    else
+        std::cerr << fmt::format(ERROR_COLOR, "Order history is incomplete ({} orders loaded)\n", historical);
+
+    /*
+     * Top-of-book cache filled from bulk book summaries (menu option 7 with CURRENCY:KIND).
+     * Only instruments whose prices changed since the previous snapshot are printed.
+     */
+    TopOfBookCache topOfBook;
+    topOfBook.setChangeHandler([](const std::vector<const TopOfBook *> &changed)
+                               {
+                                   for (const auto *entry : changed)
+                                       fmt::print(INFO_COLOR, "{}: {} / {} (mark {})\n",
+                                                  entry->instrument, entry->bidPrice, entry->askPrice, entry->markPrice);
+                               });
 
     /*
      * Step 3: Prepare for Real-Time Data Streaming.
@@ -128,11 +318,180 @@ int main()
      */
     std::atomic<bool> keepRunning(true);
 
+    /*
+     * Step 3a: Gateway Mode.
+     * Local strategy processes trade through this process over shared memory (or a Unix-domain
+     * socket fallback) using `GatewayClient`. Fills are forwarded from an authorized
+     * `user.trades` stream, and `user.orders` execution reports keep the order store current.
+     * Runs until Enter is pressed.
+     */
+    if (gatewayMode)
+    {
+        GatewayServer gateway(orderQueue);
+        if (!gateway.start())
+            return 1;
+
+        // Every request on the trades connection takes its ID from one ring, which matches the replies
+        WebSocketClient tradesClient(WebSocketClient::Config{"test.deribit.com", "443", "/ws/api/v2"});
+        InflightRequests tradesRequests;
+        std::atomic<bool> tradesAuthorized(false);
+        tradesClient.connect();
+        tradesClient.send(authManager.buildWebSocketAuthRequest(tradesRequests.allocate(RpcMethod::PublicAuth, [&tradesAuthorized](const json *response)
+                                                                                        {
+                                                                                            tradesAuthorized = response && response->contains("result");
+                                                                                            if (!tradesAuthorized)
+                                                                                                std::cerr << fmt::format(ERROR_COLOR, "WebSocket authorization failed, no fills will be forwarded\n"); })));
+
+        std::thread tradesThread([&tradesClient, &tradesRequests, &tradesAuthorized, &keepRunning, &gateway, &orderStore]()
+                                 {
+                                     bool subscribed = false;
+                                     while (keepRunning)
+                                     {
+                                         bool testRequest = false;
+                                         tradesClient.receive([&gateway, &orderStore, &tradesRequests, &testRequest](const std::string &message)
+                                                              {
+                                                                  auto notification = json::parse(message, nullptr, false);
+                                                                  if (notification.is_discarded() || tradesRequests.complete(notification))
+                                                                      return;
+                                                                  if (notification.value("method", "") == "heartbeat")
+                                                                      testRequest = testRequest || notification["params"].value("type", "") == "test_request";
+                                                                  else if (notification.value("method", "") == "subscription")
+                                                                  {
+                                                                      const json &params = notification["params"];
+                                                                      if (FrameRouter::channelKindOf(params.value("channel", "")) == ChannelKind::UserOrders)
+                                                                          orderStore.onUserOrders(params["data"]);
+                                                                      else
+                                                                          gateway.onTrades(params["data"]);
+                                                                  }
+                                                              });
+                                         tradesRequests.expire();
+
+                                         // Subscribe (outside the receive callback) once the connection is authorized;
+                                         // heartbeats keep this loop waking up so it can notice shutdown
+                                         std::vector<std::string> requests;
+                                         if (tradesAuthorized && !subscribed)
+                                         {
+                                             requests.push_back(tradesRequests.request(RpcMethod::PrivateSubscribe,
+                                                                                       {{"channels", {"user.trades.any.any.raw", "user.orders.any.any.raw"}}}));
+                                             requests.push_back(tradesRequests.request(RpcMethod::PublicSetHeartbeat, {{"interval", 10}}));
+                                             subscribed = true;
+                                         }
+                                         else if (testRequest)
+                                         {
+                                             requests.push_back(tradesRequests.request(RpcMethod::PublicTest, json::object()));
+                                         }
+                                         for (const auto &request : requests)
+                                             if (!request.empty())
+                                                 tradesClient.send(request);
+                                     } });
+
+        std::cout << fmt::format(INFO_COLOR, "Gateway running. Press Enter to stop...\n");
+        std::cin.get();
+        keepRunning = false;
+        gateway.stop();
+        fmt::print(INFO_COLOR, "Gateway processed {} requests\n", gateway.processed());
+        printQueueMetrics(orderQueue);
+        tradesThread.join();
+        tradesClient.disconnect();
+        return 0;
+    }
+
+    /*
+     * Step 3b: Mass Quote Mode.
+     * The whole quote set is sent as a single `private/mass_quote` message over an authorized
+     * WebSocket. Pressing Enter pulls the set with one `private/cancel_quotes` message and exits.
+     */
+    if (!massQuotePath.empty())
+    {
+        std::ifstream quoteFile(massQuotePath);
+        json quoteConfig = json::parse(quoteFile, nullptr, false);
+        std::vector<Quote> quotes = quoteConfig.is_object() ? MassQuoteManager::parseQuotes(quoteConfig["quotes"]) : std::vector<Quote>{};
+        if (quotes.empty())
+        {
+            std::cerr << fmt::format(ERROR_COLOR, "No valid quotes found in {}\n", massQuotePath);
+            return 1;
+        }
+        const std::string quoteSetId = quoteConfig.value("quote_set_id", "default");
+
+        WebSocketClient quoteClient(WebSocketClient::Config{"test.deribit.com", "443", "/ws/api/v2"});
+        quoteClient.connect();
+        InflightRequests quoteRequests;
+        MassQuoteManager quoter(quoteClient, quoteRequests, quoteConfig.value("mmp_group", "default"));
+
+        // The client holds its lock during a blocking read, so this thread both sends and receives:
+        // every request is followed by reads until `done` accepts its response
+        auto receiveUntil = [&quoteClient](const std::function<bool(const json &)> &done)
+        {
+            bool finished = false;
+            while (!finished)
+                quoteClient.receive([&done, &finished](const std::string &message)
+                                    {
+                                        auto response = json::parse(message, nullptr, false);
+                                        if (!response.is_discarded() && done(response))
+                                            finished = true; });
+        };
+
+        bool authorized = false;
+        bool authAnswered = false;
+        quoteClient.send(authManager.buildWebSocketAuthRequest(quoteRequests.allocate(RpcMethod::PublicAuth, [&authorized, &authAnswered](const json *response)
+                                                                                      {
+                                                                                          authorized = response && response->contains("result");
+                                                                                          authAnswered = true; })));
+        receiveUntil([&quoter, &authAnswered](const json &response)
+                     {
+                         quoter.onMessage(response);
+                         quoter.expireRequests();
+                         return authAnswered; });
+        if (!authorized)
+        {
+            std::cerr << fmt::format(ERROR_COLOR, "WebSocket authorization failed\n");
+            quoteClient.disconnect();
+            return 1;
+        }
+
+        auto start = std::chrono::high_resolution_clock::now();
+        std::string quoteId = quoter.quote(quoteSetId, quotes);
+        QuoteSet record;
+        bool live = false;
+        if (!quoteId.empty())
+        {
+            // Replies are matched by request ID; an unanswered request expires on the next frame after its timeout
+            receiveUntil([&quoter](const json &response)
+                         { return quoter.onMessage(response) || quoter.expireRequests() > 0; });
+            // A rejected quote set has been reported by the manager and is no longer tracked
+            live = quoter.find(quoteId, record);
+        }
+        auto end = std::chrono::high_resolution_clock::now();
+
+        if (live)
+            fmt::print(SUCCESS_COLOR, "Mass quote {} ({} instruments): {} rejected legs{}\n", quoteId, quotes.size(), record.errors,
+                       record.message.empty() ? "" : " - " + record.message);
+        else
+            std::cerr << fmt::format(ERROR_COLOR, "Mass quote of set {} is not live\n", quoteSetId);
+        fmt::print(INFO_COLOR, "Mass Quote Latency: {} ms\n",
+                   std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count());
+        fmt::print(INFO_COLOR, "private/mass_quote Round Trip: {} us\n", quoter.rtt(RpcMethod::MassQuote).lastMicros);
+
+        std::cout << fmt::format(INFO_COLOR, "Quoting. Press Enter to cancel the quote set and exit...\n");
+        std::cin.get();
+        if (quoter.cancelQuotes(quoteSetId))
+            receiveUntil([&quoter](const json &response)
+                         { return quoter.onMessage(response) || quoter.expireRequests() > 0; });
+
+        quoteClient.disconnect();
+        return 0;
+    }
+
     /*
      * Step 4: Main Menu Loop.
      * Displays a menu of options for user interaction.
      * The loop continues until the user selects the exit option.
      */
+    // Menu order requests share the submission queue (and its priorities) with every other order path
+    const uint32_t menuStrategy = orderQueue.registerStrategy();
+    uint64_t menuRequestId = 0;
+    OrderCompletion completion;
+
     int choice;
     while (true)
     {
@@ -145,6 +504,7 @@ int main()
 
         if (choice == 9) // Exit the program
         {
+            printQueueMetrics(orderQueue);
             std::cout << fmt::format(HIGHLIGHT_COLOR, "Exiting the system. Goodbye!\n");
             break;
         }
@@ -170,12 +530,29 @@ int main()
             std::cin >> price;
             std::cin.ignore();
 
+            // With several sessions, route the order to the chosen account
+            std::string accountId;
+            if (sessionManager.size() > 0)
+            {
+                std::cout << fmt::format(HIGHLIGHT_COLOR, "Enter account ID (empty for the menu account): ");
+                std::getline(std::cin, accountId);
+            }
+
             auto start = std::chrono::high_resolution_clock::now();
-            std::string response = orderManager.placeOrder(instrument, side, amount, price);
+            if (!accountId.empty())
+            {
+                std::string response = sessionManager.placeOrder(accountId, instrument, side, amount, price);
+                std::cout << fmt::format(SUCCESS_COLOR, "Order Placement Response:\n")
+                          << beautifyJson(response) << "\n";
+            }
+            else if (!orderQueue.placeOrder(menuStrategy, ++menuRequestId, instrument, side, amount, price))
+                std::cerr << fmt::format(ERROR_COLOR, "Order queue is full, order not placed\n");
+            else if (!awaitCompletion(orderQueue, menuStrategy, menuRequestId, completion))
+                std::cerr << fmt::format(ERROR_COLOR, "No answer to the order within 10 seconds\n");
+            else
+                printCompletion("Order Placement", completion);
             auto end = std::chrono::high_resolution_clock::now();
 
-            std::cout << fmt::format(SUCCESS_COLOR, "Order Placement Response:\n")
-                      << beautifyJson(response) << "\n";
             fmt::print(INFO_COLOR, "Order Placement Latency: {} ms\n",
                        std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count());
             break;
@@ -198,11 +575,14 @@ int main()
             std::cin.ignore();
 
             auto start = std::chrono::high_resolution_clock::now();
-            std::string response = orderManager.modifyOrder(orderId, newAmount, newPrice);
+            if (!orderQueue.modifyOrder(menuStrategy, ++menuRequestId, orderId, newAmount, newPrice))
+                std::cerr << fmt::format(ERROR_COLOR, "Order queue is full, order not modified\n");
+            else if (!awaitCompletion(orderQueue, menuStrategy, menuRequestId, completion))
+                std::cerr << fmt::format(ERROR_COLOR, "No answer to the edit within 10 seconds\n");
+            else
+                printCompletion("Modify Order", completion);
             auto end = std::chrono::high_resolution_clock::now();
 
-            std::cout << fmt::format(SUCCESS_COLOR, "Modify Order Response:\n")
-                      << beautifyJson(response) << "\n";
             fmt::print(INFO_COLOR, "Modify Order Latency: {} ms\n",
                        std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count());
             break;
@@ -212,18 +592,26 @@ int main()
         {
             /*
              * Allows the user to cancel an active order.
-             * The user provides the order ID of the order they wish to cancel.
+             * The user provides the order ID of the order they wish to cancel, or ALL (optionally
+             * ALL:INSTRUMENT) for the kill switch, which is sent ahead of any queued order.
              */
             std::string orderId;
-            std::cout << fmt::format(HIGHLIGHT_COLOR, "Enter order ID to cancel: ");
+            std::cout << fmt::format(HIGHLIGHT_COLOR, "Enter order ID to cancel (ALL or ALL:INSTRUMENT for the kill switch): ");
             std::getline(std::cin, orderId);
 
+            const bool killSwitch = orderId.compare(0, 3, "ALL") == 0;
+            const std::string killInstrument = orderId.size() > 4 ? orderId.substr(4) : "";
+
             auto start = std::chrono::high_resolution_clock::now();
-            std::string response = orderManager.cancelOrder(orderId);
+            if (killSwitch ? !orderQueue.cancelAll(menuStrategy, ++menuRequestId, killInstrument)
+                           : !orderQueue.cancelOrder(menuStrategy, ++menuRequestId, orderId))
+                std::cerr << fmt::format(ERROR_COLOR, "Order queue is full, order not cancelled\n");
+            else if (!awaitCompletion(orderQueue, menuStrategy, menuRequestId, completion))
+                std::cerr << fmt::format(ERROR_COLOR, "No answer to the cancellation within 10 seconds\n");
+            else
+                printCompletion("Cancel Order", completion);
             auto end = std::chrono::high_resolution_clock::now();
 
-            std::cout << fmt::format(SUCCESS_COLOR, "Cancel Order Response:\n")
-                      << beautifyJson(response) << "\n";
             fmt::print(INFO_COLOR, "Cancel Order Latency: {} ms\n",
                        std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count());
             break;
@@ -233,14 +621,20 @@ int main()
         {
             /*
              * Fetches all open orders for a specific instrument.
-             * The user provides the instrument name (e.g., BTC-PERPETUAL).
+             * The user provides the instrument name (e.g., BTC-PERPETUAL), a currency
+             * (e.g., BTC) for all open orders of that currency, or ALL for every currency.
+             * Currency-wide results are also loaded into the local order store.
              */
             std::string instrument;
-            std::cout << fmt::format(HIGHLIGHT_COLOR, "Enter instrument name (e.g., BTC-PERPETUAL): ");
+            std::cout << fmt::format(HIGHLIGHT_COLOR, "Enter instrument name (e.g., BTC-PERPETUAL), currency (e.g., BTC) or ALL: ");
             std::getline(std::cin, instrument);
 
+            bool currencyWide = instrument.find('-') == std::string::npos;
+
             auto start = std::chrono::high_resolution_clock::now();
-            std::string response = orderManager.getAllOrders(instrument);
+            std::string response = !currencyWide       ? orderManager.getAllOrders(instrument)
+                                   : instrument == "ALL" ? orderManager.getAllOpenOrders()
+                                                         : orderManager.getOpenOrdersByCurrency(instrument);
             auto end = std::chrono::high_resolution_clock::now();
 
             if (response.empty())
@@ -252,6 +646,9 @@ int main()
             try
             {
                 auto responseJson = json::parse(response);
+                if (currencyWide && responseJson.contains("result"))
+                    orderStore.upsertAll(responseJson["result"]);
+
                 if (responseJson.contains("result") && !responseJson["result"].empty())
                 {
                     fmt::print(fmt::emphasis::bold | fmt::fg(fmt::color::cyan), "\n--- Open Orders ---\n");
@@ -293,6 +690,19 @@ int main()
                       << beautifyJson(response) << "\n";
             fmt::print(INFO_COLOR, "Account Summary Latency: {} ms\n",
                        std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count());
+
+            // Portfolio state of every session, read from the shared cache without any request
+            for (const auto &accountId : sessionManager.accountIds())
+            {
+                fmt::print(INFO_COLOR, "{} connection RTT: {} us\n", accountId, sessionManager.rttMicros(accountId));
+                for (const auto &currency : sessionManager.session(accountId)->config.currencies)
+                {
+                    AccountState state;
+                    if (sessionManager.accountState(accountId, currency, state))
+                        fmt::print(INFO_COLOR, "{} {}: equity {} | available {} | IM {} | MM {}\n", accountId, currency,
+                                   state.equity, state.availableFunds, state.initialMargin, state.maintenanceMargin);
+                }
+            }
             break;
         }
 
@@ -316,12 +726,36 @@ int main()
         {
             /*
              * Retrieves the top levels of the order book for a specific instrument.
-             * The user provides the instrument name (e.g., BTC-PERPETUAL).
+             * The user provides the instrument name (e.g., BTC-PERPETUAL), or CURRENCY:KIND
+             * (e.g., BTC:option) to fetch the top of book of every matching instrument in one
+             * request; repeated fetches only list the instruments that changed.
              */
             std::string instrument;
-            std::cout << fmt::format(HIGHLIGHT_COLOR, "Enter instrument name for order book (e.g., BTC-PERPETUAL): ");
+            std::cout << fmt::format(HIGHLIGHT_COLOR, "Enter instrument name for order book (e.g., BTC-PERPETUAL)\n"
+                                                      "or CURRENCY:KIND for a bulk top-of-book snapshot (e.g., BTC:option): ");
             std::getline(std::cin, instrument);
 
+            auto separator = instrument.find(':');
+            if (separator != std::string::npos)
+            {
+                auto start = std::chrono::high_resolution_clock::now();
+                std::string response = marketDataManager.getBookSummaryByCurrency(instrument.substr(0, separator), instrument.substr(separator + 1));
+                auto end = std::chrono::high_resolution_clock::now();
+
+                json summary = json::parse(response, nullptr, false);
+                if (summary.is_discarded() || summary.contains("error"))
+                {
+                    std::cerr << fmt::format(ERROR_COLOR, "Failed to fetch book summaries: {}\n", response);
+                    break;
+                }
+
+                std::size_t changed = topOfBook.applySummary(summary);
+                fmt::print(SUCCESS_COLOR, "{} of {} instruments changed since the last snapshot\n", changed, topOfBook.size());
+                fmt::print(INFO_COLOR, "Book Summary Fetch Latency: {} ms\n",
+                           std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count());
+                break;
+            }
+
             auto start = std::chrono::high_resolution_clock::now();
             std::string response = marketDataManager.getOrderBook(instrument);
             auto end = std::chrono::high_resolution_clock::now();
@@ -337,14 +771,21 @@ int main()
         {
             /*
              * Starts a WebSocket client to stream real-time market data.
-             * The user provides the symbol to subscribe to (e.g., BTC-PERPETUAL).
+             * The user provides the symbol to subscribe to (e.g., BTC-PERPETUAL), or a group
+             * written as CURRENCY:KIND:book|ticker (e.g., BTC:option:ticker) which is expanded
+             * over all matching instruments; option tickers also keep an `OptionChain` current. `markprice.options.{index}` (e.g., markprice.options.btc_usd)
+             * streams the whole option board through the bulk mark price decoder. `funding` follows
+             * the BTC/ETH perpetual funding and dated future basis, projected on positions kept
+             * current from `user.changes`.
              */
             std::string symbol;
-            std::cout << fmt::format(HIGHLIGHT_COLOR, "Enter symbol to subscribe for real-time updates (e.g., BTC-PERPETUAL): ");
+            std::cout << fmt::format(HIGHLIGHT_COLOR, "Enter symbol to subscribe for real-time updates (e.g., BTC-PERPETUAL)\n"
+                                                      "or a group as CURRENCY:KIND:book|ticker (e.g., BTC:option:ticker): ");
             std::getline(std::cin, symbol);
 
             WebSocketClient::Config wsConfig{"test.deribit.com", "443", "/ws/api/v2"};
             WebSocketClient wsClient(wsConfig);
+            InflightRequests requests; // Every request on this connection takes its ID here
 
             auto start = std::chrono::high_resolution_clock::now();
             wsClient.connect();
@@ -354,18 +795,284 @@ int main()
             fmt::print(INFO_COLOR, "WebSocket Connection Latency: {} ms\n",
                        std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count());
 
-            json subscribeMessage = {
-                {"jsonrpc", "2.0"},
-                {"method", "public/subscribe"},
-                {"params", {{"channels", {"book." + symbol + ".100ms"}}}}};
+            SubscriptionManager subscriptions;
+            std::unique_ptr<BookChannelSelector> selector;
+
+            InstrumentRegistry registry;
+            MarkPriceTable markPrices(registry);
+            double indexPrice = 0.0;
+
+            FundingTracker fundingTracker;
+            bool fundingMode = false;
+
+            // Option groups index their instruments; new listings re-index it (market data is kept)
+            OptionChain chain;
+            std::string chainCurrency;
+            bool chainStale = false;
+
+            // Private subscriptions wait for the reply to public/auth on this connection
+            std::vector<std::string> privateChannels;
+            bool authRequested = false;
+            bool authAnswered = false;
+            bool authorized = false;
+            bool bookAfterAuth = false;
+            auto bookMode = BookChannelSelector::Mode::Interval100ms;
+            auto requestAuth = [&wsClient, &requests, &authManager, &authRequested, &authAnswered, &authorized]()
+            {
+                wsClient.send(authManager.buildWebSocketAuthRequest(requests.allocate(RpcMethod::PublicAuth, [&authAnswered, &authorized](const json *response)
+                                                                                      {
+                                                                                          authorized = response && response->contains("result");
+                                                                                          authAnswered = true; })));
+                authRequested = true;
+            };
+
+            auto first = symbol.find(':');
+            auto second = first == std::string::npos ? std::string::npos : symbol.find(':', first + 1);
+            if (symbol.rfind("markprice.options.", 0) == 0)
+            {
+                // Bulk frames: one SAX decode and one Greeks pass per frame, no per-option callbacks
+                std::string indexName = symbol.substr(std::string("markprice.options.").size());
+                wsClient.send(requests.request(RpcMethod::PublicSubscribe, {{"channels", {symbol, "deribit_price_index." + indexName}}}));
 
-            wsClient.send(subscribeMessage.dump());
+                markPrices.setBatchHandler([&markPrices, &indexPrice](const MarkPriceTable &table, const std::vector<uint32_t> &updated)
+                                           {
+                                               auto now = std::chrono::duration_cast<std::chrono::milliseconds>(
+                                                              std::chrono::system_clock::now().time_since_epoch()).count();
+                                               markPrices.updateGreeks(indexPrice, now);
+                                               fmt::print(INFO_COLOR, "Mark prices: {} options updated ({} tracked), index {:.2f}\n",
+                                                          updated.size(), table.size(), indexPrice);
+                                           });
+            }
+            else if (symbol == "funding")
+            {
+                // Tickers of the perpetuals and of every dated future, plus the price indexes
+                const std::vector<std::string> currencies{"BTC", "ETH"};
+                std::vector<std::string> datedFutures;
+                for (const auto &currency : currencies)
+                {
+                    json futures = json::parse(marketDataManager.getInstruments(currency, "future"), nullptr, false);
+                    if (futures.is_discarded() || !futures.contains("result"))
+                        continue;
+                    for (const auto &instrument : futures["result"])
+                        if (instrument.value("settlement_period", "") != "perpetual")
+                            datedFutures.push_back(instrument.value("instrument_name", ""));
+                }
+
+                // Positions of every currency, then kept current from user.changes
+                if (!accountManager.refreshPositions())
+                    std::cerr << fmt::format(ERROR_COLOR, "Failed to load positions, funding projections start empty.\n");
+
+                wsClient.send(requests.request(RpcMethod::PublicSubscribe, {{"channels", fundingTracker.channels(currencies, datedFutures)}}));
+                requestAuth();
+                privateChannels.push_back("user.changes.any.any.100ms");
+                fundingMode = true;
+            }
+            else if (second != std::string::npos)
+            {
+                // Group subscription: expand the group over instrument metadata
+                std::string currency = symbol.substr(0, first);
+                std::string kind = symbol.substr(first + 1, second - first - 1);
+                std::string type = symbol.substr(second + 1);
 
-            std::thread receiveThread([&wsClient, &keepRunning](){
+                json instruments = json::parse(marketDataManager.getInstruments(currency, kind), nullptr, false);
+                if (instruments.is_discarded() || !instruments.contains("result"))
+                {
+                    std::cerr << fmt::format(ERROR_COLOR, "Failed to fetch instruments for {}.\n", symbol);
+                    wsClient.disconnect();
+                    break;
+                }
+
+                auto group = type == "book" ? SubscriptionGroup::topOfBook(currency, kind)
+                                            : SubscriptionGroup::ticker(currency, kind);
+                std::size_t count = subscriptions.addGroup(group, instruments["result"]);
+                if (kind == "option" && type == "ticker")
+                {
+                    chainCurrency = currency;
+                    fmt::print(INFO_COLOR, "Option chain: {} options in {} expiries\n", chain.load(instruments["result"]), chain.expiryCount());
+                }
+                fmt::print(INFO_COLOR, "Subscribing to {} channels in batches of {}\n", count, subscriptions.channelsPerRequest());
+            }
+            else
+            {
+                /*
+                 * Single instrument: pick the book interval. `raw`, `agg2` and `adaptive` need
+                 * an authorized connection, so the socket is authorized before subscribing.
+                 */
+                std::string interval;
+                std::cout << fmt::format(HIGHLIGHT_COLOR, "Enter book interval (100ms/agg2/raw/adaptive),\n"
+                                                          "or a depth (1/10/20) for a grouped snapshot book [100ms]: ");
+                std::getline(std::cin, interval);
+
+                if (!interval.empty() && std::all_of(interval.begin(), interval.end(), ::isdigit))
+                {
+                    // Snapshot-only book of a fixed depth, no delta bookkeeping
+                    GroupedBookChannel channel{symbol, "none", std::stoul(interval), "100ms"};
+                    wsClient.send(requests.request(RpcMethod::PublicSubscribe, {{"channels", {channel.name()}}}));
+                }
+                else
+                {
+                    bookMode = BookChannelSelector::parseMode(interval);
+                    if (bookMode != BookChannelSelector::Mode::Interval100ms)
+                    {
+                        // The selector is created once public/auth is answered (100ms if it failed)
+                        requestAuth();
+                        bookAfterAuth = true;
+                    }
+                    else
+                    {
+                        selector = std::make_unique<BookChannelSelector>(false);
+                        selector->add(symbol, bookMode);
+                        for (const auto &request : selector->takePendingRequests(requests))
+                            wsClient.send(request);
+                    }
+                }
+            }
+
+            for (const auto &request : subscriptions.takePendingRequests(requests))
+                wsClient.send(request);
+
+            OrderBook book(symbol);
+            MicrostructureSignals signals;
+            std::unordered_map<std::string, GroupedBook> groupedBooks;
+
+            // Notifications are dispatched by channel family in one perfect-hash lookup
+            FrameRouter router;
+            router.onChannel(ChannelKind::InstrumentState, [&subscriptions, &chainCurrency, &chainStale](const std::string &, const json &params)
+                             {
+                                 if (subscriptions.onInstrumentState(params) && !chainCurrency.empty())
+                                     chainStale = true; });
+            router.onChannel(ChannelKind::PriceIndex, [&indexPrice, &fundingTracker](const std::string &, const json &params)
+                             {
+                                 indexPrice = params["data"].value("price", indexPrice);
+                                 fundingTracker.onNotification(params); });
+            router.onChannel(ChannelKind::Ticker, [&fundingTracker, &fundingMode, &accountManager, &chain](const std::string &, const json &params)
+                             {
+                                 if (chain.onTicker(params["data"]))
+                                 {
+                                     // Report the ATM row of the expiry whenever one of its ATM options ticks
+                                     const OptionChain::Locator *locator = chain.find(params["data"].value("instrument_name", ""));
+                                     const OptionExpiry &slice = chain.expiry(locator->expiry);
+                                     if (locator->strike == slice.atmIndex)
+                                         fmt::print(INFO_COLOR, "{} expiry {} ATM {}: call IV {:.2f} | put IV {:.2f} | underlying {:.2f}\n",
+                                                    slice.underlying, slice.expiry, slice.strikes[slice.atmIndex],
+                                                    slice.calls.markIv[slice.atmIndex], slice.puts.markIv[slice.atmIndex], slice.underlyingPrice);
+                                     return;
+                                 }
+
+                                 if (!fundingTracker.onNotification(params) || !fundingMode)
+                                     return;
+
+                                 const std::string instrument = params["data"].value("instrument_name", "");
+                                 if (const BasisState *basis = fundingTracker.basis(instrument))
+                                 {
+                                     fmt::print(INFO_COLOR, "{}: basis {:.2f} ({:+.3f}%, {:+.2f}% annualized)\n",
+                                                instrument, basis->basis, basis->basisPct, basis->annualizedPct);
+                                     return;
+                                 }
+                                 if (const FundingState *funding = fundingTracker.funding(instrument.substr(0, instrument.find('-'))))
+                                     fmt::print(INFO_COLOR, "{}: funding {:+.6f} (8h {:+.6f}), index {:.2f}\n",
+                                                instrument, funding->currentFunding, funding->funding8h, funding->indexPrice);
+                                 for (const auto &projection : fundingTracker.projectFunding(accountManager, 8.0))
+                                     if (projection.instrument == instrument)
+                                         fmt::print(HIGHLIGHT_COLOR, "{}: position {} -> projected 8h funding {:+.8f}\n",
+                                                    instrument, projection.positionSize, projection.projectedAccrual);
+                             });
+            router.onChannel(ChannelKind::UserChanges, [&accountManager](const std::string &, const json &params)
+                             { accountManager.applyPositionUpdates(params["data"]); });
+            router.onResponse([&requests](const json &frame)
+                              { requests.complete(frame); });
+            bool resyncing = false;
+            router.onChannel(ChannelKind::Book, [&book, &signals, &selector, &groupedBooks, &resyncing](const std::string &channel, const json &params)
+                             {
+                                 // Grouped channels carry a full fixed-depth snapshot every time
+                                 GroupedBookChannel grouped;
+                                 if (GroupedBookChannel::parse(channel, grouped))
+                                 {
+                                     auto it = groupedBooks.try_emplace(grouped.instrument, grouped.instrument, grouped.depth).first;
+                                     if (it->second.applySnapshot(params["data"]))
+                                         fmt::print(INFO_COLOR, "{}: {} / {}\n", grouped.instrument, it->second.bestBid(), it->second.bestAsk());
+                                     return;
+                                 }
+
+                                 if (!selector || !selector->accept(channel, params["data"].value("timestamp", int64_t{0})))
+                                     return;
+
+                                 // Keep the local book and its signals current with every book notification
+                                 if (book.applyUpdate(params["data"]))
+                                 {
+                                     resyncing = false;
+                                     const BookSignals &s = signals.update(book);
+                                     fmt::print(INFO_COLOR, "Microprice: {:.2f} | Weighted Mid: {:.2f} | Imbalance: {:+.3f} | Pressure: {:+.3f} | Depletion (bid/ask): {:.1f}/{:.1f}\n",
+                                                s.microprice, s.weightedMid, s.imbalance, s.bookPressure, s.bidDepletionRate, s.askDepletionRate);
+                                 }
+                                 else if (!book.isValid() && !resyncing)
+                                 {
+                                     // Deribit only sends a new snapshot on subscription: cycle the channel once
+                                     resyncing = true;
+                                     signals.reset(book.instrument());
+                                     selector->resubscribe(book.instrument());
+                                     std::cerr << fmt::format(ERROR_COLOR, "Order book sequence gap detected, resubscribing {}...\n", channel);
+                                 }
+                             });
+
+            std::thread receiveThread([&wsClient, &requests, &keepRunning, &subscriptions, &selector, &markPrices, &router, &fundingMode,
+                                       &privateChannels, &authRequested, &authAnswered, &authorized, &bookAfterAuth, &bookMode, &symbol,
+                                       &chain, &chainCurrency, &chainStale, &marketDataManager](){
                 while (keepRunning)
                 {
-                    wsClient.receive([](const std::string &message)
-                                    { std::cout << fmt::format(SUCCESS_COLOR, "Real-time Data: {}\n", beautifyJson(message)); });
+                    wsClient.receive([&markPrices, &router, &fundingMode](const std::string &message)
+                                    {
+                                        // Bulk mark price frames are decoded without building a DOM or printing every option
+                                        if (markPrices.decode(message) > 0)
+                                            return;
+
+                                        // Funding mode prints its own summary lines instead of every frame
+                                        if (!fundingMode)
+                                            std::cout << fmt::format(SUCCESS_COLOR, "Real-time Data: {}\n", beautifyJson(message));
+                                        router.route(message);
+                                    });
+                    requests.expire();
+
+                    // Private subscriptions go out once public/auth has been answered
+                    if (authRequested && authAnswered)
+                    {
+                        authRequested = false;
+                        if (!authorized)
+                            std::cerr << fmt::format(ERROR_COLOR, "WebSocket authorization failed, private channels are unavailable\n");
+                        else if (!privateChannels.empty())
+                        {
+                            std::string request = requests.request(RpcMethod::PrivateSubscribe, {{"channels", privateChannels}});
+                            if (!request.empty())
+                                wsClient.send(request);
+                        }
+                        privateChannels.clear();
+
+                        // An unauthorized selector falls back to 100ms on its own
+                        if (bookAfterAuth)
+                        {
+                            selector = std::make_unique<BookChannelSelector>(authorized);
+                            selector->add(symbol, bookMode);
+                            bookAfterAuth = false;
+                        }
+                    }
+
+                    // Subscribe to listings announced on instrument.state (sent outside the receive callback)
+                    for (const auto &request : subscriptions.takePendingRequests(requests))
+                        wsClient.send(request);
+
+                    // Listings change rarely: re-index the option chain from fresh metadata
+                    if (chainStale)
+                    {
+                        json instruments = json::parse(marketDataManager.getInstruments(chainCurrency, "option"), nullptr, false);
+                        if (!instruments.is_discarded() && instruments.contains("result"))
+                            chain.load(instruments["result"]);
+                        chainStale = false;
+                    }
+
+                    // Make-before-break switches between raw and 100ms decided by the selector
+                    if (selector)
+                        for (const auto &request : selector->takePendingRequests(requests))
+                            wsClient.send(request);
                 } });
 
             std::cout << fmt::format(INFO_COLOR, "Press Enter to stop WebSocket stream...\n");
@@ -0,0 +1,209 @@
+#include "BookChannelSelector.h"
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <nlohmann/json.hpp>
+#include <fmt/color.h>
+
+// Define color constants for clarity
+const auto ERROR_COLOR = fmt::fg(fmt::color::red);
+const auto SUCCESS_COLOR = fmt::fg(fmt::color::cyan);
+const auto INFO_COLOR = fmt::fg(fmt::color::blue);
+const auto HIGHLIGHT_COLOR = fmt::fg(fmt::color::yellow);
+
+using json = nlohmann::json;
+
+/**
+ * @file BookChannelSelector.cpp
+ *
+ * @brief Implements the `BookChannelSelector` class, which picks and adaptively switches the book
+ *        channel interval of each instrument.
+ */
+
+BookChannelSelector::BookChannelSelector(bool authorized)
+    : BookChannelSelector(authorized, AdaptiveConfig()) {}
+
+BookChannelSelector::BookChannelSelector(bool authorized, const AdaptiveConfig& config)
+    : authorized(authorized), config(config) {}
+
+BookChannelSelector::Mode BookChannelSelector::parseMode(const std::string& name) {
+    if (name == "raw") return Mode::Raw;
+    if (name == "agg2") return Mode::Agg2;
+    if (name == "adaptive") return Mode::Adaptive;
+    return Mode::Interval100ms;
+}
+
+std::string BookChannelSelector::channelName(const std::string& instrument, const std::string& interval) {
+    return "book." + instrument + "." + interval;
+}
+
+/**
+ * @brief Registers an instrument and queues its initial channel.
+ *
+ * Adaptive instruments start on `100ms` and are upgraded once their message rate shows they are
+ * busy enough to benefit from `raw`.
+ */
+bool BookChannelSelector::add(const std::string& instrument, Mode mode) {
+    bool accepted = true;
+    if (!authorized && (mode == Mode::Raw || mode == Mode::Agg2 || mode == Mode::Adaptive)) {
+        std::cerr << fmt::format(ERROR_COLOR, "Book interval for {} requires an authorized connection, using 100ms\n", instrument);
+        mode = Mode::Interval100ms;
+        accepted = false;
+    }
+
+    State& state = instruments[instrument];
+    if (!state.current.empty()) {
+        toUnsubscribe.push_back(channelName(instrument, state.current));
+    }
+
+    state = State();
+    state.mode = mode;
+    state.current = mode == Mode::Raw ? "raw" : mode == Mode::Agg2 ? "agg2" : "100ms";
+    toSubscribe.push_back(channelName(instrument, state.current));
+    return accepted;
+}
+
+void BookChannelSelector::remove(const std::string& instrument) {
+    auto it = instruments.find(instrument);
+    if (it == instruments.end()) {
+        return;
+    }
+
+    toUnsubscribe.push_back(channelName(instrument, it->second.current));
+    if (!it->second.pending.empty()) {
+        toUnsubscribe.push_back(channelName(instrument, it->second.pending));
+    }
+    instruments.erase(it);
+}
+
+bool BookChannelSelector::resubscribe(const std::string& instrument) {
+    auto it = instruments.find(instrument);
+    if (it == instruments.end()) {
+        return false;
+    }
+    toResubscribe.push_back(channelName(instrument, it->second.current));
+    return true;
+}
+
+/**
+ * @brief Filters notifications by channel and feeds the adaptive rate estimate.
+ *
+ * ### Workflow:
+ * 1. Split `book.{instrument}.{interval}`; grouped book channels are not handled here.
+ * 2. The first notification on a pending channel promotes it to current (it is a snapshot, so the
+ *    book is rebuilt from it) and queues the old channel for unsubscription.
+ * 3. Notifications on the current channel update the decayed message rate, which drives the
+ *    adaptive policy.
+ */
+bool BookChannelSelector::accept(const std::string& channel, int64_t timestampMs) {
+    const auto first = channel.find('.');
+    const auto last = channel.rfind('.');
+    if (first == std::string::npos || last == first || channel.compare(0, first, "book") != 0) {
+        return false;
+    }
+
+    const std::string instrument = channel.substr(first + 1, last - first - 1);
+    const std::string interval = channel.substr(last + 1);
+    if (instrument.find('.') != std::string::npos) {
+        return false; // book.{instrument}.{group}.{depth}.{interval}
+    }
+
+    auto it = instruments.find(instrument);
+    if (it == instruments.end()) {
+        return false;
+    }
+    State& state = it->second;
+
+    if (!state.pending.empty() && interval == state.pending) {
+        toUnsubscribe.push_back(channelName(instrument, state.current));
+        std::cout << fmt::format(INFO_COLOR, "Book channel for {} switched from {} to {} ({:.1f} msg/s)\n",
+                                 instrument, state.current, state.pending, state.rate);
+        state.current = state.pending;
+        state.pending.clear();
+    } else if (interval != state.current) {
+        return false;
+    }
+
+    // Exponentially decayed event rate: converges to the true rate for a steady stream
+    const double tauMs = config.rateHalfLifeMs / std::log(2.0);
+    if (state.lastMessageMs != 0 && timestampMs > state.lastMessageMs) {
+        state.rate *= std::exp(-static_cast<double>(timestampMs - state.lastMessageMs) / tauMs);
+    }
+    state.rate += 1000.0 / tauMs;
+    state.lastMessageMs = std::max(state.lastMessageMs, timestampMs);
+
+    if (state.mode == Mode::Adaptive && state.pending.empty()) {
+        evaluate(instrument, state, timestampMs);
+    }
+    return true;
+}
+
+/**
+ * @brief Applies the hysteresis thresholds and the minimum dwell time.
+ */
+void BookChannelSelector::evaluate(const std::string& instrument, State& state, int64_t nowMs) {
+    if (state.lastSwitchMs != 0 && nowMs - state.lastSwitchMs < config.minDwellMs) {
+        return;
+    }
+    if (state.lastSwitchMs == 0) {
+        state.lastSwitchMs = nowMs; // Let the rate estimate warm up before the first decision
+        return;
+    }
+
+    std::string target;
+    if (state.current == "100ms" && state.rate >= config.upgradeRate) {
+        target = "raw";
+    } else if (state.current == "raw" && state.rate <= config.downgradeRate) {
+        target = "100ms";
+    }
+
+    if (!target.empty()) {
+        state.pending = target;
+        state.lastSwitchMs = nowMs;
+        toSubscribe.push_back(channelName(instrument, target));
+    }
+}
+
+std::vector<std::string> BookChannelSelector::takePendingRequests(InflightRequests& inflight) {
+    std::vector<std::string> requests;
+
+    // Sent channels are cleared; when the ring is full, the rest stays queued in order for the next call
+    auto build = [&inflight, &requests](RpcMethod method, std::vector<std::string>& channels) {
+        if (channels.empty()) {
+            return true;
+        }
+        std::string request = inflight.request(method, {{"channels", channels}});
+        if (request.empty()) {
+            return false;
+        }
+        requests.push_back(std::move(request));
+        channels.clear();
+        return true;
+    };
+    const RpcMethod subscribe = authorized ? RpcMethod::PrivateSubscribe : RpcMethod::PublicSubscribe;
+    const RpcMethod unsubscribe = authorized ? RpcMethod::PrivateUnsubscribe : RpcMethod::PublicUnsubscribe;
+
+    // A resubscribed channel must be dropped before it is subscribed again, or Deribit keeps the
+    // existing subscription and sends no snapshot
+    std::vector<std::string> resubscribed = toResubscribe;
+    if (!build(unsubscribe, toResubscribe)) {
+        return requests;
+    }
+    toSubscribe.insert(toSubscribe.end(), resubscribed.begin(), resubscribed.end());
+
+    // Subscriptions are sent first so the book is never left without a feed during a switch
+    if (build(subscribe, toSubscribe)) {
+        build(unsubscribe, toUnsubscribe);
+    }
+    return requests;
+}
+
+std::string BookChannelSelector::currentInterval(const std::string& instrument) const {
+    auto it = instruments.find(instrument);
+    return it == instruments.end() ? std::string() : it->second.current;
+}
+
+double BookChannelSelector::messageRate(const std::string& instrument) const {
+    auto it = instruments.find(instrument);
+    return it == instruments.end() ? 0.0 : it->second.rate;
+}
@@ -0,0 +1,183 @@
+#ifndef BOOK_CHANNEL_SELECTOR_H
+#define BOOK_CHANNEL_SELECTOR_H
+
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <unordered_map>
+#include "../InflightRequests.h"
+
+/**
+ * @file BookChannelSelector.h
+ *
+ * @brief Defines the `BookChannelSelector` class, which chooses the `book.{instrument}.{interval}`
+ *        channel variant per instrument and switches between them adaptively.
+ *
+ * Deribit publishes incremental book updates on three intervals:
+ * - `100ms`: changes aggregated over 100ms windows (available to everyone).
+ * - `agg2`: changes aggregated over a shorter window (authorized connections only).
+ * - `raw`: every change as it happens (authorized connections only).
+ *
+ * All three carry the same `snapshot` / `change` payload, so `OrderBook` applies them unchanged;
+ * the selector only decides which channel feeds each book. In adaptive mode, busy instruments are
+ * moved to `raw` to remove up to 100ms of built-in lag, and quiet ones fall back to `100ms` to save
+ * bandwidth.
+ *
+ * ### Switching Protocol (make-before-break):
+ * 1. Subscribe to the new channel while the old one keeps feeding the book.
+ * 2. When the first notification (a snapshot) arrives on the new channel, it becomes current and
+ *    the old channel is unsubscribed.
+ * 3. Notifications from any non-current channel are rejected by `accept`.
+ *
+ * After a sequence gap, `resubscribe` cycles the current channel so Deribit sends a fresh snapshot.
+ */
+
+/**
+ * @class BookChannelSelector
+ *
+ * @brief Per-instrument book channel selection with rate-based adaptive switching.
+ *
+ * ### Example:
+ * ```
+ * BookChannelSelector selector(true); // connection authorized via public/auth
+ * selector.add("BTC-PERPETUAL", BookChannelSelector::Mode::Adaptive);
+ * for (const auto& request : selector.takePendingRequests(requests)) wsClient.send(request);
+ *
+ * // For each book notification:
+ * if (selector.accept(channel, data["timestamp"])) book.applyUpdate(data);
+ * ```
+ */
+class BookChannelSelector {
+public:
+    /**
+     * @enum Mode
+     * @brief The interval policy of one instrument.
+     */
+    enum class Mode {
+        Interval100ms, /**< Always use `book.{instrument}.100ms`. */
+        Agg2,          /**< Always use `book.{instrument}.agg2` (authorized only). */
+        Raw,           /**< Always use `book.{instrument}.raw` (authorized only). */
+        Adaptive       /**< Switch between `raw` and `100ms` based on the observed message rate. */
+    };
+
+    /**
+     * @struct AdaptiveConfig
+     * @brief Thresholds of the adaptive policy.
+     */
+    struct AdaptiveConfig {
+        double upgradeRate{8.0};     /**< Messages/s on `100ms` above which `raw` is used (max is 10/s). */
+        double downgradeRate{2.0};   /**< Messages/s on `raw` below which `100ms` is used again. */
+        int64_t minDwellMs{10000};   /**< Minimum time between two switches of the same instrument. */
+        double rateHalfLifeMs{2000.0}; /**< Half-life of the message rate estimate. */
+    };
+
+    /**
+     * @brief Constructs a selector with the default adaptive thresholds.
+     *
+     * @param authorized Whether the WebSocket connection has been authorized (required for `raw`/`agg2`).
+     */
+    explicit BookChannelSelector(bool authorized);
+
+    /**
+     * @brief Constructs a selector.
+     *
+     * @param authorized Whether the WebSocket connection has been authorized (required for `raw`/`agg2`).
+     * @param config Thresholds of the adaptive policy.
+     */
+    BookChannelSelector(bool authorized, const AdaptiveConfig& config);
+
+    /**
+     * @brief Parses a string ("100ms", "agg2", "raw", "adaptive") into a mode.
+     *
+     * @param name The mode name.
+     * @return The parsed mode, `Interval100ms` if the name is not recognized.
+     */
+    static Mode parseMode(const std::string& name);
+
+    /**
+     * @brief Returns the book channel of an instrument for an interval (e.g., "book.BTC-PERPETUAL.raw").
+     */
+    static std::string channelName(const std::string& instrument, const std::string& interval);
+
+    /**
+     * @brief Starts tracking an instrument and queues the subscription of its initial channel.
+     *
+     * @param instrument The instrument name.
+     * @param mode The interval policy.
+     * @return False if the mode requires authorization and the connection is not authorized; in
+     *         that case the instrument falls back to `100ms`.
+     */
+    bool add(const std::string& instrument, Mode mode);
+
+    /**
+     * @brief Stops tracking an instrument and queues the unsubscription of its channels.
+     */
+    void remove(const std::string& instrument);
+
+    /**
+     * @brief Queues an unsubscribe/subscribe of an instrument's current channel.
+     *
+     * Deribit sends a snapshot only in response to a subscription, so this is how a book that
+     * detected a sequence gap gets rebuilt. The unsubscription is sent before the subscription.
+     *
+     * @param instrument The instrument name.
+     * @return False if the instrument is unknown.
+     */
+    bool resubscribe(const std::string& instrument);
+
+    /**
+     * @brief Decides whether a book notification should be applied and updates the rate estimate.
+     *
+     * @param channel The notification channel.
+     * @param timestampMs The exchange timestamp of the notification.
+     * @return True if the notification comes from the instrument's current channel (or from a
+     *         pending channel that has just been promoted to current).
+     */
+    bool accept(const std::string& channel, int64_t timestampMs);
+
+    /**
+     * @brief Builds the pending subscribe/unsubscribe requests and marks them as sent.
+     *
+     * @param requests The connection's request ring; every request takes its ID from it. While
+     *                 the ring is full, the requests that do not fit stay queued in order.
+     * @return Serialized JSON-RPC requests.
+     */
+    std::vector<std::string> takePendingRequests(InflightRequests& requests);
+
+    /**
+     * @brief Returns the interval currently feeding an instrument's book ("100ms", "raw", ...),
+     *        or an empty string if the instrument is unknown.
+     */
+    std::string currentInterval(const std::string& instrument) const;
+
+    /**
+     * @brief Returns the smoothed message rate (messages per second) of an instrument's current channel.
+     */
+    double messageRate(const std::string& instrument) const;
+
+private:
+    /**
+     * @struct State
+     * @brief Channel and rate bookkeeping of one instrument.
+     */
+    struct State {
+        Mode mode{Mode::Interval100ms};
+        std::string current;         /**< Interval feeding the book. */
+        std::string pending;         /**< Interval being switched to, empty if none. */
+        double rate{0.0};            /**< Smoothed messages per second on the current channel. */
+        int64_t lastMessageMs{0};    /**< Timestamp of the last accepted message. */
+        int64_t lastSwitchMs{0};     /**< Timestamp of the last switch decision. */
+    };
+
+    /** @brief Evaluates the adaptive policy for one instrument and starts a switch if needed. */
+    void evaluate(const std::string& instrument, State& state, int64_t nowMs);
+
+    bool authorized;                                   /**< Whether private intervals are available. */
+    AdaptiveConfig config;                             /**< Adaptive thresholds. */
+    std::unordered_map<std::string, State> instruments; /**< Per-instrument state. */
+    std::vector<std::string> toSubscribe;              /**< Channels queued for subscription. */
+    std::vector<std::string> toUnsubscribe;            /**< Channels queued for unsubscription. */
+    std::vector<std::string> toResubscribe;            /**< Channels queued for unsubscription, then subscription. */
+};
+
+#endif // BOOK_CHANNEL_SELECTOR_H
@@ -0,0 +1,247 @@
+#include "FundingTracker.h"
+#include "../account_management/AccountManager.h"
+#include <algorithm>
+#include <cctype>
+#include <nlohmann/json.hpp>
+
+using json = nlohmann::json;
+
+/**
+ * @file FundingTracker.cpp
+ *
+ * @brief Implements the `FundingTracker` class, which maintains perpetual funding, index prices and
+ *        dated future basis from streamed notifications.
+ */
+
+namespace {
+
+constexpr double MS_PER_YEAR = 365.0 * 24.0 * 3600.0 * 1000.0;
+
+/**
+ * @brief Returns the currency prefix of an instrument name ("BTC-PERPETUAL" -> "BTC").
+ */
+std::string currencyOf(const std::string& instrument) {
+    return instrument.substr(0, instrument.find('-'));
+}
+
+/**
+ * @brief Converts a civil date to days since the Unix epoch (proleptic Gregorian calendar).
+ */
+int64_t daysFromCivil(int64_t y, unsigned m, unsigned d) {
+    y -= m <= 2;
+    const int64_t era = (y >= 0 ? y : y - 399) / 400;
+    const unsigned yoe = static_cast<unsigned>(y - era * 400);
+    const unsigned doy = (153 * (m + (m > 2 ? -3 : 9)) + 2) / 5 + d - 1;
+    const unsigned doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+    return era * 146097 + static_cast<int64_t>(doe) - 719468;
+}
+
+} // namespace
+
+std::vector<std::string> FundingTracker::channels(const std::vector<std::string>& currencies,
+                                                  const std::vector<std::string>& datedFutures,
+                                                  const std::string& interval) const {
+    std::vector<std::string> result;
+    for (const auto& currency : currencies) {
+        std::string index = currency;
+        std::transform(index.begin(), index.end(), index.begin(), [](unsigned char c) { return std::tolower(c); });
+
+        result.push_back("ticker." + currency + "-PERPETUAL." + interval);
+        result.push_back("deribit_price_index." + index + "_usd");
+    }
+    for (const auto& future : datedFutures) {
+        result.push_back("ticker." + future + "." + interval);
+    }
+    return result;
+}
+
+/**
+ * @brief Routes a notification to the ticker or price index handler based on its channel.
+ */
+bool FundingTracker::onNotification(const json& params) {
+    const std::string channel = params.value("channel", "");
+    if (!params.contains("data")) {
+        return false;
+    }
+
+    if (channel.rfind("ticker.", 0) == 0) {
+        return onTicker(params["data"]);
+    }
+    if (channel.rfind("deribit_price_index.", 0) == 0) {
+        return onPriceIndex(params["data"]);
+    }
+    return false;
+}
+
+/**
+ * @brief Updates funding (perpetuals) or basis (dated futures) from a ticker payload.
+ *
+ * Tickers also carry the index price, which is used to keep the index fresh between
+ * `deribit_price_index` notifications.
+ */
+bool FundingTracker::onTicker(const json& data) {
+    const std::string instrument = data.value("instrument_name", "");
+    if (instrument.empty()) {
+        return false;
+    }
+
+    const std::string currency = currencyOf(instrument);
+    const int64_t timestamp = data.value("timestamp", int64_t{0});
+    const double index = data.value("index_price", 0.0);
+    if (index > 0.0) {
+        indexByCurrency[currency] = index;
+    }
+
+    if (instrument.size() > 10 && instrument.compare(instrument.size() - 10, 10, "-PERPETUAL") == 0) {
+        FundingState& state = fundingByCurrency[currency];
+        state.instrument = instrument;
+        state.markPrice = data.value("mark_price", state.markPrice);
+        state.indexPrice = index > 0.0 ? index : state.indexPrice;
+        state.currentFunding = data.value("current_funding", state.currentFunding);
+        state.funding8h = data.value("funding_8h", state.funding8h);
+        state.timestamp = timestamp;
+        return true;
+    }
+
+    // Dated futures have exactly two segments; options ("BTC-27DEC24-60000-C") carry an expiry too
+    const int64_t expiry = parseExpiry(instrument);
+    if (expiry == 0 || instrument.find('-', instrument.find('-') + 1) != std::string::npos) {
+        return false;
+    }
+
+    BasisState& state = basisByInstrument[instrument];
+    state.instrument = instrument;
+    state.expiry = expiry;
+    state.markPrice = data.value("mark_price", state.markPrice);
+    updateBasis(state, indexPrice(currency), timestamp);
+    return true;
+}
+
+/**
+ * @brief Updates a currency's index price and re-derives the basis of its futures.
+ */
+bool FundingTracker::onPriceIndex(const json& data) {
+    std::string indexName = data.value("index_name", "");
+    const double price = data.value("price", 0.0);
+    if (indexName.empty() || price <= 0.0) {
+        return false;
+    }
+
+    std::string currency = indexName.substr(0, indexName.find('_'));
+    std::transform(currency.begin(), currency.end(), currency.begin(), [](unsigned char c) { return std::toupper(c); });
+
+    indexByCurrency[currency] = price;
+    const int64_t timestamp = data.value("timestamp", int64_t{0});
+
+    auto funding = fundingByCurrency.find(currency);
+    if (funding != fundingByCurrency.end()) {
+        funding->second.indexPrice = price;
+    }
+
+    for (auto& entry : basisByInstrument) {
+        if (currencyOf(entry.first) == currency) {
+            updateBasis(entry.second, price, timestamp);
+        }
+    }
+    return true;
+}
+
+void FundingTracker::updateBasis(BasisState& state, double index, int64_t timestamp) {
+    state.timestamp = std::max(state.timestamp, timestamp);
+    if (index <= 0.0 || state.markPrice <= 0.0) {
+        return;
+    }
+
+    state.basis = state.markPrice - index;
+    state.basisPct = state.basis / index * 100.0;
+
+    const double remainingMs = static_cast<double>(state.expiry - state.timestamp);
+    state.annualizedPct = remainingMs > 0.0 ? state.basisPct * MS_PER_YEAR / remainingMs : 0.0;
+}
+
+const FundingState* FundingTracker::funding(const std::string& currency) const {
+    auto it = fundingByCurrency.find(currency);
+    return it == fundingByCurrency.end() ? nullptr : &it->second;
+}
+
+const BasisState* FundingTracker::basis(const std::string& instrument) const {
+    auto it = basisByInstrument.find(instrument);
+    return it == basisByInstrument.end() ? nullptr : &it->second;
+}
+
+double FundingTracker::indexPrice(const std::string& currency) const {
+    auto it = indexByCurrency.find(currency);
+    return it == indexByCurrency.end() ? 0.0 : it->second;
+}
+
+/**
+ * @brief Projects funding accrual for every cached perpetual position.
+ *
+ * Positions are read from the `AccountManager` cache, so no request is issued here.
+ */
+std::vector<FundingProjection> FundingTracker::projectFunding(const AccountManager& accounts, double horizonHours) const {
+    std::vector<FundingProjection> projections;
+
+    for (const auto& entry : accounts.cachedPositions()) {
+        const Position& position = entry.second;
+        auto it = fundingByCurrency.find(currencyOf(position.instrument));
+        if (it == fundingByCurrency.end() || it->second.instrument != position.instrument) {
+            continue;
+        }
+
+        const FundingState& state = it->second;
+        const double index = state.indexPrice > 0.0 ? state.indexPrice : indexPrice(currencyOf(position.instrument));
+        if (index <= 0.0) {
+            continue;
+        }
+
+        FundingProjection projection;
+        projection.instrument = position.instrument;
+        projection.positionSize = position.size;
+        projection.projectedAccrual = -position.size * state.funding8h * (horizonHours / 8.0) / index;
+        projections.push_back(projection);
+    }
+
+    return projections;
+}
+
+/**
+ * @brief Parses the DDMMMYY expiry suffix of a dated future name.
+ *
+ * Deribit futures expire at 08:00 UTC, so that time is added to the parsed date.
+ */
+int64_t FundingTracker::parseExpiry(const std::string& instrument) {
+    static const char* MONTHS[] = {"JAN", "FEB", "MAR", "APR", "MAY", "JUN",
+                                   "JUL", "AUG", "SEP", "OCT", "NOV", "DEC"};
+
+    const auto dash = instrument.find('-');
+    if (dash == std::string::npos) {
+        return 0;
+    }
+
+    // Only the segment right after the currency carries the date ("BTC-27DEC24", "BTC-27DEC24-60000-C")
+    const auto end = instrument.find('-', dash + 1);
+    const std::string date = instrument.substr(dash + 1, end == std::string::npos ? std::string::npos : end - dash - 1);
+    if (date.size() < 6 || date.size() > 7 || !std::isdigit(static_cast<unsigned char>(date[0]))) {
+        return 0;
+    }
+
+    const std::size_t dayDigits = date.size() - 5;
+    const unsigned day = static_cast<unsigned>(std::stoi(date.substr(0, dayDigits)));
+    const std::string month = date.substr(dayDigits, 3);
+    const std::string year = date.substr(dayDigits + 3, 2);
+    if (!std::isdigit(static_cast<unsigned char>(year[0])) || !std::isdigit(static_cast<unsigned char>(year[1]))) {
+        return 0;
+    }
+
+    unsigned monthIndex = 0;
+    while (monthIndex < 12 && month != MONTHS[monthIndex]) {
+        ++monthIndex;
+    }
+    if (monthIndex == 12) {
+        return 0;
+    }
+
+    const int64_t days = daysFromCivil(2000 + std::stoi(year), monthIndex + 1, day);
+    return (days * 86400 + 8 * 3600) * 1000;
+}
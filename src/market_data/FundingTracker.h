@@ -0,0 +1,164 @@
+#ifndef FUNDING_TRACKER_H
+#define FUNDING_TRACKER_H
+
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <unordered_map>
+#include <nlohmann/json_fwd.hpp>
+
+class AccountManager;
+
+/**
+ * @file FundingTracker.h
+ *
+ * @brief Defines the `FundingTracker` class, which follows perpetual funding rates and the basis of
+ *        dated futures from streamed ticker and price index notifications.
+ *
+ * All state is updated incrementally from WebSocket notifications; no REST polling is involved.
+ *
+ * ### Key Responsibilities:
+ * - Track the current and 8h funding rate of each currency's perpetual from `ticker.*-PERPETUAL.*`.
+ * - Track the index price of each currency from `deribit_price_index.*`.
+ * - Track the basis (absolute, relative and annualized) of every subscribed dated future.
+ * - Project funding accrual on the open perpetual positions held in the `AccountManager` cache.
+ */
+
+/**
+ * @struct FundingState
+ *
+ * @brief Latest funding data of one currency's perpetual.
+ */
+struct FundingState {
+    std::string instrument;     /**< The perpetual instrument name (e.g., "BTC-PERPETUAL"). */
+    double markPrice{0.0};      /**< Perpetual mark price. */
+    double indexPrice{0.0};     /**< Underlying index price. */
+    double currentFunding{0.0}; /**< Current (instantaneous) funding rate. */
+    double funding8h{0.0};      /**< Funding rate over the last 8 hours. */
+    int64_t timestamp{0};       /**< Exchange timestamp (ms) of the last update. */
+};
+
+/**
+ * @struct BasisState
+ *
+ * @brief Latest basis of one dated future against its index.
+ */
+struct BasisState {
+    std::string instrument;     /**< The future instrument name (e.g., "BTC-27DEC24"). */
+    int64_t expiry{0};          /**< Expiration timestamp (ms, 08:00 UTC on the expiry date). */
+    double markPrice{0.0};      /**< Future mark price. */
+    double basis{0.0};          /**< Mark price minus index price. */
+    double basisPct{0.0};       /**< Basis relative to the index price. */
+    double annualizedPct{0.0};  /**< Basis annualized over the remaining time to expiry. */
+    int64_t timestamp{0};       /**< Exchange timestamp (ms) of the last update. */
+};
+
+/**
+ * @struct FundingProjection
+ *
+ * @brief Projected funding accrual of one open perpetual position.
+ */
+struct FundingProjection {
+    std::string instrument;     /**< The perpetual instrument name. */
+    double positionSize{0.0};   /**< Signed position size in USD. */
+    double projectedAccrual{0.0}; /**< Projected funding received (negative when paid), in the base currency. */
+};
+
+/**
+ * @class FundingTracker
+ *
+ * @brief Maintains funding and basis state from ticker and price index notifications.
+ *
+ * ### Example:
+ * ```
+ * FundingTracker tracker;
+ * for (const auto& channel : tracker.channels({"BTC", "ETH"}, {"BTC-27DEC24"})) {
+ *     subscribeMessage["params"]["channels"].push_back(channel);
+ * }
+ * // For each incoming notification:
+ * tracker.onNotification(notification["params"]);
+ * auto projections = tracker.projectFunding(accountManager, 8.0);
+ * ```
+ */
+class FundingTracker {
+public:
+    /**
+     * @brief Builds the list of channels the tracker needs.
+     *
+     * @param currencies The currencies whose perpetual and index should be followed (e.g., "BTC").
+     * @param datedFutures The dated futures whose basis should be tracked (e.g., "BTC-27DEC24").
+     * @param interval The ticker interval ("100ms" or "raw").
+     * @return The channel names to pass to `public/subscribe`.
+     *
+     * Deribit has no wildcard ticker channel, so `ticker.*-PERPETUAL` is expanded per currency.
+     */
+    std::vector<std::string> channels(const std::vector<std::string>& currencies,
+                                      const std::vector<std::string>& datedFutures,
+                                      const std::string& interval = "100ms") const;
+
+    /**
+     * @brief Applies a subscription notification if it belongs to one of the tracked channels.
+     *
+     * @param params The `params` object of the notification (with `channel` and `data`).
+     * @return True if the notification updated the tracker's state.
+     */
+    bool onNotification(const nlohmann::json& params);
+
+    /**
+     * @brief Returns the funding state of a currency's perpetual, or nullptr if not yet seen.
+     *
+     * @param currency The currency (e.g., "BTC").
+     */
+    const FundingState* funding(const std::string& currency) const;
+
+    /**
+     * @brief Returns the basis state of a dated future, or nullptr if not yet seen.
+     *
+     * @param instrument The future instrument name.
+     */
+    const BasisState* basis(const std::string& instrument) const;
+
+    /**
+     * @brief Returns the latest index price of a currency, or 0 if not yet seen.
+     *
+     * @param currency The currency (e.g., "BTC").
+     */
+    double indexPrice(const std::string& currency) const;
+
+    /**
+     * @brief Projects the funding accrual of the cached perpetual positions over a horizon.
+     *
+     * @param accounts The account manager holding the position cache.
+     * @param horizonHours The projection horizon in hours.
+     * @return One projection per open perpetual position whose funding is known.
+     *
+     * ### Formula:
+     * Perpetuals are inverse contracts sized in USD; longs pay shorts when funding is positive:
+     * `accrual = -size * funding8h * (horizonHours / 8) / indexPrice`.
+     */
+    std::vector<FundingProjection> projectFunding(const AccountManager& accounts, double horizonHours) const;
+
+    /**
+     * @brief Parses the expiry of a dated future from its name (e.g., "BTC-27DEC24").
+     *
+     * @param instrument The future instrument name.
+     * @return The expiration timestamp in milliseconds (08:00 UTC), or 0 if the name has no expiry.
+     */
+    static int64_t parseExpiry(const std::string& instrument);
+
+private:
+    /** @brief Applies a `ticker.*` notification payload. */
+    bool onTicker(const nlohmann::json& data);
+
+    /** @brief Applies a `deribit_price_index.*` notification payload. */
+    bool onPriceIndex(const nlohmann::json& data);
+
+    /** @brief Recomputes the basis of a future after its mark or index price changed. */
+    void updateBasis(BasisState& state, double indexPrice, int64_t timestamp);
+
+    std::unordered_map<std::string, FundingState> fundingByCurrency; /**< Perpetual funding keyed by currency. */
+    std::unordered_map<std::string, BasisState> basisByInstrument;   /**< Future basis keyed by instrument. */
+    std::unordered_map<std::string, double> indexByCurrency;         /**< Latest index price keyed by currency. */
+};
+
+#endif // FUNDING_TRACKER_H
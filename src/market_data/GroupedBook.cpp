@@ -0,0 +1,107 @@
+#include "GroupedBook.h"
+#include <algorithm>
+#include <cctype>
+#include <nlohmann/json.hpp>
+
+using json = nlohmann::json;
+
+/**
+ * @file GroupedBook.cpp
+ *
+ * @brief Implements the `GroupedBook` class and the parsing of grouped book channel names.
+ */
+
+std::string GroupedBookChannel::name() const {
+    return "book." + instrument + "." + group + "." + std::to_string(depth) + "." + interval;
+}
+
+/**
+ * @brief Splits `book.{instrument}.{group}.{depth}.{interval}` into its components.
+ *
+ * Instrument names never contain dots, so a grouped channel always has exactly five parts.
+ */
+bool GroupedBookChannel::parse(const std::string& channel, GroupedBookChannel& out) {
+    std::vector<std::string> parts;
+    std::size_t start = 0;
+    while (true) {
+        const auto dot = channel.find('.', start);
+        parts.push_back(channel.substr(start, dot == std::string::npos ? std::string::npos : dot - start));
+        if (dot == std::string::npos) {
+            break;
+        }
+        start = dot + 1;
+    }
+
+    if (parts.size() != 5 || parts[0] != "book" || parts[3].empty() ||
+        !std::all_of(parts[3].begin(), parts[3].end(), [](unsigned char c) { return std::isdigit(c); })) {
+        return false;
+    }
+
+    out.instrument = parts[1];
+    out.group = parts[2];
+    out.depth = static_cast<std::size_t>(std::stoul(parts[3]));
+    out.interval = parts[4];
+    return true;
+}
+
+GroupedBook::GroupedBook(const std::string& instrument, std::size_t depth)
+    : instrumentName(instrument),
+      bidLevels(std::max<std::size_t>(depth, 1)),
+      askLevels(std::max<std::size_t>(depth, 1)),
+      bidCount(0),
+      askCount(0),
+      lastTimestamp(0) {}
+
+/**
+ * @brief Overwrites both sides with the levels of a grouped snapshot.
+ *
+ * No sorting, searching or sequence checks are needed: the exchange sends the levels best-first
+ * and every notification is complete on its own.
+ */
+bool GroupedBook::applySnapshot(const json& data) {
+    if (!data.contains("bids") || !data.contains("asks")) {
+        return false;
+    }
+
+    bidCount = copyLevels(data["bids"], bidLevels);
+    askCount = copyLevels(data["asks"], askLevels);
+    lastTimestamp = data.value("timestamp", lastTimestamp);
+    return true;
+}
+
+std::size_t GroupedBook::copyLevels(const json& source, std::vector<PriceLevel>& target) {
+    const std::size_t count = std::min(source.size(), target.size());
+    for (std::size_t i = 0; i < count; ++i) {
+        target[i].price = source[i][0].get<double>();
+        target[i].amount = source[i][1].get<double>();
+    }
+    return count;
+}
+
+const std::string& GroupedBook::instrument() const {
+    return instrumentName;
+}
+
+std::size_t GroupedBook::depth() const {
+    return bidLevels.size();
+}
+
+const PriceLevel* GroupedBook::levels(OrderBook::Side side) const {
+    return side == OrderBook::Side::Bid ? bidLevels.data() : askLevels.data();
+}
+
+std::size_t GroupedBook::levelCount(OrderBook::Side side) const {
+    return side == OrderBook::Side::Bid ? bidCount : askCount;
+}
+
+double GroupedBook::bestBid() const {
+    return bidCount == 0 ? 0.0 : bidLevels[0].price;
+}
+
+double GroupedBook::bestAsk() const {
+    return askCount == 0 ? 0.0 : askLevels[0].price;
+}
+
+int64_t GroupedBook::timestamp() const {
+    return lastTimestamp;
+}
@@ -0,0 +1,118 @@
+#ifndef GROUPED_BOOK_H
+#define GROUPED_BOOK_H
+
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include <nlohmann/json_fwd.hpp>
+#include "OrderBook.h"
+
+/**
+ * @file GroupedBook.h
+ *
+ * @brief Defines the `GroupedBook` class, a fixed-depth book fed by Deribit's grouped book channels
+ *        `book.{instrument}.{group}.{depth}.{interval}`.
+ *
+ * Grouped channels publish a complete snapshot of the top `depth` levels (optionally aggregated
+ * into price buckets of `group`) on every notification. There are no deltas to sequence, so the
+ * book simply overwrites its levels. This is the cheap option for the long tail of instruments
+ * (e.g., far-out options) where full depth and `raw` updates are not worth the bandwidth and CPU.
+ *
+ * ### Key Responsibilities:
+ * - Parse and build grouped channel names.
+ * - Store exactly `depth` levels per side in storage allocated once at construction.
+ */
+
+/**
+ * @struct GroupedBookChannel
+ *
+ * @brief The components of a `book.{instrument}.{group}.{depth}.{interval}` channel name.
+ */
+struct GroupedBookChannel {
+    std::string instrument;      /**< The instrument name. */
+    std::string group{"none"};   /**< Price grouping ("none", "1", "2", "5", "10", ...). */
+    std::size_t depth{10};       /**< Number of levels per side (1, 10 or 20). */
+    std::string interval{"100ms"}; /**< Publication interval ("100ms" or "agg2"). */
+
+    /** @brief Builds the channel name. */
+    std::string name() const;
+
+    /**
+     * @brief Parses a channel name.
+     *
+     * @param channel The channel name.
+     * @param out Receives the parsed components.
+     * @return True if the channel is a grouped book channel.
+     */
+    static bool parse(const std::string& channel, GroupedBookChannel& out);
+};
+
+/**
+ * @class GroupedBook
+ *
+ * @brief A snapshot-only book holding at most `depth` levels per side.
+ *
+ * ### Example:
+ * ```
+ * GroupedBookChannel channel{"BTC-27DEC24-100000-C", "none", 1, "100ms"};
+ * GroupedBook book(channel.instrument, channel.depth);
+ * // subscribe to channel.name(), then for each notification:
+ * book.applySnapshot(notification["params"]["data"]);
+ * std::cout << book.bestBid() << " / " << book.bestAsk() << std::endl;
+ * ```
+ */
+class GroupedBook {
+public:
+    /**
+     * @brief Constructs an empty book sized to the channel depth.
+     *
+     * @param instrument The instrument name.
+     * @param depth The number of levels per side published by the channel.
+     */
+    GroupedBook(const std::string& instrument, std::size_t depth);
+
+    /**
+     * @brief Replaces the book with the snapshot carried by a grouped book notification.
+     *
+     * @param data The notification `data` object (`bids` / `asks` as `[price, amount]` pairs).
+     * @return True if the snapshot was applied.
+     *
+     * Levels beyond the configured depth are ignored, so the storage never grows.
+     */
+    bool applySnapshot(const nlohmann::json& data);
+
+    /** @brief Returns the instrument name. */
+    const std::string& instrument() const;
+
+    /** @brief Returns the configured depth per side. */
+    std::size_t depth() const;
+
+    /** @brief Returns a pointer to the first level of a side (best price first). */
+    const PriceLevel* levels(OrderBook::Side side) const;
+
+    /** @brief Returns the number of populated levels on a side. */
+    std::size_t levelCount(OrderBook::Side side) const;
+
+    /** @brief Returns the best bid price, or 0 if the bid side is empty. */
+    double bestBid() const;
+
+    /** @brief Returns the best ask price, or 0 if the ask side is empty. */
+    double bestAsk() const;
+
+    /** @brief Returns the exchange timestamp (milliseconds) of the last snapshot. */
+    int64_t timestamp() const;
+
+private:
+    /** @brief Copies up to `depth` `[price, amount]` pairs into a side's storage. */
+    std::size_t copyLevels(const nlohmann::json& source, std::vector<PriceLevel>& target);
+
+    std::string instrumentName;        /**< The instrument this book belongs to. */
+    std::vector<PriceLevel> bidLevels; /**< Exactly `depth` slots, best bid first. */
+    std::vector<PriceLevel> askLevels; /**< Exactly `depth` slots, best ask first. */
+    std::size_t bidCount;              /**< Populated bid slots. */
+    std::size_t askCount;              /**< Populated ask slots. */
+    int64_t lastTimestamp;             /**< Timestamp of the last snapshot. */
+};
+
+#endif // GROUPED_BOOK_H
@@ -0,0 +1,28 @@
+#include "InstrumentRegistry.h"
+
+/**
+ * @file InstrumentRegistry.cpp
+ *
+ * @brief Implements the `InstrumentRegistry` class, which interns instrument names into dense IDs.
+ */
+
+uint32_t InstrumentRegistry::intern(const std::string& instrument) {
+    auto result = ids.emplace(instrument, static_cast<uint32_t>(names.size()));
+    if (result.second) {
+        names.push_back(instrument);
+    }
+    return result.first->second;
+}
+
+uint32_t InstrumentRegistry::find(const std::string& instrument) const {
+    auto it = ids.find(instrument);
+    return it == ids.end() ? INVALID_ID : it->second;
+}
+
+const std::string& InstrumentRegistry::name(uint32_t id) const {
+    return names.at(id);
+}
+
+std::size_t InstrumentRegistry::size() const {
+    return names.size();
+}
@@ -0,0 +1,65 @@
+#ifndef INSTRUMENT_REGISTRY_H
+#define INSTRUMENT_REGISTRY_H
+
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include <unordered_map>
+
+/**
+ * @file InstrumentRegistry.h
+ *
+ * @brief Defines the `InstrumentRegistry` class, which interns instrument names into dense integer IDs.
+ *
+ * Hot paths that touch many instruments per message (bulk mark price frames, chain-wide Greeks)
+ * index plain arrays by instrument ID instead of hashing names repeatedly. IDs are assigned in
+ * order of first appearance starting at 0 and are never reused, so they can be used directly as
+ * indices into structure-of-arrays storage.
+ */
+
+/**
+ * @class InstrumentRegistry
+ *
+ * @brief Bidirectional mapping between instrument names and dense IDs.
+ *
+ * ### Example:
+ * ```
+ * InstrumentRegistry registry;
+ * uint32_t id = registry.intern("BTC-27DEC24-60000-C");
+ * std::cout << registry.name(id) << std::endl;
+ * ```
+ */
+class InstrumentRegistry {
+public:
+    /** @brief Value returned by `find` for unknown instruments. */
+    static constexpr uint32_t INVALID_ID = 0xFFFFFFFFu;
+
+    /**
+     * @brief Returns the ID of an instrument, assigning the next free ID if it is new.
+     *
+     * @param instrument The instrument name.
+     * @return The dense ID of the instrument.
+     */
+    uint32_t intern(const std::string& instrument);
+
+    /**
+     * @brief Looks up the ID of an instrument without assigning one.
+     *
+     * @param instrument The instrument name.
+     * @return The ID, or `INVALID_ID` if the instrument has not been interned.
+     */
+    uint32_t find(const std::string& instrument) const;
+
+    /** @brief Returns the name of an interned instrument. */
+    const std::string& name(uint32_t id) const;
+
+    /** @brief Returns the number of interned instruments (one past the highest ID). */
+    std::size_t size() const;
+
+private:
+    std::unordered_map<std::string, uint32_t> ids; /**< Name -> ID. */
+    std::vector<std::string> names;                /**< ID -> name. */
+};
+
+#endif // INSTRUMENT_REGISTRY_H
@@ -0,0 +1,311 @@
+#include "MarkPriceTable.h"
+#include "FundingTracker.h"
+#include <algorithm>
+#include <cmath>
+#include <nlohmann/json.hpp>
+
+using json = nlohmann::json;
+
+/**
+ * @file MarkPriceTable.cpp
+ *
+ * @brief Implements the `MarkPriceTable` class: SAX decoding of bulk mark price frames into
+ *        structure-of-arrays storage and the batch Greeks pass over it.
+ */
+
+namespace {
+
+const std::string CHANNEL_PREFIX = "markprice.options.";
+constexpr double MS_PER_YEAR = 365.0 * 24.0 * 3600.0 * 1000.0;
+constexpr double INV_SQRT_2 = 0.70710678118654752440;
+constexpr double INV_SQRT_2PI = 0.39894228040143267794;
+
+/** @brief One decoded element of `params.data`, buffered until the channel has been confirmed. */
+struct Entry {
+    std::string instrument;
+    double markPrice = 0.0;
+    double iv = 0.0;
+    int64_t timestamp = 0;
+};
+
+/**
+ * @brief Parses strike and call/put flag from an option name ("BTC-27DEC24-60000-C").
+ *
+ * Fractional strikes are written with a 'd' in place of the decimal point ("XRP_USDC-27DEC24-0d625-C").
+ * Anything that is not a four-part option name yields a zero strike, which disables its Greeks.
+ */
+void parseContract(const std::string& instrument, double& strike, double& callPut) {
+    strike = 0.0;
+    callPut = 0.0;
+
+    const auto first = instrument.find('-');
+    const auto second = first == std::string::npos ? first : instrument.find('-', first + 1);
+    const auto third = second == std::string::npos ? second : instrument.find('-', second + 1);
+    if (third == std::string::npos || third + 2 != instrument.size()) {
+        return;
+    }
+
+    std::string text = instrument.substr(second + 1, third - second - 1);
+    std::replace(text.begin(), text.end(), 'd', '.');
+    try {
+        strike = std::stod(text);
+    } catch (const std::exception&) {
+        return;
+    }
+    callPut = instrument.back() == 'C' ? 1.0 : -1.0;
+}
+
+} // namespace
+
+/**
+ * @class MarkPriceTable::SaxHandler
+ *
+ * @brief SAX consumer that extracts `params.channel` and the elements of `params.data`.
+ *
+ * A stack of container kinds tracks where the parser is, so each scalar event is classified with
+ * one comparison instead of a path lookup. Elements are buffered in a reusable array because the
+ * channel may in principle appear after the data in the frame.
+ */
+class MarkPriceTable::SaxHandler : public nlohmann::json_sax<json> {
+public:
+    enum class Level : uint8_t { Root, Params, Data, Element, Other };
+
+    explicit SaxHandler(std::vector<Entry>& buffer) : entries(buffer), count(0) {}
+
+    bool null() override { return true; }
+    bool boolean(bool) override { return true; }
+    bool number_integer(number_integer_t value) override { return number(static_cast<double>(value), value); }
+    bool number_unsigned(number_unsigned_t value) override { return number(static_cast<double>(value), static_cast<int64_t>(value)); }
+    bool number_float(number_float_t value, const string_t&) override { return number(value, static_cast<int64_t>(value)); }
+    bool binary(binary_t&) override { return true; }
+
+    bool string(string_t& value) override {
+        const Level level = current();
+        if (level == Level::Params && lastKey == "channel") {
+            channel = value;
+        } else if (level == Level::Element && lastKey == "instrument_name") {
+            entries[count - 1].instrument.assign(value);
+        }
+        return true;
+    }
+
+    bool key(string_t& value) override {
+        lastKey.assign(value);
+        return true;
+    }
+
+    bool start_object(std::size_t) override {
+        const Level parent = stack.empty() ? Level::Other : current();
+        Level level = Level::Other;
+        if (stack.empty()) {
+            level = Level::Root;
+        } else if (parent == Level::Root && lastKey == "params") {
+            level = Level::Params;
+        } else if (parent == Level::Data) {
+            level = Level::Element;
+            if (count == entries.size()) {
+                entries.emplace_back();
+            }
+            Entry& entry = entries[count++];
+            entry.instrument.clear();
+            entry.markPrice = 0.0;
+            entry.iv = 0.0;
+            entry.timestamp = 0;
+        }
+        stack.push_back(level);
+        lastKey.clear();
+        return true;
+    }
+
+    bool end_object() override {
+        stack.pop_back();
+        return true;
+    }
+
+    bool start_array(std::size_t) override {
+        const Level parent = stack.empty() ? Level::Other : current();
+        stack.push_back(parent == Level::Params && lastKey == "data" ? Level::Data : Level::Other);
+        lastKey.clear();
+        return true;
+    }
+
+    bool end_array() override {
+        stack.pop_back();
+        return true;
+    }
+
+    bool parse_error(std::size_t, const std::string&, const nlohmann::detail::exception&) override {
+        return false;
+    }
+
+    const std::string& channelName() const { return channel; }
+    std::size_t entryCount() const { return count; }
+
+private:
+    Level current() const { return stack.back(); }
+
+    bool number(double value, int64_t integer) {
+        if (current() != Level::Element) {
+            return true;
+        }
+        Entry& entry = entries[count - 1];
+        if (lastKey == "mark_price") {
+            entry.markPrice = value;
+        } else if (lastKey == "iv") {
+            entry.iv = value;
+        } else if (lastKey == "timestamp") {
+            entry.timestamp = integer;
+        }
+        return true;
+    }
+
+    std::vector<Entry>& entries;
+    std::size_t count;
+    std::vector<Level> stack;
+    std::string lastKey;
+    std::string channel;
+};
+
+MarkPriceTable::MarkPriceTable(InstrumentRegistry& registry) : instruments(registry) {}
+
+void MarkPriceTable::setBatchHandler(BatchHandler handler) {
+    onBatch = std::move(handler);
+}
+
+/**
+ * @brief SAX-decodes a frame and stores its elements, then fires the batch handler once.
+ */
+std::size_t MarkPriceTable::decode(const std::string& message) {
+    // Cheap rejection of every other message type before running the parser
+    if (message.find(CHANNEL_PREFIX) == std::string::npos) {
+        return 0;
+    }
+
+    static thread_local std::vector<Entry> entries;
+    SaxHandler handler(entries);
+    if (!json::sax_parse(message, &handler) || handler.channelName().rfind(CHANNEL_PREFIX, 0) != 0) {
+        return 0;
+    }
+
+    updated.clear();
+    for (std::size_t i = 0; i < handler.entryCount(); ++i) {
+        const Entry& entry = entries[i];
+        if (!entry.instrument.empty()) {
+            store(entry.instrument, entry.markPrice, entry.iv, entry.timestamp);
+        }
+    }
+
+    if (onBatch && !updated.empty()) {
+        onBatch(*this, updated);
+    }
+    return updated.size();
+}
+
+void MarkPriceTable::store(const std::string& instrument, double markPrice, double iv, int64_t timestamp) {
+    const uint32_t id = instruments.intern(instrument);
+    ensureRow(id);
+    markPrices[id] = markPrice;
+    ivs[id] = iv;
+    timestamps[id] = timestamp;
+    updated.push_back(id);
+}
+
+/**
+ * @brief Grows the arrays up to an ID, parsing contract terms of every new row once.
+ */
+void MarkPriceTable::ensureRow(uint32_t id) {
+    const std::size_t oldSize = markPrices.size();
+    if (id < oldSize) {
+        return;
+    }
+
+    const std::size_t newSize = static_cast<std::size_t>(id) + 1;
+    markPrices.resize(newSize, 0.0);
+    ivs.resize(newSize, 0.0);
+    timestamps.resize(newSize, 0);
+    strikes.resize(newSize, 0.0);
+    expiries.resize(newSize, 0.0);
+    callPuts.resize(newSize, 0.0);
+    deltas.resize(newSize, 0.0);
+    vegas.resize(newSize, 0.0);
+
+    for (std::size_t row = oldSize; row < newSize; ++row) {
+        const std::string& name = instruments.name(static_cast<uint32_t>(row));
+        parseContract(name, strikes[row], callPuts[row]);
+        expiries[row] = static_cast<double>(FundingTracker::parseExpiry(name));
+    }
+}
+
+/**
+ * @brief Black-76 delta and vega over the whole table in one pass.
+ *
+ * Rows that cannot be priced (no strike, no volatility, already expired) are computed with clamped
+ * inputs and then multiplied by a 0/1 mask, which keeps the loop free of branches.
+ */
+void MarkPriceTable::updateGreeks(double underlyingPrice, int64_t nowMs) {
+    if (underlyingPrice <= 0.0) {
+        return;
+    }
+
+    const std::size_t n = markPrices.size();
+    const double forward = underlyingPrice;
+    const double now = static_cast<double>(nowMs);
+    const double* strike = strikes.data();
+    const double* expiry = expiries.data();
+    const double* vol = ivs.data();
+    const double* cp = callPuts.data();
+    double* outDelta = deltas.data();
+    double* outVega = vegas.data();
+
+    for (std::size_t i = 0; i < n; ++i) {
+        const double live = (strike[i] > 0.0 && vol[i] > 0.0 && expiry[i] > now) ? 1.0 : 0.0;
+        const double t = std::max((expiry[i] - now) / MS_PER_YEAR, 1e-9);
+        const double sqrtT = std::sqrt(t);
+        const double stdDev = std::max(vol[i], 1e-9) * sqrtT;
+        const double d1 = (std::log(forward / std::max(strike[i], 1e-9)) + 0.5 * stdDev * stdDev) / stdDev;
+        const double nd1 = 0.5 * std::erfc(-d1 * INV_SQRT_2);
+
+        outDelta[i] = live * (nd1 - 0.5 * (1.0 - cp[i]));
+        outVega[i] = live * forward * INV_SQRT_2PI * std::exp(-0.5 * d1 * d1) * sqrtT;
+    }
+}
+
+std::size_t MarkPriceTable::size() const {
+    return markPrices.size();
+}
+
+const InstrumentRegistry& MarkPriceTable::registry() const {
+    return instruments;
+}
+
+const std::vector<double>& MarkPriceTable::markPrice() const {
+    return markPrices;
+}
+
+const std::vector<double>& MarkPriceTable::iv() const {
+    return ivs;
+}
+
+const std::vector<int64_t>& MarkPriceTable::timestamp() const {
+    return timestamps;
+}
+
+const std::vector<double>& MarkPriceTable::strike() const {
+    return strikes;
+}
+
+const std::vector<double>& MarkPriceTable::expiry() const {
+    return expiries;
+}
+
+const std::vector<double>& MarkPriceTable::callPut() const {
+    return callPuts;
+}
+
+const std::vector<double>& MarkPriceTable::delta() const {
+    return deltas;
+}
+
+const std::vector<double>& MarkPriceTable::vega() const {
+    return vegas;
+}
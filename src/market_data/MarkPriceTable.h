@@ -0,0 +1,127 @@
+#ifndef MARK_PRICE_TABLE_H
+#define MARK_PRICE_TABLE_H
+
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include <functional>
+#include "InstrumentRegistry.h"
+
+/**
+ * @file MarkPriceTable.h
+ *
+ * @brief Defines the `MarkPriceTable` class, a bulk decoder for `markprice.options.{index_name}`
+ *        frames that writes straight into structure-of-arrays storage.
+ *
+ * A single `markprice.options` notification carries the mark price and implied volatility of every
+ * option on an index. Building a JSON DOM for such a frame and fanning it out through one callback
+ * per instrument is wasteful, so this decoder walks the frame with a SAX parser, stores each entry
+ * into arrays indexed by interned instrument ID, and then fires one batch callback for the whole
+ * frame. Downstream analytics (e.g., `updateGreeks`) run as a single loop over contiguous arrays.
+ *
+ * ### Key Responsibilities:
+ * - Decode bulk mark price frames without building a JSON DOM.
+ * - Keep per-instrument data in dense arrays indexed by `InstrumentRegistry` IDs.
+ * - Notify consumers once per frame with the list of updated IDs.
+ */
+
+/**
+ * @class MarkPriceTable
+ *
+ * @brief Structure-of-arrays table of option mark prices, implied volatilities and Greeks.
+ *
+ * ### Example:
+ * ```
+ * InstrumentRegistry registry;
+ * MarkPriceTable table(registry);
+ * table.setBatchHandler([&](const MarkPriceTable&, const std::vector<uint32_t>& updated) {
+ *     table.updateGreeks(indexPrice, nowMs); // one vectorized pass per frame
+ * });
+ * // For every incoming WebSocket message:
+ * table.decode(message);
+ * ```
+ */
+class MarkPriceTable {
+public:
+    /**
+     * @brief Callback invoked once per decoded frame.
+     *
+     * The second argument lists the IDs updated by the frame, in frame order.
+     */
+    using BatchHandler = std::function<void(const MarkPriceTable&, const std::vector<uint32_t>&)>;
+
+    /**
+     * @brief Constructs a table bound to an instrument registry.
+     *
+     * @param registry The registry used to intern instrument names; it must outlive the table.
+     */
+    explicit MarkPriceTable(InstrumentRegistry& registry);
+
+    /** @brief Sets the callback invoked after each decoded frame. */
+    void setBatchHandler(BatchHandler handler);
+
+    /**
+     * @brief Decodes a raw WebSocket message if it is a `markprice.options.*` notification.
+     *
+     * @param message The raw message text.
+     * @return The number of entries written, or 0 if the message is not a mark price frame.
+     *
+     * ### Workflow:
+     * 1. SAX-parse the message, capturing `instrument_name`, `mark_price`, `iv` and `timestamp` of
+     *    each element of `params.data`.
+     * 2. Write each element into the arrays at its interned ID.
+     * 3. Invoke the batch handler once with the updated IDs.
+     */
+    std::size_t decode(const std::string& message);
+
+    /**
+     * @brief Recomputes Black-76 delta and vega for every option in the table.
+     *
+     * @param underlyingPrice The forward/index price of the underlying.
+     * @param nowMs The current time in milliseconds since the epoch.
+     *
+     * The loop reads and writes only contiguous arrays and has no data-dependent branches, so the
+     * compiler can vectorize it.
+     */
+    void updateGreeks(double underlyingPrice, int64_t nowMs);
+
+    /** @brief Returns the number of rows (equal to the registry size when last grown). */
+    std::size_t size() const;
+
+    /** @brief Returns the registry used for interning. */
+    const InstrumentRegistry& registry() const;
+
+    const std::vector<double>& markPrice() const; /**< Mark prices (in units of the underlying). */
+    const std::vector<double>& iv() const;        /**< Implied volatilities (fractions, e.g. 0.55). */
+    const std::vector<int64_t>& timestamp() const; /**< Exchange timestamps (ms). */
+    const std::vector<double>& strike() const;    /**< Strikes parsed from the instrument names. */
+    const std::vector<double>& expiry() const;    /**< Expirations (ms since epoch). */
+    const std::vector<double>& callPut() const;   /**< +1 for calls, -1 for puts. */
+    const std::vector<double>& delta() const;     /**< Black-76 delta from the last `updateGreeks`. */
+    const std::vector<double>& vega() const;      /**< Black-76 vega (per 1.00 vol) from the last `updateGreeks`. */
+
+private:
+    class SaxHandler;
+
+    /** @brief Grows all arrays to cover an ID and parses its contract terms on first sight. */
+    void ensureRow(uint32_t id);
+
+    /** @brief Writes one decoded element into its row. */
+    void store(const std::string& instrument, double markPrice, double iv, int64_t timestamp);
+
+    InstrumentRegistry& instruments;  /**< Name interning shared with other components. */
+    BatchHandler onBatch;             /**< Per-frame callback. */
+    std::vector<uint32_t> updated;    /**< IDs updated by the current frame (reused between frames). */
+
+    std::vector<double> markPrices;
+    std::vector<double> ivs;
+    std::vector<int64_t> timestamps;
+    std::vector<double> strikes;
+    std::vector<double> expiries;
+    std::vector<double> callPuts;
+    std::vector<double> deltas;
+    std::vector<double> vegas;
+};
+
+#endif // MARK_PRICE_TABLE_H
@@ -93,3 +93,99 @@ std::string MarketDataManager::getOrderBook(const std::string& instrument) {
         return R"({"error": "An exception occurred: )" + std::string(e.what()) + R"("})";
     }
 }
+
+/**
+ * @brief Performs a public GET request and returns the response as compact JSON.
+ *
+ * @param url The full request URL.
+ * @return The compact JSON response, or an error message in case of failure.
+ *
+ * ### Error Handling:
+ * - Handles network errors and malformed responses the same way as `getOrderBook`.
+ */
+static std::string fetchCompact(const std::string& url) {
+    CURL* curl = curl_easy_init();
+    std::string response;
+
+    if (!curl) {
+        return R"({"error": "Failed to initialize CURL"})";
+    }
+
+    try {
+        curl_easy_setopt(curl, CURLOPT_URL, url.c_str());
+        curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, WriteCallback);
+        curl_easy_setopt(curl, CURLOPT_WRITEDATA, &response);
+
+        CURLcode res = curl_easy_perform(curl);
+        curl_easy_cleanup(curl);
+
+        if (res != CURLE_OK) {
+            return R"({"error": "CURL error: )" + std::string(curl_easy_strerror(res)) + R"("})";
+        }
+
+        if (response.empty()) {
+            return R"({"error": "Empty response received from the server"})";
+        }
+
+        try {
+            json parsedResponse = json::parse(response);
+
+            if (parsedResponse.contains("error")) {
+                return R"({"error": ")" + parsedResponse["error"]["message"].get<std::string>() + R"("})";
+            }
+
+            return parsedResponse.dump();
+        } catch (const json::parse_error& e) {
+            return R"({"error": "Failed to parse JSON response: )" + std::string(e.what()) + R"("})";
+        }
+
+    } catch (const std::exception& e) {
+        return R"({"error": "An exception occurred: )" + std::string(e.what()) + R"("})";
+    }
+}
+
+/**
+ * @brief Fetches instrument metadata for a currency and kind, with error handling.
+ *
+ * @param currency The currency (e.g., "BTC").
+ * @param kind The instrument kind, or an empty string for all kinds.
+ * @return A compact JSON string containing the API response or an error message in case of failure.
+ *
+ * ### Error Handling:
+ * - Validates the currency.
+ * - Network and parsing errors are handled by `fetchCompact`.
+ */
+std::string MarketDataManager::getInstruments(const std::string& currency, const std::string& kind) {
+    if (currency.empty()) {
+        return R"({"error": "Currency is required"})";
+    }
+
+    std::string url = "https://test.deribit.com/api/v2/public/get_instruments?currency=" + currency;
+    if (!kind.empty()) {
+        url += "&kind=" + kind;
+    }
+    return fetchCompact(url);
+}
+
+/**
+ * @brief Fetches the book summaries of all instruments of a currency and kind, with error handling.
+ *
+ * @param currency The currency (e.g., "BTC").
+ * @param kind The instrument kind, or an empty string for all kinds.
+ * @return A compact JSON string containing the API response or an error message in case of failure.
+ *
+ * ### Error Handling:
+ * - Validates the currency.
+ * - Network and parsing errors are handled by `fetchCompact`.
+ */
+std::string MarketDataManager::getBookSummaryByCurrency(const std::string& currency, const std::string& kind) {
+    if (currency.empty()) {
+        return R"({"error": "Currency is required"})";
+    }
+
+    std::string url = "https://test.deribit.com/api/v2/public/get_book_summary_by_currency?currency=" + currency;
+    if (!kind.empty()) {
+        url += "&kind=" + kind;
+    }
+    return fetchCompact(url);
+}
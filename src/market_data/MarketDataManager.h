@@ -58,6 +58,49 @@ public:
      * - Adding methods for more granular data, such as trade history or price trends.
      */
     std::string getOrderBook(const std::string& instrument);
+
+    /**
+     * @brief Fetches the metadata of all active instruments of a currency and kind.
+     *
+     * @param currency The currency (e.g., "BTC", "ETH").
+     * @param kind The instrument kind ("future", "option", ...), or an empty string for all kinds.
+     * @return A JSON-formatted string containing the `public/get_instruments` response, or an error
+     *         message in case of failure.
+     *
+     * ### Example:
+     * ```
+     * MarketDataManager manager;
+     * std::string options = manager.getInstruments("BTC", "option");
+     * ```
+     *
+     * ### Responsibilities:
+     * - Provides strikes, expiries, tick sizes and contract sizes used to build option chains and
+     *   to expand group subscriptions.
+     * - The response is returned compact (not indented) since it can list thousands of instruments.
+     */
+    std::string getInstruments(const std::string& currency, const std::string& kind = "");
+
+    /**
+     * @brief Fetches the book summary (best bid/ask, mark, last, volume, open interest) of every
+     *        instrument of a currency and kind in a single request.
+     *
+     * @param currency The currency (e.g., "BTC", "ETH").
+     * @param kind The instrument kind ("future", "option", ...), or an empty string for all kinds.
+     * @return A JSON-formatted string containing the `public/get_book_summary_by_currency` response,
+     *         or an error message in case of failure.
+     *
+     * ### Example:
+     * ```
+     * MarketDataManager manager;
+     * TopOfBookCache cache;
+     * cache.applySummary(json::parse(manager.getBookSummaryByCurrency("BTC", "option")));
+     * ```
+     *
+     * ### Responsibilities:
+     * - Replaces one `getOrderBook` call per instrument for screens and periodic reconciliation.
+     * - The response is returned compact (not indented) since it can list thousands of instruments.
+     */
+    std::string getBookSummaryByCurrency(const std::string& currency, const std::string& kind = "");
 };
 
 #endif // MARKET_DATA_MANAGER_H
@@ -0,0 +1,124 @@
+#include "MicrostructureSignals.h"
+#include <algorithm>
+#include <cmath>
+
+/**
+ * @file MicrostructureSignals.cpp
+ *
+ * @brief Implements the `MicrostructureSignals` class, which refreshes per-instrument order book
+ *        signals after each book update.
+ */
+
+MicrostructureSignals::MicrostructureSignals(std::size_t depth, double depletionHalfLifeMs)
+    : depth(std::max<std::size_t>(depth, 1)),
+      decayTauMs(std::max(depletionHalfLifeMs, 1.0) / std::log(2.0)) {}
+
+/**
+ * @brief Recomputes every signal of the book's instrument.
+ *
+ * ### Workflow:
+ * 1. Read the top of book and derive microprice and spread.
+ * 2. Walk at most `depth` levels per side to accumulate depth, notional and rank-weighted depth.
+ * 3. Decay the depletion accumulators by the time elapsed since the previous update and add the
+ *    amount consumed from each best queue.
+ */
+const BookSignals& MicrostructureSignals::update(const OrderBook& book) {
+    Entry& entry = entries[book.instrument()];
+    BookSignals& s = entry.signals;
+
+    const auto& bids = book.bids();
+    const auto& asks = book.asks();
+
+    // Decay factor for the depletion accumulators, based on exchange time
+    const int64_t now = book.timestamp();
+    double decay = 1.0;
+    if (s.timestamp != 0 && now > s.timestamp) {
+        decay = std::exp(-static_cast<double>(now - s.timestamp) / decayTauMs);
+    }
+
+    if (!bids.empty() && !asks.empty()) {
+        const PriceLevel& bid = bids.front();
+        const PriceLevel& ask = asks.front();
+        const double topSize = bid.amount + ask.amount;
+
+        s.microprice = topSize > 0.0
+            ? (bid.price * ask.amount + ask.price * bid.amount) / topSize
+            : (bid.price + ask.price) / 2.0;
+        s.spreadTicks = book.tickSize() > 0.0 ? (ask.price - bid.price) / book.tickSize() : 0.0;
+    }
+
+    double bidDepth = 0.0, askDepth = 0.0;
+    double bidNotional = 0.0, askNotional = 0.0;
+    double bidPressure = 0.0, askPressure = 0.0;
+
+    const std::size_t bidCount = std::min(depth, bids.size());
+    for (std::size_t i = 0; i < bidCount; ++i) {
+        bidDepth += bids[i].amount;
+        bidNotional += bids[i].amount * bids[i].price;
+        bidPressure += bids[i].amount / static_cast<double>(i + 1);
+    }
+
+    const std::size_t askCount = std::min(depth, asks.size());
+    for (std::size_t i = 0; i < askCount; ++i) {
+        askDepth += asks[i].amount;
+        askNotional += asks[i].amount * asks[i].price;
+        askPressure += asks[i].amount / static_cast<double>(i + 1);
+    }
+
+    const double totalDepth = bidDepth + askDepth;
+    s.imbalance = totalDepth > 0.0 ? (bidDepth - askDepth) / totalDepth : 0.0;
+
+    const double totalPressure = bidPressure + askPressure;
+    s.bookPressure = totalPressure > 0.0 ? (bidPressure - askPressure) / totalPressure : 0.0;
+
+    if (bidDepth > 0.0 && askDepth > 0.0) {
+        // Cross-weight each side's VWAP by the opposite side's depth, as the microprice does at L1
+        const double bidVwap = bidNotional / bidDepth;
+        const double askVwap = askNotional / askDepth;
+        s.weightedMid = (bidVwap * askDepth + askVwap * bidDepth) / totalDepth;
+    }
+
+    s.bidDepletionRate = updateQueue(entry.bidQueue, bids, true, decay);
+    s.askDepletionRate = updateQueue(entry.askQueue, asks, false, decay);
+    s.timestamp = now;
+
+    return s;
+}
+
+/**
+ * @brief Accounts for the amount consumed from the best queue of one side.
+ *
+ * ### Rules:
+ * - Same best price: any decrease in size counts as depletion, increases are ignored.
+ * - Best price moved away from the spread: the whole previous queue was depleted.
+ * - Best price improved: a new queue formed in front, nothing was depleted.
+ */
+double MicrostructureSignals::updateQueue(QueueState& queue, const std::vector<PriceLevel>& levels, bool isBid, double decay) {
+    const double price = levels.empty() ? 0.0 : levels.front().price;
+    const double amount = levels.empty() ? 0.0 : levels.front().amount;
+
+    double depleted = 0.0;
+    if (queue.amount > 0.0) {
+        if (price == queue.price) {
+            depleted = std::max(0.0, queue.amount - amount);
+        } else if (levels.empty() || (isBid ? price < queue.price : price > queue.price)) {
+            depleted = queue.amount;
+        }
+    }
+
+    queue.accumulator = queue.accumulator * decay + depleted;
+    queue.price = price;
+    queue.amount = amount;
+
+    // The steady-state value of the accumulator is rate * tau, so divide by tau (in seconds)
+    return queue.accumulator / (decayTauMs / 1000.0);
+}
+
+const BookSignals* MicrostructureSignals::get(const std::string& instrument) const {
+    auto it = entries.find(instrument);
+    return it == entries.end() ? nullptr : &it->second.signals;
+}
+
+void MicrostructureSignals::reset(const std::string& instrument) {
+    entries.erase(instrument);
+}
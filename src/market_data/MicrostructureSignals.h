@@ -0,0 +1,135 @@
+#ifndef MICROSTRUCTURE_SIGNALS_H
+#define MICROSTRUCTURE_SIGNALS_H
+
+#include <string>
+#include <cstdint>
+#include <cstddef>
+#include <unordered_map>
+#include "OrderBook.h"
+
+/**
+ * @file MicrostructureSignals.h
+ *
+ * @brief Defines a library of order book microstructure signals that are maintained incrementally
+ *        on every book update.
+ *
+ * Strategies typically need the same handful of derived quantities on every tick (microprice,
+ * imbalance, spread, ...). Rather than recomputing them from raw frames, `MicrostructureSignals`
+ * refreshes them once per book delta and stores the results in a cache-line-aligned struct per
+ * instrument, so readers get all signals with a single cache line fetch.
+ *
+ * ### Signals:
+ * - **Microprice**: size-weighted mid at the top of book, `(bid * askSize + ask * bidSize) / (bidSize + askSize)`.
+ * - **Weighted mid**: the same formula applied to the VWAPs and total sizes of the top N levels.
+ * - **Imbalance**: `(bidDepth - askDepth) / (bidDepth + askDepth)` over the top N levels, in [-1, 1].
+ * - **Spread in ticks**: `(bestAsk - bestBid) / tickSize`.
+ * - **Book pressure**: like imbalance, but each level is weighted by `1 / (rank + 1)` so liquidity
+ *   close to the touch counts more.
+ * - **Queue depletion rate**: exponentially decayed rate (contracts per second) at which the best
+ *   bid and best ask queues are being consumed or cancelled.
+ */
+
+/**
+ * @struct BookSignals
+ *
+ * @brief The latest signal values for one instrument, packed into a single cache line.
+ */
+struct alignas(64) BookSignals {
+    double microprice{0.0};        /**< Top-of-book size-weighted mid. */
+    double weightedMid{0.0};       /**< Size-weighted mid over the top N levels. */
+    double imbalance{0.0};         /**< Top-N depth imbalance in [-1, 1]. */
+    double spreadTicks{0.0};       /**< Spread in ticks, or 0 if the tick size is unknown. */
+    double bookPressure{0.0};      /**< Rank-weighted top-N imbalance in [-1, 1]. */
+    double bidDepletionRate{0.0};  /**< Best bid queue depletion rate (contracts per second). */
+    double askDepletionRate{0.0};  /**< Best ask queue depletion rate (contracts per second). */
+    int64_t timestamp{0};          /**< Exchange timestamp (ms) of the book update that produced these values. */
+};
+
+static_assert(sizeof(BookSignals) == 64, "BookSignals must occupy exactly one cache line");
+
+/**
+ * @class MicrostructureSignals
+ *
+ * @brief Maintains `BookSignals` for every instrument whose book is fed to it.
+ *
+ * ### Complexity:
+ * Each call to `update` reads at most `depth` levels per side and performs a constant amount of
+ * bookkeeping, so the cost per book delta is O(depth), i.e. O(1) for a fixed configuration.
+ *
+ * ### Example:
+ * ```
+ * MicrostructureSignals signals(5);
+ * if (book.applyUpdate(data)) {
+ *     const BookSignals& s = signals.update(book);
+ *     std::cout << "Microprice: " << s.microprice << std::endl;
+ * }
+ * ```
+ */
+class MicrostructureSignals {
+public:
+    /**
+     * @brief Constructs the signal library.
+     *
+     * @param depth The number of levels per side used by the top-N signals.
+     * @param depletionHalfLifeMs The half-life, in milliseconds, of the queue depletion rate decay.
+     */
+    explicit MicrostructureSignals(std::size_t depth = 5, double depletionHalfLifeMs = 1000.0);
+
+    /**
+     * @brief Refreshes the signals of a book after an update has been applied to it.
+     *
+     * @param book The updated order book.
+     * @return A reference to the refreshed signals. The reference stays valid until the
+     *         instrument is `reset`.
+     */
+    const BookSignals& update(const OrderBook& book);
+
+    /**
+     * @brief Retrieves the latest signals of an instrument.
+     *
+     * @param instrument The instrument name.
+     * @return A pointer to the signals, or nullptr if no update has been seen for the instrument.
+     */
+    const BookSignals* get(const std::string& instrument) const;
+
+    /**
+     * @brief Forgets the state of an instrument (e.g., after its book was invalidated).
+     *
+     * @param instrument The instrument name.
+     */
+    void reset(const std::string& instrument);
+
+private:
+    /**
+     * @struct QueueState
+     * @brief Previous best level and decayed depletion accumulator for one side of a book.
+     */
+    struct QueueState {
+        double price{0.0};       /**< Best price seen at the previous update. */
+        double amount{0.0};      /**< Best level amount seen at the previous update. */
+        double accumulator{0.0}; /**< Exponentially decayed depleted amount. */
+    };
+
+    /**
+     * @struct Entry
+     * @brief Hot signal values followed by the colder bookkeeping state used to derive them.
+     */
+    struct Entry {
+        BookSignals signals;
+        QueueState bidQueue;
+        QueueState askQueue;
+    };
+
+    /**
+     * @brief Folds one side's top-of-book change into its depletion accumulator.
+     *
+     * @return The refreshed depletion rate in contracts per second.
+     */
+    double updateQueue(QueueState& queue, const std::vector<PriceLevel>& levels, bool isBid, double decay);
+
+    std::size_t depth;          /**< Number of levels per side used by the top-N signals. */
+    double decayTauMs;          /**< Time constant of the depletion decay, derived from the half-life. */
+    std::unordered_map<std::string, Entry> entries; /**< Per-instrument state; node storage keeps references stable. */
+};
+
+#endif // MICROSTRUCTURE_SIGNALS_H
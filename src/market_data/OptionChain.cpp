@@ -0,0 +1,243 @@
+#include "OptionChain.h"
+#include <algorithm>
+#include <cmath>
+#include <map>
+#include <utility>
+#include <nlohmann/json.hpp>
+
+using json = nlohmann::json;
+
+/**
+ * @file OptionChain.cpp
+ *
+ * @brief Implements the `OptionChain` class, which indexes listed options by underlying, expiry,
+ *        strike and type and stores their market data as structure-of-arrays per expiry.
+ */
+
+void OptionSeries::resize(std::size_t count) {
+    names.assign(count, std::string());
+    listed.assign(count, 0);
+    bid.assign(count, 0.0);
+    ask.assign(count, 0.0);
+    mark.assign(count, 0.0);
+    markIv.assign(count, 0.0);
+    delta.assign(count, 0.0);
+    gamma.assign(count, 0.0);
+    vega.assign(count, 0.0);
+    theta.assign(count, 0.0);
+    openInterest.assign(count, 0.0);
+}
+
+/**
+ * @brief Builds the chain from instrument metadata.
+ *
+ * ### Workflow:
+ * 1. Group options by (underlying, expiry) and collect each group's distinct strikes.
+ * 2. Allocate one `OptionExpiry` per group with arrays sized to its strike count.
+ * 3. Record a `Locator` per instrument name so tickers can be applied without searching.
+ * 4. Carry the market data of options that were already indexed over from the previous chain.
+ */
+std::size_t OptionChain::load(const json& instruments) {
+    const std::vector<OptionExpiry> previousSlices = std::move(slices);
+    const std::unordered_map<std::string, Locator> previousLocators = std::move(locators);
+    slices.clear();
+    byUnderlying.clear();
+    locators.clear();
+
+    // (underlying, expiry) -> options of that expiry; std::map keeps expiries ordered per underlying
+    struct Listing {
+        std::string name;
+        double strike;
+        OptionType type;
+    };
+    std::map<std::pair<std::string, int64_t>, std::vector<Listing>> groups;
+
+    for (const auto& instrument : instruments) {
+        if (instrument.value("kind", "") != "option") {
+            continue;
+        }
+        Listing listing{instrument.value("instrument_name", ""),
+                        instrument.value("strike", 0.0),
+                        instrument.value("option_type", "") == "put" ? OptionType::Put : OptionType::Call};
+        groups[{instrument.value("base_currency", ""), instrument.value("expiration_timestamp", int64_t{0})}].push_back(listing);
+    }
+
+    slices.reserve(groups.size());
+    std::size_t count = 0;
+
+    for (auto& group : groups) {
+        OptionExpiry slice;
+        slice.underlying = group.first.first;
+        slice.expiry = group.first.second;
+
+        for (const auto& listing : group.second) {
+            slice.strikes.push_back(listing.strike);
+        }
+        std::sort(slice.strikes.begin(), slice.strikes.end());
+        slice.strikes.erase(std::unique(slice.strikes.begin(), slice.strikes.end()), slice.strikes.end());
+        slice.calls.resize(slice.strikes.size());
+        slice.puts.resize(slice.strikes.size());
+
+        const auto expiryIndex = static_cast<uint32_t>(slices.size());
+        for (const auto& listing : group.second) {
+            const auto strikeIndex = static_cast<uint32_t>(
+                std::lower_bound(slice.strikes.begin(), slice.strikes.end(), listing.strike) - slice.strikes.begin());
+            OptionSeries& series = listing.type == OptionType::Call ? slice.calls : slice.puts;
+            series.names[strikeIndex] = listing.name;
+            series.listed[strikeIndex] = 1;
+            locators[listing.name] = Locator{expiryIndex, strikeIndex, listing.type};
+            ++count;
+
+            auto previous = previousLocators.find(listing.name);
+            if (previous != previousLocators.end()) {
+                const OptionExpiry& old = previousSlices[previous->second.expiry];
+                copyRow(listing.type == OptionType::Call ? old.calls : old.puts, previous->second.strike, series, strikeIndex);
+                slice.underlyingPrice = old.underlyingPrice;
+            }
+        }
+        updateAtm(slice);
+
+        byUnderlying[slice.underlying].push_back(slices.size());
+        slices.push_back(std::move(slice));
+    }
+
+    return count;
+}
+
+void OptionChain::copyRow(const OptionSeries& from, std::size_t fromIndex, OptionSeries& to, std::size_t toIndex) {
+    to.bid[toIndex] = from.bid[fromIndex];
+    to.ask[toIndex] = from.ask[fromIndex];
+    to.mark[toIndex] = from.mark[fromIndex];
+    to.markIv[toIndex] = from.markIv[fromIndex];
+    to.delta[toIndex] = from.delta[fromIndex];
+    to.gamma[toIndex] = from.gamma[fromIndex];
+    to.vega[toIndex] = from.vega[fromIndex];
+    to.theta[toIndex] = from.theta[fromIndex];
+    to.openInterest[toIndex] = from.openInterest[fromIndex];
+}
+
+/**
+ * @brief Writes a ticker payload into the SoA slots of its option.
+ */
+bool OptionChain::onTicker(const json& data) {
+    auto it = locators.find(data.value("instrument_name", ""));
+    if (it == locators.end()) {
+        return false;
+    }
+
+    const Locator& locator = it->second;
+    OptionExpiry& slice = slices[locator.expiry];
+    OptionSeries& series = locator.type == OptionType::Call ? slice.calls : slice.puts;
+    const std::size_t i = locator.strike;
+
+    series.bid[i] = data.value("best_bid_price", series.bid[i]);
+    series.ask[i] = data.value("best_ask_price", series.ask[i]);
+    series.mark[i] = data.value("mark_price", series.mark[i]);
+    series.markIv[i] = data.value("mark_iv", series.markIv[i]);
+    series.openInterest[i] = data.value("open_interest", series.openInterest[i]);
+
+    if (data.contains("greeks")) {
+        const json& greeks = data["greeks"];
+        series.delta[i] = greeks.value("delta", series.delta[i]);
+        series.gamma[i] = greeks.value("gamma", series.gamma[i]);
+        series.vega[i] = greeks.value("vega", series.vega[i]);
+        series.theta[i] = greeks.value("theta", series.theta[i]);
+    }
+
+    const double underlyingPrice = data.value("underlying_price", 0.0);
+    if (underlyingPrice > 0.0 && underlyingPrice != slice.underlyingPrice) {
+        slice.underlyingPrice = underlyingPrice;
+        updateAtm(slice);
+    }
+
+    return true;
+}
+
+/**
+ * @brief Picks the strike closest to the underlying price.
+ *
+ * This runs only when the underlying moves, so reading the ATM strike stays O(1).
+ */
+void OptionChain::updateAtm(OptionExpiry& slice) {
+    if (slice.strikes.empty()) {
+        return;
+    }
+
+    auto it = std::lower_bound(slice.strikes.begin(), slice.strikes.end(), slice.underlyingPrice);
+    std::size_t index = static_cast<std::size_t>(it - slice.strikes.begin());
+    if (index == slice.strikes.size()) {
+        index = slice.strikes.size() - 1;
+    } else if (index > 0 &&
+               std::abs(slice.strikes[index - 1] - slice.underlyingPrice) <= std::abs(slice.strikes[index] - slice.underlyingPrice)) {
+        --index;
+    }
+    slice.atmIndex = index;
+}
+
+const OptionChain::Locator* OptionChain::find(const std::string& instrument) const {
+    auto it = locators.find(instrument);
+    return it == locators.end() ? nullptr : &it->second;
+}
+
+bool OptionChain::find(const std::string& underlying, int64_t expiry, double strike, OptionType type, Locator& out) const {
+    const std::vector<std::size_t>& indices = expiries(underlying);
+    auto e = std::lower_bound(indices.begin(), indices.end(), expiry,
+                              [this](std::size_t index, int64_t value) { return slices[index].expiry < value; });
+    if (e == indices.end() || slices[*e].expiry != expiry) {
+        return false;
+    }
+
+    const OptionExpiry& slice = slices[*e];
+    auto k = std::lower_bound(slice.strikes.begin(), slice.strikes.end(), strike);
+    if (k == slice.strikes.end() || *k != strike) {
+        return false;
+    }
+
+    const auto strikeIndex = static_cast<std::size_t>(k - slice.strikes.begin());
+    const OptionSeries& s = type == OptionType::Call ? slice.calls : slice.puts;
+    if (!s.listed[strikeIndex]) {
+        return false;
+    }
+
+    out = Locator{static_cast<uint32_t>(*e), static_cast<uint32_t>(strikeIndex), type};
+    return true;
+}
+
+const std::vector<std::size_t>& OptionChain::expiries(const std::string& underlying) const {
+    static const std::vector<std::size_t> none;
+    auto it = byUnderlying.find(underlying);
+    return it == byUnderlying.end() ? none : it->second;
+}
+
+const OptionExpiry& OptionChain::expiry(std::size_t index) const {
+    return slices.at(index);
+}
+
+std::size_t OptionChain::expiryCount() const {
+    return slices.size();
+}
+
+bool OptionChain::neighbor(Locator& locator, int step) const {
+    const OptionExpiry& slice = slices.at(locator.expiry);
+    const long target = static_cast<long>(locator.strike) + step;
+    if (target < 0 || target >= static_cast<long>(slice.strikes.size())) {
+        return false;
+    }
+
+    const OptionSeries& s = locator.type == OptionType::Call ? slice.calls : slice.puts;
+    if (!s.listed[static_cast<std::size_t>(target)]) {
+        return false;
+    }
+
+    locator.strike = static_cast<uint32_t>(target);
+    return true;
+}
+
+OptionChain::Locator OptionChain::atm(std::size_t expiryIndex, OptionType type) const {
+    return Locator{static_cast<uint32_t>(expiryIndex), static_cast<uint32_t>(slices.at(expiryIndex).atmIndex), type};
+}
+
+const OptionSeries& OptionChain::series(const Locator& locator) const {
+    const OptionExpiry& slice = slices.at(locator.expiry);
+    return locator.type == OptionType::Call ? slice.calls : slice.puts;
+}
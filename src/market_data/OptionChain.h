@@ -0,0 +1,192 @@
+#ifndef OPTION_CHAIN_H
+#define OPTION_CHAIN_H
+
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include <unordered_map>
+#include <nlohmann/json_fwd.hpp>
+
+/**
+ * @file OptionChain.h
+ *
+ * @brief Defines the `OptionChain` class, an in-memory index of listed options keyed by underlying,
+ *        expiry, strike and call/put.
+ *
+ * The chain is built from the `result` array of `public/get_instruments` (kind `option`) and kept
+ * current from `ticker.*` notifications. Market data is stored as a structure of arrays per expiry:
+ * every field (bid, ask, mark IV, delta, ...) is a contiguous `std::vector<double>` indexed by
+ * strike, so pricing and risk code can sweep a whole expiry with tight, vectorizable loops.
+ *
+ * ### Key Responsibilities:
+ * - Map opaque instrument names ("BTC-27DEC24-60000-C") to (expiry, strike, type) coordinates.
+ * - Provide O(1) neighbor lookups (adjacent strikes) and an O(1) ATM strike read per expiry.
+ * - Apply ticker updates without any per-update allocation.
+ */
+
+/**
+ * @struct OptionSeries
+ *
+ * @brief Structure-of-arrays market data for one option type (calls or puts) of an expiry.
+ *
+ * All vectors are indexed by strike index and have the same length as `OptionExpiry::strikes`.
+ * Strikes where the option type is not listed have `listed[i] == 0`.
+ */
+struct OptionSeries {
+    std::vector<std::string> names;   /**< Instrument names (empty if not listed). */
+    std::vector<uint8_t> listed;      /**< 1 if the option is listed at this strike. */
+    std::vector<double> bid;          /**< Best bid price. */
+    std::vector<double> ask;          /**< Best ask price. */
+    std::vector<double> mark;         /**< Mark price. */
+    std::vector<double> markIv;       /**< Mark implied volatility. */
+    std::vector<double> delta;        /**< Delta. */
+    std::vector<double> gamma;        /**< Gamma. */
+    std::vector<double> vega;         /**< Vega. */
+    std::vector<double> theta;        /**< Theta. */
+    std::vector<double> openInterest; /**< Open interest. */
+
+    /** @brief Resizes every array to `count` strikes. */
+    void resize(std::size_t count);
+};
+
+/**
+ * @struct OptionExpiry
+ *
+ * @brief All strikes of one underlying and expiry.
+ */
+struct OptionExpiry {
+    std::string underlying;       /**< The base currency (e.g., "BTC"). */
+    int64_t expiry{0};            /**< Expiration timestamp in milliseconds. */
+    std::vector<double> strikes;  /**< Strikes in ascending order. */
+    OptionSeries calls;           /**< Call market data, indexed like `strikes`. */
+    OptionSeries puts;            /**< Put market data, indexed like `strikes`. */
+    double underlyingPrice{0.0};  /**< Latest underlying (forward) price reported by tickers. */
+    std::size_t atmIndex{0};      /**< Index of the strike closest to `underlyingPrice`. */
+};
+
+/**
+ * @class OptionChain
+ *
+ * @brief Option chain index with per-expiry structure-of-arrays storage.
+ *
+ * ### Example:
+ * ```
+ * OptionChain chain;
+ * chain.load(json::parse(marketDataManager.getInstruments("BTC", "option"))["result"]);
+ * chain.onTicker(notification["params"]["data"]);
+ *
+ * for (std::size_t e : chain.expiries("BTC")) {
+ *     const OptionExpiry& slice = chain.expiry(e);
+ *     std::cout << "ATM strike: " << slice.strikes[slice.atmIndex] << std::endl;
+ * }
+ * ```
+ */
+class OptionChain {
+public:
+    /**
+     * @enum OptionType
+     * @brief Call or put.
+     */
+    enum class OptionType : uint8_t {
+        Call, /**< A call option. */
+        Put   /**< A put option. */
+    };
+
+    /**
+     * @struct Locator
+     * @brief Coordinates of one option within the chain.
+     */
+    struct Locator {
+        uint32_t expiry{0};            /**< Index into the chain's expiries. */
+        uint32_t strike{0};            /**< Index into the expiry's strikes. */
+        OptionType type{OptionType::Call}; /**< Call or put. */
+    };
+
+    /**
+     * @brief Rebuilds the chain from a `public/get_instruments` result array.
+     *
+     * @param instruments The `result` array; non-option entries are ignored.
+     * @return The number of options indexed.
+     *
+     * Call this again after new listings to re-index. Options that were already indexed keep their
+     * market data (moved to their new coordinates); delisted options are dropped.
+     */
+    std::size_t load(const nlohmann::json& instruments);
+
+    /**
+     * @brief Applies an option `ticker.*` notification payload.
+     *
+     * @param data The notification `data` object.
+     * @return True if the instrument belongs to the chain and was updated.
+     */
+    bool onTicker(const nlohmann::json& data);
+
+    /**
+     * @brief Looks up the coordinates of an option by name.
+     *
+     * @param instrument The option instrument name.
+     * @return A pointer to the locator, or nullptr if the option is not in the chain.
+     */
+    const Locator* find(const std::string& instrument) const;
+
+    /**
+     * @brief Looks up the coordinates of an option by (underlying, expiry, strike, type).
+     *
+     * @param underlying The base currency (e.g., "BTC").
+     * @param expiry The expiration timestamp in milliseconds.
+     * @param strike The strike price.
+     * @param type Call or put.
+     * @param out Receives the coordinates if the option is listed.
+     * @return True if the option is in the chain.
+     *
+     * Binary searches the underlying's expiries, then the expiry's strikes.
+     */
+    bool find(const std::string& underlying, int64_t expiry, double strike, OptionType type, Locator& out) const;
+
+    /**
+     * @brief Returns the expiry indices of an underlying, ordered by expiration.
+     *
+     * @param underlying The base currency (e.g., "BTC").
+     */
+    const std::vector<std::size_t>& expiries(const std::string& underlying) const;
+
+    /** @brief Returns the expiry slice at an index obtained from `expiries` or a `Locator`. */
+    const OptionExpiry& expiry(std::size_t index) const;
+
+    /** @brief Returns the number of expiries across all underlyings. */
+    std::size_t expiryCount() const;
+
+    /**
+     * @brief Moves a locator to a neighboring strike of the same expiry and type.
+     *
+     * @param locator The locator to move.
+     * @param step The number of strikes to move (negative for lower strikes).
+     * @return True if the target strike exists and is listed for that type.
+     */
+    bool neighbor(Locator& locator, int step) const;
+
+    /**
+     * @brief Returns a locator for the ATM strike of an expiry.
+     *
+     * @param expiryIndex The expiry index.
+     * @param type Call or put.
+     */
+    Locator atm(std::size_t expiryIndex, OptionType type) const;
+
+    /** @brief Returns the series (calls or puts) addressed by a locator. */
+    const OptionSeries& series(const Locator& locator) const;
+
+private:
+    /** @brief Copies the market data of one strike between series (used when re-indexing). */
+    static void copyRow(const OptionSeries& from, std::size_t fromIndex, OptionSeries& to, std::size_t toIndex);
+
+    /** @brief Re-derives the ATM strike after the underlying price of an expiry changed. */
+    static void updateAtm(OptionExpiry& slice);
+
+    std::vector<OptionExpiry> slices;                                      /**< All expiries. */
+    std::unordered_map<std::string, std::vector<std::size_t>> byUnderlying; /**< Expiry indices per underlying. */
+    std::unordered_map<std::string, Locator> locators;                     /**< Instrument name -> coordinates. */
+};
+
+#endif // OPTION_CHAIN_H
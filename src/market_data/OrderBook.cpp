@@ -0,0 +1,275 @@
+#include "OrderBook.h"
+#include <algorithm>
+#include <cmath>
+#include <nlohmann/json.hpp>
+
+using json = nlohmann::json;
+
+/**
+ * @file OrderBook.cpp
+ *
+ * @brief Implements the `OrderBook` class, which maintains a local copy of an instrument's order book
+ *        from Deribit `book.*` snapshot and change notifications.
+ */
+
+/**
+ * @brief Constructs an empty order book that waits for its first snapshot.
+ *
+ * @param instrument The instrument name (e.g., "BTC-PERPETUAL").
+ * @param tickSize The minimum price increment of the instrument, or 0 if unknown.
+ */
+OrderBook::OrderBook(const std::string& instrument, double tickSize)
+    : instrumentName(instrument), tick(tickSize), lastChangeId(0), lastTimestamp(0), valid(false) {}
+
+/**
+ * @brief Applies the payload of a `book.*` notification to the local book.
+ *
+ * @param data The notification payload.
+ * @return True if the update was applied, false if it was rejected.
+ *
+ * ### Sequence Handling:
+ * - `snapshot` updates always apply and reset the ladders.
+ * - `change` updates require `prev_change_id` to match the last applied `change_id`. A mismatch
+ *   invalidates the book, since silently applying deltas on top of a gap produces a crossed or
+ *   stale book that looks plausible.
+ * - Frames without a known `type` are rejected and leave the book untouched.
+ */
+bool OrderBook::applyUpdate(const json& data) {
+    auto typeIt = data.find("type");
+    if (typeIt == data.end() || !typeIt->is_string()) {
+        return false;
+    }
+    const std::string& type = typeIt->get_ref<const std::string&>();
+    if (type != "snapshot" && type != "change") {
+        return false;
+    }
+
+    if (type == "snapshot") {
+        bidLevels.clear();
+        askLevels.clear();
+        bidPrefix.dirtyFrom = 0;
+        askPrefix.dirtyFrom = 0;
+        valid = true;
+    } else {
+        if (!valid) {
+            return false; // Deltas are meaningless until a snapshot arrives
+        }
+        if (data.contains("prev_change_id") && data["prev_change_id"].get<int64_t>() != lastChangeId) {
+            valid = false;
+            return false;
+        }
+    }
+
+    // Each entry is ["new" | "change" | "delete", price, amount]
+    if (data.contains("bids")) {
+        for (const auto& level : data["bids"]) {
+            applyLevel(Side::Bid, level[0].get<std::string>(), level[1].get<double>(), level[2].get<double>());
+        }
+    }
+    if (data.contains("asks")) {
+        for (const auto& level : data["asks"]) {
+            applyLevel(Side::Ask, level[0].get<std::string>(), level[1].get<double>(), level[2].get<double>());
+        }
+    }
+
+    lastChangeId = data.value("change_id", lastChangeId);
+    lastTimestamp = data.value("timestamp", lastTimestamp);
+    return true;
+}
+
+/**
+ * @brief Inserts, updates or removes one price level, keeping the ladder sorted.
+ *
+ * The position is located by binary search. Most activity happens near the top of the book, so the
+ * element shift performed by the vector insert/erase touches only a few cache lines in practice.
+ */
+void OrderBook::applyLevel(Side side, const std::string& action, double price, double amount) {
+    auto& ladder = side == Side::Bid ? bidLevels : askLevels;
+
+    auto it = side == Side::Bid
+        ? std::lower_bound(ladder.begin(), ladder.end(), price,
+              [](const PriceLevel& level, double p) { return level.price > p; })
+        : std::lower_bound(ladder.begin(), ladder.end(), price,
+              [](const PriceLevel& level, double p) { return level.price < p; });
+
+    const bool found = it != ladder.end() && it->price == price;
+
+    // Every prefix sum from this level onwards is affected by the edit
+    auto& prefix = side == Side::Bid ? bidPrefix : askPrefix;
+    prefix.dirtyFrom = std::min(prefix.dirtyFrom, static_cast<std::size_t>(it - ladder.begin()));
+
+    if (action == "delete" || amount <= 0.0) {
+        if (found) {
+            ladder.erase(it);
+        }
+        return;
+    }
+
+    if (found) {
+        it->amount = amount;
+    } else {
+        ladder.insert(it, PriceLevel{price, amount});
+    }
+}
+
+/**
+ * @brief Removes all levels and waits for a fresh snapshot.
+ */
+void OrderBook::clear() {
+    bidLevels.clear();
+    askLevels.clear();
+    bidPrefix.dirtyFrom = 0;
+    askPrefix.dirtyFrom = 0;
+    lastChangeId = 0;
+    valid = false;
+}
+
+bool OrderBook::isValid() const {
+    return valid;
+}
+
+const std::string& OrderBook::instrument() const {
+    return instrumentName;
+}
+
+double OrderBook::tickSize() const {
+    return tick;
+}
+
+void OrderBook::setTickSize(double tickSize) {
+    tick = tickSize;
+}
+
+const std::vector<PriceLevel>& OrderBook::bids() const {
+    return bidLevels;
+}
+
+const std::vector<PriceLevel>& OrderBook::asks() const {
+    return askLevels;
+}
+
+const std::vector<PriceLevel>& OrderBook::levels(Side side) const {
+    return side == Side::Bid ? bidLevels : askLevels;
+}
+
+double OrderBook::bestBid() const {
+    return bidLevels.empty() ? 0.0 : bidLevels.front().price;
+}
+
+double OrderBook::bestAsk() const {
+    return askLevels.empty() ? 0.0 : askLevels.front().price;
+}
+
+int64_t OrderBook::changeId() const {
+    return lastChangeId;
+}
+
+int64_t OrderBook::timestamp() const {
+    return lastTimestamp;
+}
+
+/**
+ * @brief Brings a side's prefix sums up to date and returns them.
+ *
+ * Only the entries from the first stale index onwards are recomputed. Since deltas cluster near the
+ * top of the book this is often a short suffix, and repeated queries between deltas cost nothing.
+ */
+const OrderBook::PrefixSums& OrderBook::prefixSums(Side side) const {
+    const auto& ladder = levels(side);
+    PrefixSums& prefix = side == Side::Bid ? bidPrefix : askPrefix;
+
+    const std::size_t n = ladder.size();
+    if (prefix.dirtyFrom >= n && prefix.size.size() == n) {
+        return prefix;
+    }
+
+    prefix.size.resize(n);
+    prefix.notional.resize(n);
+
+    std::size_t start = std::min(prefix.dirtyFrom, n);
+    double cumSize = start > 0 ? prefix.size[start - 1] : 0.0;
+    double cumNotional = start > 0 ? prefix.notional[start - 1] : 0.0;
+
+    for (std::size_t i = start; i < n; ++i) {
+        cumSize += ladder[i].amount;
+        cumNotional += ladder[i].amount * ladder[i].price;
+        prefix.size[i] = cumSize;
+        prefix.notional[i] = cumNotional;
+    }
+
+    prefix.dirtyFrom = n;
+    return prefix;
+}
+
+/**
+ * @brief Estimates the average fill price of sweeping `size` through one side of the book.
+ *
+ * ### Workflow:
+ * 1. Binary search the cumulative size array for the first level at which the sweep completes.
+ * 2. Take the full notional of all levels before it and a partial fill of that level.
+ * 3. If the book is too thin, report the whole side as filled.
+ */
+ImpactEstimate OrderBook::estimateImpact(Side side, double size) const {
+    ImpactEstimate estimate;
+    const auto& ladder = levels(side);
+    if (ladder.empty() || size <= 0.0) {
+        return estimate;
+    }
+
+    const PrefixSums& prefix = prefixSums(side);
+    auto it = std::lower_bound(prefix.size.begin(), prefix.size.end(), size);
+
+    std::size_t last;
+    double notional;
+    if (it == prefix.size.end()) {
+        last = ladder.size() - 1;
+        estimate.filledSize = prefix.size.back();
+        notional = prefix.notional.back();
+    } else {
+        last = static_cast<std::size_t>(it - prefix.size.begin());
+        const double sizeBefore = last > 0 ? prefix.size[last - 1] : 0.0;
+        const double notionalBefore = last > 0 ? prefix.notional[last - 1] : 0.0;
+        estimate.filledSize = size;
+        notional = notionalBefore + (size - sizeBefore) * ladder[last].price;
+    }
+
+    const double best = ladder.front().price;
+    estimate.averagePrice = notional / estimate.filledSize;
+    estimate.worstPrice = ladder[last].price;
+    estimate.slippageBps = std::abs(estimate.averagePrice - best) / best * 10000.0;
+    estimate.levels = last + 1;
+    return estimate;
+}
+
+/**
+ * @brief Returns the size available within `bps` of the best price on one side.
+ *
+ * The price ladder is sorted, so the cut-off level is found by binary search and the answer is read
+ * straight from the cumulative size array.
+ */
+double OrderBook::sizeWithinBps(Side side, double bps) const {
+    const auto& ladder = levels(side);
+    if (ladder.empty()) {
+        return 0.0;
+    }
+
+    const double best = ladder.front().price;
+    std::size_t count;
+    if (side == Side::Bid) {
+        const double limit = best * (1.0 - bps / 10000.0);
+        count = std::upper_bound(ladder.begin(), ladder.end(), limit,
+            [](double p, const PriceLevel& level) { return p > level.price; }) - ladder.begin();
+    } else {
+        const double limit = best * (1.0 + bps / 10000.0);
+        count = std::upper_bound(ladder.begin(), ladder.end(), limit,
+            [](double p, const PriceLevel& level) { return p < level.price; }) - ladder.begin();
+    }
+
+    return cumulativeSize(side, count);
+}
+
+double OrderBook::cumulativeSize(Side side, std::size_t levelCount) const {
+    const PrefixSums& prefix = prefixSums(side);
+    levelCount = std::min(levelCount, prefix.size.size());
+    return levelCount == 0 ? 0.0 : prefix.size[levelCount - 1];
+}
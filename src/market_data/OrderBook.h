@@ -0,0 +1,219 @@
+#ifndef ORDER_BOOK_H
+#define ORDER_BOOK_H
+
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include <nlohmann/json_fwd.hpp>
+
+/**
+ * @file OrderBook.h
+ *
+ * @brief Defines the `OrderBook` class, a local replica of an instrument's order book maintained
+ *        from Deribit `book.*` WebSocket notifications.
+ *
+ * The book is seeded by a `snapshot` notification and then kept current by applying `change`
+ * notifications, each of which carries a list of `new`, `change` and `delete` level actions.
+ * Sequence continuity is verified through `change_id` / `prev_change_id`; a gap invalidates the
+ * book until the next snapshot arrives.
+ *
+ * ### Key Responsibilities:
+ * - Maintain sorted bid and ask ladders as contiguous arrays for cache-friendly reads.
+ * - Detect sequence gaps so consumers never act on a corrupted book.
+ * - Expose top-of-book and per-level access for analytics built on top of the book.
+ * - Maintain cumulative size/notional prefix sums per side to answer depth-walk (market impact)
+ *   queries in O(log levels).
+ */
+
+/**
+ * @struct PriceLevel
+ *
+ * @brief A single aggregated price level of the order book.
+ */
+struct PriceLevel {
+    double price{0.0};  /**< The price of the level. */
+    double amount{0.0}; /**< The total resting amount at this price. */
+};
+
+/**
+ * @struct ImpactEstimate
+ *
+ * @brief The result of sweeping a given size through one side of the book.
+ */
+struct ImpactEstimate {
+    double filledSize{0.0};    /**< The size that the visible book can absorb (<= requested size). */
+    double averagePrice{0.0};  /**< Volume-weighted average fill price of the filled size. */
+    double worstPrice{0.0};    /**< Price of the deepest level touched. */
+    double slippageBps{0.0};   /**< Distance of the average price from the best price, in basis points. */
+    std::size_t levels{0};     /**< Number of levels touched. */
+};
+
+/**
+ * @class OrderBook
+ *
+ * @brief A local order book for one instrument, updated incrementally from book notifications.
+ *
+ * ### Layout:
+ * - Bids are stored in descending price order, asks in ascending price order, so index 0 is
+ *   always the best level on either side.
+ * - Levels live in a `std::vector`, which keeps the top of the book in a handful of cache lines.
+ * - Cumulative size and notional arrays are kept next to each ladder. A delta only records the
+ *   lowest level index it touched; the prefix sums are rebuilt from that index on the next impact
+ *   query, so updates stay O(1) on top of the level edit and repeated queries are O(log levels).
+ *
+ * ### Example:
+ * ```
+ * OrderBook book("BTC-PERPETUAL", 0.5);
+ * book.applyUpdate(notification["params"]["data"]);
+ * if (book.isValid()) {
+ *     std::cout << "Best bid: " << book.bestBid() << std::endl;
+ * }
+ * ```
+ */
+class OrderBook {
+public:
+    /**
+     * @enum Side
+     * @brief Identifies one side of the order book.
+     */
+    enum class Side {
+        Bid, /**< The buy side. */
+        Ask  /**< The sell side. */
+    };
+
+    /**
+     * @brief Constructs an empty order book for an instrument.
+     *
+     * @param instrument The instrument name (e.g., "BTC-PERPETUAL").
+     * @param tickSize The minimum price increment of the instrument, or 0 if unknown.
+     */
+    explicit OrderBook(const std::string& instrument, double tickSize = 0.0);
+
+    /**
+     * @brief Applies the `data` object of a `book.*` subscription notification.
+     *
+     * @param data The notification payload containing `type`, `bids`, `asks` and change ids.
+     * @return True if the update was applied, false if it was rejected (sequence gap, a change
+     *         arriving before the first snapshot, or a frame without a `type`).
+     *
+     * ### Workflow:
+     * - A `snapshot` replaces both ladders and re-validates the book.
+     * - A `change` is applied only if its `prev_change_id` matches the last applied `change_id`;
+     *   otherwise the book is marked invalid until the next snapshot. Deribit only sends a new
+     *   snapshot after the channel is subscribed again (see `BookChannelSelector::resubscribe`).
+     * - Any other frame is rejected without touching the book.
+     */
+    bool applyUpdate(const nlohmann::json& data);
+
+    /**
+     * @brief Applies a single level action to one side of the book.
+     *
+     * @param side The side of the book to update.
+     * @param action The level action: "new", "change" or "delete".
+     * @param price The price of the level.
+     * @param amount The new amount at the level (ignored for "delete").
+     */
+    void applyLevel(Side side, const std::string& action, double price, double amount);
+
+    /**
+     * @brief Removes all levels and marks the book as awaiting a snapshot.
+     */
+    void clear();
+
+    /**
+     * @brief Checks whether the book is synchronized with the exchange.
+     *
+     * @return True once a snapshot has been applied and no sequence gap has been detected since.
+     */
+    bool isValid() const;
+
+    /** @brief Returns the instrument name of this book. */
+    const std::string& instrument() const;
+
+    /** @brief Returns the instrument tick size, or 0 if unknown. */
+    double tickSize() const;
+
+    /** @brief Sets the instrument tick size (e.g., once instrument metadata is known). */
+    void setTickSize(double tickSize);
+
+    /** @brief Returns the bid ladder, best (highest) price first. */
+    const std::vector<PriceLevel>& bids() const;
+
+    /** @brief Returns the ask ladder, best (lowest) price first. */
+    const std::vector<PriceLevel>& asks() const;
+
+    /** @brief Returns the ladder for the given side, best price first. */
+    const std::vector<PriceLevel>& levels(Side side) const;
+
+    /** @brief Returns the best bid price, or 0 if the bid side is empty. */
+    double bestBid() const;
+
+    /** @brief Returns the best ask price, or 0 if the ask side is empty. */
+    double bestAsk() const;
+
+    /** @brief Returns the `change_id` of the last applied notification. */
+    int64_t changeId() const;
+
+    /** @brief Returns the exchange timestamp (milliseconds) of the last applied notification. */
+    int64_t timestamp() const;
+
+    /**
+     * @brief Estimates the cost of sweeping a size through one side of the book.
+     *
+     * @param side The side being consumed: `Ask` for a buy order, `Bid` for a sell order.
+     * @param size The size to sweep.
+     * @return The fill estimate. `filledSize` is lower than `size` if the visible book is too thin.
+     *
+     * ### Example:
+     * ```
+     * ImpactEstimate buy = book.estimateImpact(OrderBook::Side::Ask, 50000);
+     * std::cout << "Average fill: " << buy.averagePrice << " (" << buy.slippageBps << " bps)" << std::endl;
+     * ```
+     */
+    ImpactEstimate estimateImpact(Side side, double size) const;
+
+    /**
+     * @brief Returns the size resting within a distance of the best price on one side.
+     *
+     * @param side The side of the book to measure.
+     * @param bps The distance from the best price, in basis points.
+     * @return The total size at prices no worse than `best * (1 +/- bps / 10000)`.
+     */
+    double sizeWithinBps(Side side, double bps) const;
+
+    /**
+     * @brief Returns the cumulative size of the first `levelCount` levels on one side.
+     *
+     * @param side The side of the book.
+     * @param levelCount The number of levels to include (clamped to the ladder size).
+     */
+    double cumulativeSize(Side side, std::size_t levelCount) const;
+
+private:
+    /**
+     * @struct PrefixSums
+     * @brief Lazily maintained cumulative size/notional arrays of one ladder.
+     */
+    struct PrefixSums {
+        std::vector<double> size;     /**< size[i] = sum of amounts of levels 0..i. */
+        std::vector<double> notional; /**< notional[i] = sum of price * amount of levels 0..i. */
+        std::size_t dirtyFrom{0};     /**< First index whose prefix sums are stale. */
+    };
+
+    /** @brief Rebuilds the stale tail of a side's prefix sums and returns them. */
+    const PrefixSums& prefixSums(Side side) const;
+
+
+    std::string instrumentName;     /**< The instrument this book belongs to. */
+    double tick;                    /**< The instrument tick size, 0 if unknown. */
+    std::vector<PriceLevel> bidLevels; /**< Bids, sorted by descending price. */
+    std::vector<PriceLevel> askLevels; /**< Asks, sorted by ascending price. */
+    mutable PrefixSums bidPrefix;   /**< Prefix sums of the bid ladder. */
+    mutable PrefixSums askPrefix;   /**< Prefix sums of the ask ladder. */
+    int64_t lastChangeId;           /**< The `change_id` of the last applied update. */
+    int64_t lastTimestamp;          /**< The timestamp of the last applied update. */
+    bool valid;                     /**< Whether the book is synchronized with the exchange. */
+};
+
+#endif // ORDER_BOOK_H
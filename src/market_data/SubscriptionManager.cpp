@@ -0,0 +1,193 @@
+#include "SubscriptionManager.h"
+#include "GroupedBook.h"
+#include <algorithm>
+#include <nlohmann/json.hpp>
+
+using json = nlohmann::json;
+
+/**
+ * @file SubscriptionManager.cpp
+ *
+ * @brief Implements the `SubscriptionManager` class, which expands group subscriptions over
+ *        instrument metadata and batches them into chunked JSON-RPC requests.
+ */
+
+namespace {
+
+/**
+ * @brief Infers the kind of an instrument from its name.
+ *
+ * Options have four dash-separated parts ("BTC-27DEC24-60000-C"), futures two ("BTC-PERPETUAL",
+ * "BTC-27DEC24"). Combos and spot pairs are not expanded by groups.
+ */
+std::string kindOf(const std::string& instrument) {
+    const auto dashes = std::count(instrument.begin(), instrument.end(), '-');
+    if (dashes == 3) {
+        return "option";
+    }
+    if (dashes == 1) {
+        return "future";
+    }
+    return "";
+}
+
+} // namespace
+
+SubscriptionGroup SubscriptionGroup::topOfBook(const std::string& currency, const std::string& kind) {
+    return SubscriptionGroup{currency, kind, GroupedBookChannel{"{instrument}", "none", 1, "100ms"}.name()};
+}
+
+SubscriptionGroup SubscriptionGroup::ticker(const std::string& currency, const std::string& kind) {
+    return SubscriptionGroup{currency, kind, "ticker.{instrument}.100ms"};
+}
+
+std::string SubscriptionGroup::channelFor(const std::string& instrument) const {
+    static const std::string PLACEHOLDER = "{instrument}";
+    std::string channel = channelTemplate;
+    const auto pos = channel.find(PLACEHOLDER);
+    if (pos != std::string::npos) {
+        channel.replace(pos, PLACEHOLDER.size(), instrument);
+    }
+    return channel;
+}
+
+SubscriptionManager::SubscriptionManager(std::size_t maxChannelsPerRequest)
+    : maxChannels(std::max<std::size_t>(maxChannelsPerRequest, 1)) {}
+
+/**
+ * @brief Registers a group and queues its channels for every active instrument.
+ */
+std::size_t SubscriptionManager::addGroup(const SubscriptionGroup& group, const json& instruments) {
+    groups.push_back(group);
+
+    std::size_t added = 0;
+    for (const auto& instrument : instruments) {
+        const std::string name = instrument.value("instrument_name", "");
+        if (name.empty() || !instrument.value("is_active", true) || !matches(group, instrument)) {
+            continue;
+        }
+
+        const std::string channel = group.channelFor(name);
+        if (active.insert(channel).second) {
+            toSubscribe.push_back(channel);
+            ++added;
+        }
+    }
+
+    // Follow listings of this currency and kind so new instruments are subscribed automatically
+    const std::string stateChannel = "instrument.state." + (group.kind.empty() ? std::string("any") : group.kind) + "." + group.currency;
+    if (active.insert(stateChannel).second) {
+        toSubscribe.push_back(stateChannel);
+    }
+
+    return added;
+}
+
+/**
+ * @brief Queues subscriptions for new listings and unsubscriptions for expired ones.
+ *
+ * State notifications carry only the instrument name, so the groups are selected by the
+ * `instrument.state.{kind}.{currency}` channel they were subscribed through; the name would not
+ * tell a linear `BTC_USDC-...` listing apart from a `USDC` group.
+ */
+bool SubscriptionManager::onInstrumentState(const json& params) {
+    static const std::string PREFIX = "instrument.state.";
+    const std::string channel = params.value("channel", "");
+    if (channel.rfind(PREFIX, 0) != 0 || !params.contains("data")) {
+        return false;
+    }
+    const auto dot = channel.find('.', PREFIX.size());
+    if (dot == std::string::npos) {
+        return false;
+    }
+    const std::string channelKind = channel.substr(PREFIX.size(), dot - PREFIX.size());
+    const std::string channelCurrency = channel.substr(dot + 1);
+
+    const json& data = params["data"];
+    const std::string name = data.value("instrument_name", "");
+    const std::string state = data.value("state", "");
+    if (name.empty()) {
+        return false;
+    }
+
+    const bool listed = state == "created" || state == "started";
+    const bool delisted = state == "settled" || state == "closed" || state == "terminated" || state == "deactivated";
+    if (!listed && !delisted) {
+        return false;
+    }
+
+    bool changed = false;
+    for (const auto& group : groups) {
+        if (group.currency != channelCurrency || (group.kind.empty() ? "any" : group.kind) != channelKind) {
+            continue;
+        }
+
+        const std::string groupChannel = group.channelFor(name);
+        if (listed && active.insert(groupChannel).second) {
+            toSubscribe.push_back(groupChannel);
+            changed = true;
+        } else if (delisted && active.erase(groupChannel) > 0) {
+            toUnsubscribe.push_back(groupChannel);
+            changed = true;
+        }
+    }
+    return changed;
+}
+
+/**
+ * @brief Drains the pending channel lists into chunked requests.
+ */
+std::vector<std::string> SubscriptionManager::takePendingRequests(InflightRequests& requests) {
+    std::vector<std::string> out;
+    buildRequests(RpcMethod::PublicSubscribe, toSubscribe, requests, out);
+    buildRequests(RpcMethod::PublicUnsubscribe, toUnsubscribe, requests, out);
+    return out;
+}
+
+void SubscriptionManager::buildRequests(RpcMethod method, std::vector<std::string>& channels, InflightRequests& requests,
+                                        std::vector<std::string>& out) {
+    std::size_t begin = 0;
+    for (; begin < channels.size(); begin += maxChannels) {
+        const std::size_t end = std::min(begin + maxChannels, channels.size());
+
+        json list = json::array();
+        for (std::size_t i = begin; i < end; ++i) {
+            list.push_back(channels[i]);
+        }
+
+        std::string request = requests.request(method, {{"channels", std::move(list)}});
+        if (request.empty()) {
+            break; // Ring full: the rest goes out on a later call
+        }
+        out.push_back(std::move(request));
+    }
+    channels.erase(channels.begin(), channels.begin() + static_cast<std::ptrdiff_t>(std::min(begin, channels.size())));
+}
+
+const std::set<std::string>& SubscriptionManager::activeChannels() const {
+    return active;
+}
+
+std::size_t SubscriptionManager::channelsPerRequest() const {
+    return maxChannels;
+}
+
+/**
+ * @brief Matches on the metadata currencies: inverse instruments settle in their base currency
+ *        ("BTC-PERPETUAL"), linear ones in the quote currency ("BTC_USDC-PERPETUAL" settles in USDC).
+ *        The name prefix is only used when the metadata carries no currency.
+ */
+bool SubscriptionManager::matches(const SubscriptionGroup& group, const json& instrument) {
+    const std::string name = instrument.value("instrument_name", "");
+    const std::string kind = instrument.value("kind", kindOf(name));
+    if (!group.kind.empty() && group.kind != kind) {
+        return false;
+    }
+
+    const std::string settlement = instrument.value("settlement_currency", "");
+    const std::string base = instrument.value("base_currency", "");
+    if (settlement.empty() && base.empty()) {
+        return name.compare(0, group.currency.size() + 1, group.currency + "-") == 0;
+    }
+    return settlement == group.currency || base == group.currency;
+}
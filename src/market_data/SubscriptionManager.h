@@ -0,0 +1,137 @@
+#ifndef SUBSCRIPTION_MANAGER_H
+#define SUBSCRIPTION_MANAGER_H
+
+#include <string>
+#include <vector>
+#include <set>
+#include <cstddef>
+#include <cstdint>
+#include <nlohmann/json_fwd.hpp>
+#include "../InflightRequests.h"
+
+/**
+ * @file SubscriptionManager.h
+ *
+ * @brief Defines the `SubscriptionManager` class, which expands group subscriptions such as
+ *        "all BTC options, top of book" into per-instrument channels and batches them into
+ *        `public/subscribe` requests.
+ *
+ * Instruments are taken from `public/get_instruments` results, and the manager follows the
+ * `instrument.state.{kind}.{currency}` channel so that new listings are subscribed (and expired
+ * ones unsubscribed) automatically.
+ *
+ * ### Key Responsibilities:
+ * - Expand channel templates over instrument metadata.
+ * - Chunk channels into as few `public/subscribe` / `public/unsubscribe` requests as the
+ *   per-request channel limit allows, instead of one request per channel.
+ * - Track which channels are active so nothing is subscribed twice.
+ */
+
+/**
+ * @struct SubscriptionGroup
+ *
+ * @brief A channel template applied to every instrument of a currency and kind.
+ *
+ * The template uses `{instrument}` as a placeholder, e.g. `ticker.{instrument}.100ms`.
+ */
+struct SubscriptionGroup {
+    std::string currency;        /**< The currency (e.g., "BTC"). */
+    std::string kind;            /**< The instrument kind ("future", "option", ...), empty for all. */
+    std::string channelTemplate; /**< The channel template containing `{instrument}`. */
+
+    /** @brief Top-of-book (grouped book, depth 1) channels for every instrument of a currency and kind. */
+    static SubscriptionGroup topOfBook(const std::string& currency, const std::string& kind);
+
+    /** @brief Ticker channels for every instrument of a currency and kind. */
+    static SubscriptionGroup ticker(const std::string& currency, const std::string& kind);
+
+    /** @brief Expands the template for one instrument. */
+    std::string channelFor(const std::string& instrument) const;
+};
+
+/**
+ * @class SubscriptionManager
+ *
+ * @brief Expands, batches and maintains group subscriptions.
+ *
+ * ### Example:
+ * ```
+ * SubscriptionManager subscriptions;
+ * auto instruments = json::parse(marketDataManager.getInstruments("BTC", "option"))["result"];
+ * subscriptions.addGroup(SubscriptionGroup::topOfBook("BTC", "option"), instruments);
+ *
+ * for (const auto& request : subscriptions.takePendingRequests(requests)) { // the connection's InflightRequests
+ *     wsClient.send(request);
+ * }
+ * ```
+ */
+class SubscriptionManager {
+public:
+    /**
+     * @brief Default number of channels sent per subscribe/unsubscribe request.
+     */
+    static constexpr std::size_t DEFAULT_CHANNELS_PER_REQUEST = 100;
+
+    /**
+     * @brief Constructs a subscription manager.
+     *
+     * @param maxChannelsPerRequest The maximum number of channels per request.
+     */
+    explicit SubscriptionManager(std::size_t maxChannelsPerRequest = DEFAULT_CHANNELS_PER_REQUEST);
+
+    /**
+     * @brief Adds a group and expands it over the given instruments.
+     *
+     * @param group The subscription group.
+     * @param instruments The `result` array of `public/get_instruments`.
+     * @return The number of channels newly queued for subscription.
+     *
+     * The group's `instrument.state` channel is queued as well, so listings that appear later are
+     * picked up without re-querying instrument metadata.
+     */
+    std::size_t addGroup(const SubscriptionGroup& group, const nlohmann::json& instruments);
+
+    /**
+     * @brief Applies an `instrument.state.*` notification.
+     *
+     * @param params The `params` object of the notification.
+     * @return True if the notification changed the set of channels (new requests are pending).
+     *
+     * ### Workflow:
+     * - Groups are matched by the currency and kind of the `instrument.state` channel.
+     * - `created` / `started`: channels for matching groups are queued for subscription.
+     * - `settled` / `closed` / `terminated` / `deactivated`: the instrument's channels are queued
+     *   for unsubscription.
+     */
+    bool onInstrumentState(const nlohmann::json& params);
+
+    /**
+     * @brief Builds the pending subscribe/unsubscribe requests and marks them as sent.
+     *
+     * @param requests The connection's request ring; every request takes its ID from it. Channels
+     *                 that do not fit while the ring is full stay queued for the next call.
+     * @return Serialized JSON-RPC requests, each holding at most the configured number of channels.
+     */
+    std::vector<std::string> takePendingRequests(InflightRequests& requests);
+
+    /** @brief Returns the set of channels that have been requested and not unsubscribed. */
+    const std::set<std::string>& activeChannels() const;
+
+    /** @brief Returns the configured channel limit per request. */
+    std::size_t channelsPerRequest() const;
+
+private:
+    /** @brief Appends chunked requests for a list of channels to `out` and removes the channels sent. */
+    void buildRequests(RpcMethod method, std::vector<std::string>& channels, InflightRequests& requests, std::vector<std::string>& out);
+
+    /** @brief Returns whether an instrument (a `get_instruments` entry) belongs to a group's currency and kind. */
+    static bool matches(const SubscriptionGroup& group, const nlohmann::json& instrument);
+
+    std::size_t maxChannels;                 /**< Channel limit per request. */
+    std::vector<SubscriptionGroup> groups;   /**< Registered groups. */
+    std::set<std::string> active;            /**< Channels requested and not yet unsubscribed. */
+    std::vector<std::string> toSubscribe;    /**< Channels queued for subscription. */
+    std::vector<std::string> toUnsubscribe;  /**< Channels queued for unsubscription. */
+};
+
+#endif // SUBSCRIPTION_MANAGER_H
@@ -0,0 +1,88 @@
+#include "TopOfBookCache.h"
+#include <nlohmann/json.hpp>
+
+using json = nlohmann::json;
+
+/**
+ * @file TopOfBookCache.cpp
+ *
+ * @brief Implements the `TopOfBookCache` class, which diffs bulk book summary snapshots.
+ */
+
+namespace {
+
+/** @brief Reads a numeric field that may be missing or `null`. */
+double numberOr(const json& object, const char* key, double fallback) {
+    auto it = object.find(key);
+    return it != object.end() && it->is_number() ? it->get<double>() : fallback;
+}
+
+} // namespace
+
+bool TopOfBook::differsFrom(const TopOfBook& other) const {
+    return bidPrice != other.bidPrice || askPrice != other.askPrice || markPrice != other.markPrice ||
+           lastPrice != other.lastPrice || volume != other.volume || openInterest != other.openInterest;
+}
+
+void TopOfBookCache::setChangeHandler(ChangeHandler handler) {
+    onChange = std::move(handler);
+}
+
+/**
+ * @brief Stores new or changed summaries and notifies the consumer once.
+ */
+std::size_t TopOfBookCache::applySummary(const json& response) {
+    const json& result = response.is_object() && response.contains("result") ? response["result"] : response;
+    if (!result.is_array()) {
+        return 0;
+    }
+
+    // Pointers into an unordered_map stay valid across insertions, so they can be collected as we go
+    changed.clear();
+    for (const auto& summary : result) {
+        auto name = summary.find("instrument_name");
+        if (name == summary.end() || !name->is_string()) {
+            continue;
+        }
+
+        TopOfBook entry;
+        entry.instrument = name->get<std::string>();
+        entry.bidPrice = numberOr(summary, "bid_price", 0.0);
+        entry.askPrice = numberOr(summary, "ask_price", 0.0);
+        entry.markPrice = numberOr(summary, "mark_price", 0.0);
+        entry.lastPrice = numberOr(summary, "last", 0.0);
+        entry.volume = numberOr(summary, "volume", 0.0);
+        entry.openInterest = numberOr(summary, "open_interest", 0.0);
+        entry.timestamp = static_cast<int64_t>(numberOr(summary, "creation_timestamp", 0.0));
+
+        auto it = entries.find(entry.instrument);
+        if (it == entries.end()) {
+            it = entries.emplace(entry.instrument, std::move(entry)).first;
+        } else if (it->second.differsFrom(entry)) {
+            it->second = std::move(entry);
+        } else {
+            it->second.timestamp = entry.timestamp;
+            continue;
+        }
+        changed.push_back(&it->second);
+    }
+
+    if (onChange && !changed.empty()) {
+        onChange(changed);
+    }
+    return changed.size();
+}
+
+const TopOfBook* TopOfBookCache::find(const std::string& instrument) const {
+    auto it = entries.find(instrument);
+    return it == entries.end() ? nullptr : &it->second;
+}
+
+std::size_t TopOfBookCache::size() const {
+    return entries.size();
+}
+
+void TopOfBookCache::clear() {
+    entries.clear();
+    changed.clear();
+}
@@ -0,0 +1,98 @@
+#ifndef TOP_OF_BOOK_CACHE_H
+#define TOP_OF_BOOK_CACHE_H
+
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include <functional>
+#include <unordered_map>
+#include <nlohmann/json_fwd.hpp>
+
+/**
+ * @file TopOfBookCache.h
+ *
+ * @brief Defines the `TopOfBookCache` class, a per-instrument cache of best prices filled from bulk
+ *        `public/get_book_summary_by_currency` snapshots.
+ *
+ * Screens and periodic reconciliation need the top of book of every instrument of a currency.
+ * Fetching one order book per instrument costs hundreds of requests; one book summary request per
+ * currency and kind returns the same fields for all of them. The cache diffs each snapshot against
+ * the previous one and notifies consumers only about instruments whose values actually changed.
+ */
+
+/**
+ * @struct TopOfBook
+ *
+ * @brief Best prices and summary statistics of one instrument.
+ *
+ * Prices the exchange reports as `null` (e.g., an empty side of an illiquid option) are stored as 0.
+ */
+struct TopOfBook {
+    std::string instrument;    /**< Instrument name. */
+    double bidPrice = 0.0;     /**< Best bid price. */
+    double askPrice = 0.0;     /**< Best ask price. */
+    double markPrice = 0.0;    /**< Mark price. */
+    double lastPrice = 0.0;    /**< Last traded price. */
+    double volume = 0.0;       /**< 24h volume. */
+    double openInterest = 0.0; /**< Open interest. */
+    int64_t timestamp = 0;     /**< Exchange timestamp of the summary (ms). */
+
+    /** @brief Returns true if any price or statistic differs (the timestamp is ignored). */
+    bool differsFrom(const TopOfBook& other) const;
+};
+
+/**
+ * @class TopOfBookCache
+ *
+ * @brief Diffing cache of top-of-book entries keyed by instrument name.
+ *
+ * ### Example:
+ * ```
+ * MarketDataManager manager;
+ * TopOfBookCache cache;
+ * cache.setChangeHandler([](const std::vector<const TopOfBook*>& changed) {
+ *     for (const auto* entry : changed) {
+ *         std::cout << entry->instrument << " " << entry->bidPrice << "/" << entry->askPrice << std::endl;
+ *     }
+ * });
+ * cache.applySummary(json::parse(manager.getBookSummaryByCurrency("BTC", "option")));
+ * ```
+ */
+class TopOfBookCache {
+public:
+    /** @brief Callback invoked once per snapshot with the entries that changed. */
+    using ChangeHandler = std::function<void(const std::vector<const TopOfBook*>&)>;
+
+    /** @brief Sets the callback invoked after each snapshot that changed at least one entry. */
+    void setChangeHandler(ChangeHandler handler);
+
+    /**
+     * @brief Merges a `public/get_book_summary_by_currency` response into the cache.
+     *
+     * @param response The parsed response (either the full JSON-RPC object or its `result` array).
+     * @return The number of instruments that were added or changed.
+     *
+     * ### Workflow:
+     * 1. Parse each summary into a `TopOfBook`.
+     * 2. Compare it with the cached entry; store it if it is new or differs.
+     * 3. Invoke the change handler once with all added or changed entries.
+     */
+    std::size_t applySummary(const nlohmann::json& response);
+
+    /** @brief Returns the cached entry of an instrument, or nullptr if it is unknown. */
+    const TopOfBook* find(const std::string& instrument) const;
+
+    /** @brief Returns the number of cached instruments. */
+    std::size_t size() const;
+
+    /** @brief Removes all entries. */
+    void clear();
+
+private:
+    ChangeHandler onChange;                               /**< Consumer callback. */
+    std::unordered_map<std::string, TopOfBook> entries;   /**< Instrument -> top of book. */
+    std::vector<const TopOfBook*> changed;                /**< Scratch list reused between snapshots. */
+};
+
+#endif // TOP_OF_BOOK_CACHE_H
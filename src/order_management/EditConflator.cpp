@@ -0,0 +1,88 @@
+#include "EditConflator.h"
+#include <cstring>
+
+/**
+ * @file EditConflator.cpp
+ *
+ * @brief Implements the `EditConflator` class.
+ */
+
+namespace {
+
+std::string orderIdOf(const OrderIntent& intent) {
+    return std::string(intent.orderId, strnlen(intent.orderId, sizeof(intent.orderId)));
+}
+
+} // namespace
+
+/**
+ * @brief An entry in `slots` means an edit is in flight; its pending slot holds the latest
+ *        edit received since.
+ */
+EditConflator::Result EditConflator::submit(const OrderIntent& edit, OrderIntent& superseded) {
+    auto result = slots.try_emplace(orderIdOf(edit));
+    if (result.second) {
+        return Result::SendNow;
+    }
+
+    Slot& slot = result.first->second;
+    const bool replaced = slot.hasPending;
+    if (replaced) {
+        superseded = slot.pending;
+        ++conflatedCount;
+    }
+    slot.pending = edit;
+    slot.hasPending = true;
+    return replaced ? Result::Replaced : Result::Queued;
+}
+
+bool EditConflator::complete(const std::string& orderId, OrderIntent& next) {
+    auto it = slots.find(orderId);
+    if (it == slots.end()) {
+        return false;
+    }
+
+    if (!it->second.hasPending) {
+        slots.erase(it);
+        return false;
+    }
+
+    next = it->second.pending;
+    it->second.hasPending = false; // The pending edit is now in flight
+    return true;
+}
+
+bool EditConflator::forget(const std::string& orderId, OrderIntent& dropped) {
+    auto it = slots.find(orderId);
+    if (it == slots.end()) {
+        return false;
+    }
+
+    const bool hadPending = it->second.hasPending;
+    if (hadPending) {
+        dropped = it->second.pending;
+    }
+    slots.erase(it);
+    return hadPending;
+}
+
+void EditConflator::forgetAll(std::vector<OrderIntent>& dropped) {
+    for (const auto& entry : slots) {
+        if (entry.second.hasPending) {
+            dropped.push_back(entry.second.pending);
+        }
+    }
+    slots.clear();
+}
+
+bool EditConflator::inFlight(const std::string& orderId) const {
+    return slots.count(orderId) > 0;
+}
+
+uint64_t EditConflator::conflated() const {
+    return conflatedCount;
+}
+
+std::size_t EditConflator::size() const {
+    return slots.size();
+}
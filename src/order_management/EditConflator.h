@@ -0,0 +1,104 @@
+#ifndef EDIT_CONFLATOR_H
+#define EDIT_CONFLATOR_H
+
+#include <cstdint>
+#include <cstddef>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "OrderSubmissionQueue.h"
+
+/**
+ * @file EditConflator.h
+ *
+ * @brief Defines the `EditConflator` class, which keeps at most one in-flight and one pending edit
+ *        per order.
+ *
+ * A quoting loop that edits an order faster than the exchange acknowledges the edits would
+ * otherwise queue a series of stale prices, each costing rate-limit credits. The conflator lets the
+ * first edit through, parks later edits of the same order in a single pending slot (a newer edit
+ * overwrites the older one), and releases the pending edit as soon as the in-flight one completes.
+ * Only the latest desired price and amount ever reach the exchange.
+ */
+
+/**
+ * @class EditConflator
+ *
+ * @brief Per-order edit conflation with one in-flight and one pending slot.
+ *
+ * ### Example:
+ * ```
+ * EditConflator conflator;
+ * OrderIntent superseded;
+ * if (conflator.submit(edit, superseded) == EditConflator::Result::SendNow) {
+ *     send(edit);
+ * }
+ * // When the edit's response arrives:
+ * OrderIntent next;
+ * if (conflator.complete(orderId, next)) {
+ *     send(next);
+ * }
+ * ```
+ */
+class EditConflator {
+public:
+    enum class Result {
+        SendNow,  /**< Nothing in flight for this order: send the edit now. */
+        Queued,   /**< An edit is in flight: this edit became the pending one. */
+        Replaced  /**< An edit is in flight: this edit replaced the pending one (see `superseded`). */
+    };
+
+    /**
+     * @brief Offers a new edit.
+     *
+     * @param edit The edit intent (its `orderId` identifies the order).
+     * @param superseded Receives the pending edit that was overwritten when the result is `Replaced`.
+     * @return What to do with the edit.
+     */
+    Result submit(const OrderIntent& edit, OrderIntent& superseded);
+
+    /**
+     * @brief Marks the in-flight edit of an order as completed.
+     *
+     * @param orderId The order whose edit was acknowledged (or rejected).
+     * @param next Receives the pending edit, which becomes the new in-flight edit.
+     * @return True if a pending edit must be sent now.
+     */
+    bool complete(const std::string& orderId, OrderIntent& next);
+
+    /**
+     * @brief Forgets an order (e.g., it was cancelled or filled).
+     *
+     * @param orderId The order.
+     * @param dropped Receives the pending edit that will never be sent, if any.
+     * @return True if a pending edit was dropped.
+     */
+    bool forget(const std::string& orderId, OrderIntent& dropped);
+
+    /**
+     * @brief Forgets every order (e.g., after a cancel of all orders).
+     *
+     * @param dropped Receives the pending edits that will never be sent.
+     */
+    void forgetAll(std::vector<OrderIntent>& dropped);
+
+    /** @brief Returns true if an edit of the order is in flight. */
+    bool inFlight(const std::string& orderId) const;
+
+    /** @brief Returns the number of edits that were overwritten before being sent. */
+    uint64_t conflated() const;
+
+    /** @brief Returns the number of orders with an edit in flight. */
+    std::size_t size() const;
+
+private:
+    struct Slot {
+        bool hasPending{false};
+        OrderIntent pending{};
+    };
+
+    std::unordered_map<std::string, Slot> slots; /**< Orders with an edit in flight. */
+    uint64_t conflatedCount{0};
+};
+
+#endif // EDIT_CONFLATOR_H
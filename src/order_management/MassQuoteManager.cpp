@@ -0,0 +1,239 @@
+#include "MassQuoteManager.h"
+#include "../WebSocketClient.h"
+#include <iostream>
+#include <nlohmann/json.hpp>
+#include <fmt/color.h>
+#include <fmt/format.h>
+
+// Define color constants for clarity
+const auto ERROR_COLOR = fmt::fg(fmt::color::red);
+const auto SUCCESS_COLOR = fmt::fg(fmt::color::cyan);
+const auto INFO_COLOR = fmt::fg(fmt::color::blue);
+const auto HIGHLIGHT_COLOR = fmt::fg(fmt::color::yellow);
+
+using json = nlohmann::json;
+
+/**
+ * @file MassQuoteManager.cpp
+ *
+ * @brief Implements the `MassQuoteManager` class.
+ *
+ * The WebSocket client holds its own lock while a receive callback runs, and `onMessage` is called
+ * from such callbacks. To keep the lock order one-way, this file never sends while holding `mutex`.
+ * Responses are matched by `InflightRequests`, whose completions run outside its own lock and take
+ * `mutex` themselves.
+ */
+
+namespace {
+
+json sideToJson(const QuoteSide& side) {
+    return {{"price", side.price}, {"amount", side.amount}, {"post_only", true}};
+}
+
+QuoteSide sideFromJson(const json& side) {
+    QuoteSide parsed;
+    if (side.is_object()) {
+        parsed.price = side.value("price", 0.0);
+        parsed.amount = side.value("amount", 0.0);
+    }
+    return parsed;
+}
+
+} // namespace
+
+MassQuoteManager::MassQuoteManager(WebSocketClient& ws, InflightRequests& requests, std::string mmpGroup)
+    : ws(ws), mmpGroup(std::move(mmpGroup)), requests(requests) {}
+
+/**
+ * @brief The record is stored before sending, so a response that races the return of `send`
+ *        always finds it. It replaces the previous record of the quote set, whose quotes the
+ *        exchange replaces too; a late response to the superseded message is ignored.
+ */
+std::string MassQuoteManager::quote(const std::string& quoteSetId, const std::vector<Quote>& quotes) {
+    if (quotes.empty()) {
+        return "";
+    }
+
+    json legs = json::array();
+    for (const auto& entry : quotes) {
+        json leg = {{"instrument_name", entry.instrument}, {"quote_set_id", quoteSetId}};
+        if (entry.bid.amount > 0) {
+            leg["bid"] = sideToJson(entry.bid);
+        }
+        if (entry.ask.amount > 0) {
+            leg["ask"] = sideToJson(entry.ask);
+        }
+        legs.push_back(std::move(leg));
+    }
+
+    uint64_t requestId;
+    std::string quoteId;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        quoteId = fmt::format("{}-{}", quoteSetId, nextQuoteId++);
+        QuoteSet& record = quoteSets[quoteSetId];
+        record = QuoteSet{};
+        record.quoteId = quoteId;
+        record.quoteSetId = quoteSetId;
+        record.quotes = quotes;
+
+        requestId = requests.allocate(RpcMethod::MassQuote, [this, quoteSetId, quoteId](const json* response) {
+            onQuoteResponse(quoteSetId, quoteId, response);
+        });
+        record.requestId = requestId;
+        if (requestId == 0) {
+            quoteSets.erase(quoteSetId);
+            std::cerr << fmt::format(ERROR_COLOR, "Mass quote {} not sent: too many requests in flight\n", quoteId);
+            return "";
+        }
+    }
+
+    json params = {
+        {"quote_id", quoteId},
+        {"mmp_group", mmpGroup},
+        {"wait_for_response", true},
+        {"detailed", false},
+        {"quotes", std::move(legs)}
+    };
+    return sendRequest(InflightRequests::serialize(requestId, RpcMethod::MassQuote, params), requestId) ? quoteId : "";
+}
+
+bool MassQuoteManager::cancelQuotes(const std::string& quoteSetId) {
+    json params = {{"cancel_type", quoteSetId.empty() ? "all" : "quote_set_id"}};
+    if (!quoteSetId.empty()) {
+        params["quote_set_id"] = quoteSetId;
+    }
+
+    const uint64_t requestId = requests.allocate(RpcMethod::CancelQuotes, [this, quoteSetId](const json* response) {
+        onCancelResponse(quoteSetId, response);
+    });
+    if (requestId == 0) {
+        std::cerr << fmt::format(ERROR_COLOR, "Quote cancel not sent: too many requests in flight\n");
+        return false;
+    }
+
+    return sendRequest(InflightRequests::serialize(requestId, RpcMethod::CancelQuotes, params), requestId);
+}
+
+bool MassQuoteManager::sendRequest(const std::string& payload, uint64_t requestId) {
+    try {
+        ws.send(payload);
+        return true;
+    } catch (const std::exception& e) {
+        std::cerr << fmt::format(ERROR_COLOR, "Failed to send quote request {}: {}\n", requestId, e.what());
+    }
+    requests.abandon(requestId);
+    return false;
+}
+
+bool MassQuoteManager::onMessage(const json& message) {
+    return requests.complete(message);
+}
+
+std::size_t MassQuoteManager::expireRequests() {
+    return requests.expire();
+}
+
+MethodRtt MassQuoteManager::rtt(RpcMethod method) const {
+    return requests.rtt(method);
+}
+
+/**
+ * @brief A mass quote response carries the accepted `orders` and the rejected legs in `errors`.
+ *        Without a response (send failure or timeout) the whole set counts as rejected.
+ *        A rejected record is terminal: it is reported and dropped.
+ */
+void MassQuoteManager::onQuoteResponse(const std::string& quoteSetId, const std::string& quoteId, const json* response) {
+    std::lock_guard<std::mutex> lock(mutex);
+    auto it = quoteSets.find(quoteSetId);
+    if (it == quoteSets.end() || it->second.quoteId != quoteId) {
+        return; // Superseded or cancelled meanwhile
+    }
+    QuoteSet& record = it->second;
+
+    if (!response || !response->contains("result")) {
+        const std::string message = !response ? "No response"
+                                    : response->contains("error") ? (*response)["error"].value("message", "Exchange error")
+                                                                  : "Exchange error";
+        std::cerr << fmt::format(ERROR_COLOR, "Mass quote {} rejected: {}\n", quoteId, message);
+        quoteSets.erase(it);
+        return;
+    }
+    const auto result = response->find("result");
+
+    auto errors = result->find("errors");
+    record.errors = errors != result->end() && errors->is_array() ? errors->size() : 0;
+    if (record.errors == 0) {
+        record.status = QuoteSet::Status::Accepted;
+        return;
+    }
+
+    std::size_t sides = 0;
+    for (const auto& entry : record.quotes) {
+        sides += (entry.bid.amount > 0) + (entry.ask.amount > 0);
+    }
+    record.message = (*errors)[0].value("message", "");
+    if (record.errors >= sides) {
+        std::cerr << fmt::format(ERROR_COLOR, "Mass quote {} rejected: {}\n", quoteId, record.message);
+        quoteSets.erase(it);
+        return;
+    }
+    record.status = QuoteSet::Status::PartiallyRejected;
+}
+
+/**
+ * @brief A successful cancel drops the record of the cancelled set (or every record).
+ */
+void MassQuoteManager::onCancelResponse(const std::string& quoteSetId, const json* response) {
+    if (!response || !response->contains("result")) {
+        std::cerr << fmt::format(ERROR_COLOR, "Quote cancel of {} failed: {}\n", quoteSetId.empty() ? "all sets" : quoteSetId,
+                                 response ? response->dump() : "no response");
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(mutex);
+    if (quoteSetId.empty()) {
+        quoteSets.clear();
+    } else {
+        quoteSets.erase(quoteSetId);
+    }
+}
+
+bool MassQuoteManager::find(const std::string& quoteId, QuoteSet& out) const {
+    // quote_id is "<quote_set_id>-<n>", and only the latest message of a set is kept
+    const std::size_t dash = quoteId.rfind('-');
+    if (dash == std::string::npos) {
+        return false;
+    }
+    std::lock_guard<std::mutex> lock(mutex);
+    auto it = quoteSets.find(quoteId.substr(0, dash));
+    if (it == quoteSets.end() || it->second.quoteId != quoteId) {
+        return false;
+    }
+    out = it->second;
+    return true;
+}
+
+std::vector<Quote> MassQuoteManager::parseQuotes(const json& quotes) {
+    std::vector<Quote> parsed;
+    if (!quotes.is_array()) {
+        return parsed;
+    }
+
+    for (const auto& entry : quotes) {
+        if (!entry.is_object() || !entry.contains("instrument_name") || !entry["instrument_name"].is_string()) {
+            continue;
+        }
+        Quote quote;
+        quote.instrument = entry["instrument_name"].get<std::string>();
+        quote.bid = sideFromJson(entry.value("bid", json::object()));
+        quote.ask = sideFromJson(entry.value("ask", json::object()));
+        parsed.push_back(std::move(quote));
+    }
+    return parsed;
+}
+
+std::size_t MassQuoteManager::size() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return quoteSets.size();
+}
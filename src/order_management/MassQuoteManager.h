@@ -0,0 +1,186 @@
+#ifndef MASS_QUOTE_MANAGER_H
+#define MASS_QUOTE_MANAGER_H
+
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include <mutex>
+#include <unordered_map>
+#include <nlohmann/json_fwd.hpp>
+#include "../InflightRequests.h"
+
+class WebSocketClient;
+
+/**
+ * @file MassQuoteManager.h
+ *
+ * @brief Defines the `MassQuoteManager` class, which sends two-sided quotes for many instruments as
+ *        single `private/mass_quote` messages over an authorized WebSocket.
+ *
+ * Quoting an option chain leg by leg through `OrderManager::placeOrder`/`modifyOrder` costs one
+ * HTTP request per leg. A mass quote replaces the bid and ask of every instrument of a quote set in
+ * one message, and `private/cancel_quotes` pulls a quote set (or all quotes) in one message.
+ *
+ * ### Key Responsibilities:
+ * - Build and send `private/mass_quote` requests for a full set of bid/ask quotes.
+ * - Track the latest mass quote of every quote set, including per-leg errors; superseded,
+ *   rejected and cancelled quotes are dropped.
+ * - Provide the fast mass-cancel path (`private/cancel_quotes`).
+ */
+
+/**
+ * @struct QuoteSide
+ *
+ * @brief One side of a two-sided quote; a zero amount leaves the side out of the message.
+ */
+struct QuoteSide {
+    double price{0.0};
+    double amount{0.0};
+};
+
+/**
+ * @struct Quote
+ *
+ * @brief The desired bid and ask of one instrument.
+ */
+struct Quote {
+    std::string instrument; /**< Instrument name (e.g., "BTC-27DEC24-100000-C"). */
+    QuoteSide bid;          /**< Bid side. */
+    QuoteSide ask;          /**< Ask side. */
+};
+
+/**
+ * @struct QuoteSet
+ *
+ * @brief Local record of the latest live mass quote of a quote set.
+ */
+struct QuoteSet {
+    enum class Status {
+        Pending,           /**< Sent, no response yet. */
+        Accepted,          /**< Every leg was accepted. */
+        PartiallyRejected, /**< Some legs were rejected (see `errors`). */
+    };
+
+    std::string quoteId;     /**< Unique ID of the mass quote message. */
+    std::string quoteSetId;  /**< Quote set the quotes belong to. */
+    std::vector<Quote> quotes; /**< The quotes sent. */
+    uint64_t requestId{0};   /**< JSON-RPC request ID. */
+    Status status{Status::Pending};
+    std::size_t errors{0};   /**< Number of rejected legs. */
+    std::string message;     /**< Error message of the first rejected leg or of the request. */
+};
+
+/**
+ * @class MassQuoteManager
+ *
+ * @brief Mass quoting and mass cancel over an authorized WebSocket.
+ *
+ * ### Workflow:
+ * 1. Authorize the WebSocket (e.g., with `AuthManager::buildWebSocketAuthRequest`).
+ * 2. `quote` sends a full quote set; the previous quotes of the set are replaced by the exchange.
+ * 3. Pass every message received on the connection to `onMessage`, which updates the local records.
+ * 4. `cancelQuotes` pulls a quote set, or every quote, in one request.
+ *
+ * `quote` and `cancelQuotes` send on the WebSocket, so they must not be called from inside a
+ * `WebSocketClient::receive` callback. Since the client also holds its lock during a blocking read,
+ * they are best called from the thread that drives `receive`, between two reads.
+ *
+ * ### Example:
+ * ```
+ * InflightRequests requests; // one per connection
+ * MassQuoteManager quoter(ws, requests, "default");
+ * std::string quoteId = quoter.quote("chain", {{"BTC-27DEC24-100000-C", {0.0150, 1}, {0.0160, 1}}});
+ * // On the receive thread:
+ * quoter.onMessage(json::parse(message));
+ * // Kill switch:
+ * quoter.cancelQuotes();
+ * ```
+ */
+class MassQuoteManager {
+public:
+    /**
+     * @brief Constructs a manager sending on an authorized WebSocket.
+     *
+     * @param ws The connection; it must outlive the manager.
+     * @param requests The connection's request ring, shared with every other request sent on `ws`;
+     *                 it must outlive the manager.
+     * @param mmpGroup The market maker protection group the quotes belong to.
+     */
+    MassQuoteManager(WebSocketClient& ws, InflightRequests& requests, std::string mmpGroup);
+
+    /**
+     * @brief Sends a full quote set as one `private/mass_quote` message.
+     *
+     * @param quoteSetId The quote set (e.g., one per expiry).
+     * @param quotes The desired bid/ask of every instrument of the set.
+     * @return The `quote_id` of the message, or an empty string if nothing was sent.
+     */
+    std::string quote(const std::string& quoteSetId, const std::vector<Quote>& quotes);
+
+    /**
+     * @brief Cancels the quotes of one quote set, or every quote, in one `private/cancel_quotes` message.
+     *
+     * @param quoteSetId The quote set, or an empty string for every quote.
+     * @return True if the request was sent.
+     */
+    bool cancelQuotes(const std::string& quoteSetId = "");
+
+    /**
+     * @brief Processes a message received on the connection.
+     *
+     * @param message The parsed JSON-RPC message.
+     * @return True if the message answered a request of this manager.
+     */
+    bool onMessage(const nlohmann::json& message);
+
+    /**
+     * @brief Looks up a live mass quote.
+     *
+     * @return False if the `quote_id` is unknown, superseded, rejected or cancelled.
+     */
+    bool find(const std::string& quoteId, QuoteSet& out) const;
+
+    /**
+     * @brief Parses quotes from a JSON array of `{"instrument_name", "bid": {"price", "amount"}, "ask": {...}}`.
+     *
+     * Entries without an instrument name are skipped.
+     */
+    static std::vector<Quote> parseQuotes(const nlohmann::json& quotes);
+
+    /** @brief Returns the number of live quote sets. */
+    std::size_t size() const;
+
+    /**
+     * @brief Expires the connection's requests left unanswered past the ring's timeout; call it
+     *        regularly from the receive loop.
+     *
+     * The ring is shared, so other requests of the connection expire here too. Expired mass
+     * quotes count as rejected.
+     *
+     * @return The number of expired requests.
+     */
+    std::size_t expireRequests();
+
+    /** @brief Returns the round-trip statistics of `private/mass_quote` or `private/cancel_quotes`. */
+    MethodRtt rtt(RpcMethod method) const;
+
+private:
+    /** @brief Sends a request; abandons it (its completion runs without a response) if the send fails. */
+    bool sendRequest(const std::string& payload, uint64_t requestId);
+
+    /** @brief Applies the response (or its absence) to the record of `quoteId`, if still live. */
+    void onQuoteResponse(const std::string& quoteSetId, const std::string& quoteId, const nlohmann::json* response);
+
+    /** @brief Drops the cancelled records once a `private/cancel_quotes` is answered. */
+    void onCancelResponse(const std::string& quoteSetId, const nlohmann::json* response);
+
+    WebSocketClient& ws;
+    std::string mmpGroup;
+    InflightRequests& requests;                              /**< The connection's request ID correlation and timeouts. */
+    mutable std::mutex mutex;                                /**< Guards everything below. */
+    uint64_t nextQuoteId{1};
+    std::unordered_map<std::string, QuoteSet> quoteSets;     /**< quote_set_id -> latest live record. */
+};
+
+#endif // MASS_QUOTE_MANAGER_H
@@ -0,0 +1,42 @@
+#ifndef ORDER_ENTRY_H
+#define ORDER_ENTRY_H
+
+#include <string>
+
+/**
+ * @file OrderEntry.h
+ *
+ * @brief Defines the `OrderEntry` interface, the order operations shared by every order transport.
+ *
+ * `OrderManager` sends orders as JSON-RPC over HTTP and `FixOrderManager` sends them over a FIX
+ * session. Both answer in the same Deribit JSON-RPC response format (`{"result": ...}` or
+ * `{"error": {...}}`), so components such as `OrderSubmissionQueue` and `GatewayServer` work with
+ * either transport.
+ */
+
+/**
+ * @class OrderEntry
+ *
+ * @brief Abstract order entry: place, modify, cancel, mass cancel and order state lookup.
+ */
+class OrderEntry {
+public:
+    virtual ~OrderEntry() = default;
+
+    /** @brief Places a limit order; returns the JSON-RPC style response. */
+    virtual std::string placeOrder(const std::string& instrument, const std::string& side, double quantity, double price) = 0;
+
+    /** @brief Changes the amount and price of an order; returns the JSON-RPC style response. */
+    virtual std::string modifyOrder(const std::string& orderId, double newQuantity, double newPrice) = 0;
+
+    /** @brief Cancels an order; returns the JSON-RPC style response. */
+    virtual std::string cancelOrder(const std::string& orderId) = 0;
+
+    /** @brief Cancels all orders, or those of one instrument; returns the JSON-RPC style response. */
+    virtual std::string cancelAllOrders(const std::string& instrument = "") = 0;
+
+    /** @brief Retrieves the state of an order; returns the JSON-RPC style response. */
+    virtual std::string getOrderState(const std::string& orderId) = 0;
+};
+
+#endif // ORDER_ENTRY_H
@@ -0,0 +1,182 @@
+#include "OrderIndex.h"
+#include <algorithm>
+#include <cstring>
+
+/**
+ * @file OrderIndex.cpp
+ *
+ * @brief Implements the `OrderIndex` class.
+ */
+
+namespace {
+
+/** @brief Average key size used to reserve the arena (Deribit order IDs are ~12 characters). */
+constexpr std::size_t TYPICAL_KEY_SIZE = 16;
+
+std::size_t tableSizeFor(std::size_t keys) {
+    std::size_t size = 16;
+    while (size < 2 * keys) {
+        size *= 2;
+    }
+    return size;
+}
+
+} // namespace
+
+OrderIndex::OrderIndex(std::size_t expectedKeys)
+    : table(tableSizeFor(expectedKeys), Entry{0, INVALID_HANDLE}) {
+    keys.reserve(expectedKeys);
+    arena.reserve(expectedKeys * TYPICAL_KEY_SIZE);
+}
+
+/**
+ * @brief 64-bit FNV-1a folded to 32 bits with a final avalanche, so the low bits used to pick the
+ *        entry depend on every character (order IDs often differ only in their last digits).
+ */
+uint32_t OrderIndex::hashOf(std::string_view key) {
+    uint64_t h = 14695981039346656037ull;
+    for (char c : key) {
+        h ^= static_cast<unsigned char>(c);
+        h *= 1099511628211ull;
+    }
+    h ^= h >> 32;
+    h *= 0xD6E8FEB86659FD93ull;
+    h ^= h >> 32;
+    return static_cast<uint32_t>(h);
+}
+
+std::size_t OrderIndex::probe(std::string_view key, uint32_t hash) const {
+    const std::size_t mask = table.size() - 1;
+    std::size_t index = hash & mask;
+    while (true) {
+        const Entry& entry = table[index];
+        if (entry.handle == INVALID_HANDLE) {
+            return index;
+        }
+        if (entry.hash == hash) {
+            const KeyRef& ref = keys[entry.handle];
+            if (ref.length == key.size() && std::memcmp(arena.data() + ref.offset, key.data(), key.size()) == 0) {
+                return index;
+            }
+        }
+        index = (index + 1) & mask;
+    }
+}
+
+OrderIndex::Handle OrderIndex::find(std::string_view key) const {
+    return table[probe(key, hashOf(key))].handle;
+}
+
+OrderIndex::Handle OrderIndex::intern(std::string_view key) {
+    const uint32_t hash = hashOf(key);
+    std::size_t index = probe(key, hash);
+    if (table[index].handle != INVALID_HANDLE) {
+        return table[index].handle;
+    }
+
+    if (2 * (size() + 1) > table.size()) {
+        grow();
+        index = probe(key, hash);
+    }
+    if (deadBytes > arena.size() / 2 && deadBytes >= 4096) {
+        compact();
+    }
+
+    const KeyRef ref{static_cast<uint32_t>(arena.size()), static_cast<uint32_t>(key.size()), hash};
+    Handle handle;
+    if (freeHandles.empty()) {
+        handle = static_cast<Handle>(keys.size());
+        keys.push_back(ref);
+    } else {
+        handle = freeHandles.back();
+        freeHandles.pop_back();
+        keys[handle] = ref;
+    }
+    arena.insert(arena.end(), key.begin(), key.end());
+    table[index] = Entry{hash, handle};
+    return handle;
+}
+
+/**
+ * @brief Backward-shift deletion: after emptying the entry, every following entry of the probe run
+ *        that may legally sit in the hole (its home position is not between the hole and itself)
+ *        moves back into it, until the run ends at an empty entry.
+ */
+bool OrderIndex::erase(std::string_view key) {
+    std::size_t hole = probe(key, hashOf(key));
+    const Handle handle = table[hole].handle;
+    if (handle == INVALID_HANDLE) {
+        return false;
+    }
+
+    const std::size_t mask = table.size() - 1;
+    table[hole] = Entry{0, INVALID_HANDLE};
+    for (std::size_t index = (hole + 1) & mask; table[index].handle != INVALID_HANDLE; index = (index + 1) & mask) {
+        const std::size_t home = table[index].hash & mask;
+        if (((index - home) & mask) >= ((index - hole) & mask)) {
+            table[hole] = table[index];
+            table[index] = Entry{0, INVALID_HANDLE};
+            hole = index;
+        }
+    }
+
+    deadBytes += keys[handle].length;
+    keys[handle] = KeyRef{FREE_OFFSET, 0, 0};
+    freeHandles.push_back(handle);
+    return true;
+}
+
+std::string_view OrderIndex::key(Handle handle) const {
+    if (handle >= keys.size() || keys[handle].offset == FREE_OFFSET) {
+        return {};
+    }
+    const KeyRef& ref = keys[handle];
+    return std::string_view(arena.data() + ref.offset, ref.length);
+}
+
+std::size_t OrderIndex::size() const {
+    return keys.size() - freeHandles.size();
+}
+
+std::size_t OrderIndex::handleLimit() const {
+    return keys.size();
+}
+
+void OrderIndex::clear() {
+    std::fill(table.begin(), table.end(), Entry{0, INVALID_HANDLE});
+    keys.clear();
+    arena.clear();
+    freeHandles.clear();
+    deadBytes = 0;
+}
+
+void OrderIndex::grow() {
+    std::vector<Entry> larger(table.size() * 2, Entry{0, INVALID_HANDLE});
+    const std::size_t mask = larger.size() - 1;
+    for (Handle handle = 0; handle < keys.size(); ++handle) {
+        if (keys[handle].offset == FREE_OFFSET) {
+            continue;
+        }
+        std::size_t index = keys[handle].hash & mask;
+        while (larger[index].handle != INVALID_HANDLE) {
+            index = (index + 1) & mask;
+        }
+        larger[index] = Entry{keys[handle].hash, handle};
+    }
+    table.swap(larger);
+}
+
+void OrderIndex::compact() {
+    std::vector<char> live;
+    live.reserve(arena.capacity());
+    for (KeyRef& ref : keys) {
+        if (ref.offset == FREE_OFFSET) {
+            continue;
+        }
+        const uint32_t offset = static_cast<uint32_t>(live.size());
+        live.insert(live.end(), arena.begin() + ref.offset, arena.begin() + ref.offset + ref.length);
+        ref.offset = offset;
+    }
+    arena.swap(live);
+    deadBytes = 0;
+}
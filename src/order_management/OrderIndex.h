@@ -0,0 +1,119 @@
+#ifndef ORDER_INDEX_H
+#define ORDER_INDEX_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+/**
+ * @file OrderIndex.h
+ *
+ * @brief Defines the `OrderIndex` class, an open-addressing index that interns strings such as
+ *        exchange order IDs ("ETH-12345678") and client labels into compact integer handles.
+ *
+ * Handles are dense (0, 1, 2, ... in insertion order, erased handles are reused first), so callers
+ * keep per-order data in plain vectors indexed by handle. The table is a power-of-two array of
+ * 8-byte `(hash, handle)` entries probed linearly: a lookup usually touches one cache line of the
+ * table, compares the stored hash first and only then the key bytes. Key bytes live back to back in
+ * one arena, so an entry costs no allocation of its own; growth doubles the table and reuses the
+ * stored hashes.
+ *
+ * `erase` uses backward-shift deletion (no tombstones), so probe lengths stay as short after heavy
+ * churn as in a freshly built table. The bytes of erased keys are reclaimed by compacting the arena
+ * once they outweigh the live ones.
+ */
+
+/**
+ * @class OrderIndex
+ *
+ * @brief String interner: key -> dense handle, handle -> key.
+ *
+ * Not thread-safe; the owner (e.g., `OrderStore`) serializes access.
+ *
+ * ### Example:
+ * ```
+ * OrderIndex ids;
+ * OrderIndex::Handle handle = ids.intern("ETH-12345678"); // 0
+ * ids.find("ETH-12345678");                                // 0
+ * ids.find("ETH-1");                                       // OrderIndex::INVALID_HANDLE
+ * ids.key(handle);                                         // "ETH-12345678"
+ * ids.erase("ETH-12345678");                               // true; handle 0 is reused next
+ * ```
+ */
+class OrderIndex {
+public:
+    using Handle = uint32_t;
+
+    static constexpr Handle INVALID_HANDLE = 0xFFFFFFFFu;
+
+    /**
+     * @brief Constructs an empty index.
+     *
+     * @param expectedKeys Keys to size the table and arena for up front.
+     */
+    explicit OrderIndex(std::size_t expectedKeys = 1024);
+
+    /** @brief Returns the handle of a key, or `INVALID_HANDLE` if it was never interned. */
+    Handle find(std::string_view key) const;
+
+    /** @brief Returns the handle of a key, interning it with a free or the next handle if it is new. */
+    Handle intern(std::string_view key);
+
+    /**
+     * @brief Removes a key; its handle is reused by a later `intern`.
+     *
+     * @return False if the key is not interned.
+     */
+    bool erase(std::string_view key);
+
+    /**
+     * @brief Returns the key of a handle (empty for an erased handle); the view stays valid until
+     *        the next `intern` or `clear`.
+     */
+    std::string_view key(Handle handle) const;
+
+    /** @brief Returns the number of interned keys. */
+    std::size_t size() const;
+
+    /** @brief Returns one past the highest handle ever given out; size per-handle vectors to this. */
+    std::size_t handleLimit() const;
+
+    /** @brief Removes every key; handles start again at 0. */
+    void clear();
+
+private:
+    /** @brief One table entry; `handle == INVALID_HANDLE` marks an empty entry. */
+    struct Entry {
+        uint32_t hash;
+        Handle handle;
+    };
+
+    /** @brief Location of a key in the arena; `offset == FREE_OFFSET` marks an erased handle. */
+    struct KeyRef {
+        uint32_t offset;
+        uint32_t length;
+        uint32_t hash;
+    };
+
+    static constexpr uint32_t FREE_OFFSET = 0xFFFFFFFFu;
+
+    static uint32_t hashOf(std::string_view key);
+
+    /** @brief Returns the entry index holding `key`, or the empty entry where it belongs. */
+    std::size_t probe(std::string_view key, uint32_t hash) const;
+
+    /** @brief Doubles the table and re-inserts every handle by its stored hash. */
+    void grow();
+
+    /** @brief Rewrites the arena with the live keys only. */
+    void compact();
+
+    std::vector<Entry> table;         /**< Power-of-two sized, at most half full. */
+    std::vector<KeyRef> keys;         /**< Indexed by handle. */
+    std::vector<char> arena;          /**< Key bytes, back to back. */
+    std::vector<Handle> freeHandles;  /**< Erased handles, reused last-in first-out. */
+    std::size_t deadBytes{0};         /**< Arena bytes of erased keys. */
+};
+
+#endif // ORDER_INDEX_H
@@ -1,9 +1,14 @@
 #include "OrderManager.h"
+#include "OrderStore.h"
 #include <curl/curl.h>
 #include <nlohmann/json.hpp>
 #include <iostream>
 #include <sstream>
 #include <fmt/color.h>
+#include <algorithm>
+#include <future>
+#include <mutex>
+#include <utility>
 
 // Define color constants for clarity
 const auto ERROR_COLOR = fmt::fg(fmt::color::red);
@@ -293,3 +298,218 @@ std::string OrderManager::getAllOrders(const std::string& instrument) {
 
     return response;
 }
+
+/**
+ * @brief Sends an authenticated JSON-RPC request, usable from several threads at once.
+ * 
+ * `curl_global_init` is not thread-safe, so it runs once before the first
+ * request instead of being left to the implicit call in `curl_easy_init`.
+ */
+std::string OrderManager::postPrivate(const std::string& method, const json& params) const {
+    static std::once_flag curlInitialized;
+    std::call_once(curlInitialized, []() { curl_global_init(CURL_GLOBAL_DEFAULT); });
+
+    CURL* curl = curl_easy_init();
+    std::string response;
+
+    if (!curl) {
+        std::cerr << fmt::format(ERROR_COLOR, "Failed to initialize CURL!\n");
+        return "";
+    }
+
+    try {
+        std::string url = "https://test.deribit.com/api/v2/" + method;
+
+        json requestBody = {
+            {"jsonrpc", "2.0"},
+            {"method", method},
+            {"id", 1},
+            {"params", params}
+        };
+
+        std::string data = requestBody.dump();
+
+        struct curl_slist* headers = nullptr;
+        headers = curl_slist_append(headers, ("Authorization: Bearer " + accessToken).c_str());
+        headers = curl_slist_append(headers, "Content-Type: application/json");
+
+        curl_easy_setopt(curl, CURLOPT_URL, url.c_str());
+        curl_easy_setopt(curl, CURLOPT_POST, 1L);
+        curl_easy_setopt(curl, CURLOPT_POSTFIELDS, data.c_str());
+        curl_easy_setopt(curl, CURLOPT_HTTPHEADER, headers);
+        curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, WriteCallback);
+        curl_easy_setopt(curl, CURLOPT_WRITEDATA, &response);
+        curl_easy_setopt(curl, CURLOPT_NOSIGNAL, 1L); // Required when several threads perform requests
+
+        CURLcode res = curl_easy_perform(curl);
+
+        if (res != CURLE_OK) {
+            std::cerr << fmt::format(ERROR_COLOR, "CURL Error: {}\n", curl_easy_strerror(res));
+            response.clear();
+        }
+
+        curl_slist_free_all(headers);
+        curl_easy_cleanup(curl);
+    } catch (const std::exception& e) {
+        std::cerr << fmt::format(ERROR_COLOR, "Error during {}: {}\n", method, e.what());
+    }
+
+    return response;
+}
+
+/**
+ * @brief Cancels all open orders, or all open orders of one instrument.
+ * 
+ * @param instrument The instrument name, or an empty string for every instrument.
+ * @return A JSON string containing the API response.
+ */
+std::string OrderManager::cancelAllOrders(const std::string& instrument) {
+    if (instrument.empty()) {
+        return postPrivate("private/cancel_all", json::object());
+    }
+    return postPrivate("private/cancel_all_by_instrument", {{"instrument_name", instrument}});
+}
+
+/**
+ * @brief Fetches the current state of one order.
+ * 
+ * @param orderId The unique identifier of the order.
+ * @return A JSON string containing the API response.
+ */
+std::string OrderManager::getOrderState(const std::string& orderId) {
+    return postPrivate("private/get_order_state", {{"order_id", orderId}});
+}
+
+/**
+ * @brief Fetches all open orders of a currency.
+ * 
+ * @param currency The currency (e.g., "BTC").
+ * @param kind The instrument kind, or an empty string for all kinds.
+ * @return A JSON string containing the API response.
+ */
+std::string OrderManager::getOpenOrdersByCurrency(const std::string& currency, const std::string& kind) {
+    json params = {{"currency", currency}};
+    if (!kind.empty()) {
+        params["kind"] = kind;
+    }
+    return postPrivate("private/get_open_orders_by_currency", params);
+}
+
+/**
+ * @brief Fetches the open orders of all currencies.
+ * 
+ * @param kind The instrument kind, or an empty string for all kinds.
+ * @return A JSON string containing the API response.
+ */
+std::string OrderManager::getAllOpenOrders(const std::string& kind) {
+    json params = json::object();
+    if (!kind.empty()) {
+        params["kind"] = kind;
+    }
+    return postPrivate("private/get_open_orders", params);
+}
+
+/**
+ * @brief Fetches the open orders of each currency concurrently and stores them.
+ */
+std::size_t OrderManager::reconcileOpenOrders(const std::vector<std::string>& currencies, OrderStore& store) {
+    std::vector<std::future<std::size_t>> pending;
+    for (const auto& currency : currencies) {
+        pending.push_back(std::async(std::launch::async, [this, currency, &store]() -> std::size_t {
+            json response = json::parse(getOpenOrdersByCurrency(currency), nullptr, false);
+            if (response.is_discarded() || !response.contains("result")) {
+                std::cerr << fmt::format(ERROR_COLOR, "Failed to fetch open orders for {}\n", currency);
+                return 0;
+            }
+            return store.upsertAll(response["result"]);
+        }));
+    }
+
+    std::size_t stored = 0;
+    for (auto& future : pending) {
+        stored += future.get();
+    }
+    return stored;
+}
+
+/**
+ * @brief Pages through the order history of each currency, several pages at a time.
+ * 
+ * ### Workflow:
+ * 1. One task per currency; each task requests `pagesInFlight` consecutive
+ *    offsets concurrently.
+ * 2. Every page is written into the store as soon as it completes; a failed
+ *    page is retried before it counts as failed.
+ * 3. The task stops after the first wave that contains a short page, or
+ *    reports failure after the first wave with a page that kept failing.
+ */
+bool OrderManager::fetchOrderHistory(const std::vector<std::string>& currencies, OrderStore& store, std::size_t& fetched,
+                                     std::size_t pageSize, std::size_t pagesInFlight) {
+    pageSize = std::max<std::size_t>(pageSize, 1);
+    pagesInFlight = std::max<std::size_t>(pagesInFlight, 1);
+
+    // Outcome of one page: full, short (the last one) or failed
+    enum class PageResult : char { Full, Last, Failed };
+
+    auto fetchPage = [this, &store, pageSize](const std::string& currency, std::size_t offset, PageResult& result) -> std::size_t {
+        json params = {
+            {"currency", currency},
+            {"count", pageSize},
+            {"offset", offset},
+            {"include_unfilled", true}
+        };
+
+        for (int attempt = 1; attempt <= HISTORY_PAGE_ATTEMPTS; ++attempt) {
+            json response = json::parse(postPrivate("private/get_order_history_by_currency", params), nullptr, false);
+            if (!response.is_discarded() && response.contains("result") && response["result"].is_array()) {
+                const json& page = response["result"];
+                result = page.size() < pageSize ? PageResult::Last : PageResult::Full;
+                store.upsertAll(page);
+                return page.size();
+            }
+            std::cerr << fmt::format(ERROR_COLOR, "Order history page {} of {} failed (attempt {}/{})\n",
+                                     offset / pageSize, currency, attempt, HISTORY_PAGE_ATTEMPTS);
+        }
+        result = PageResult::Failed;
+        return 0;
+    };
+
+    std::vector<std::future<std::pair<std::size_t, bool>>> perCurrency;
+    for (const auto& currency : currencies) {
+        perCurrency.push_back(std::async(std::launch::async, [currency, pageSize, pagesInFlight, &fetchPage]() {
+            std::size_t count = 0;
+            std::size_t offset = 0;
+            bool done = false;
+            bool failed = false;
+
+            while (!done) {
+                std::vector<std::future<std::size_t>> wave;
+                std::vector<PageResult> results(pagesInFlight, PageResult::Full);
+                for (std::size_t i = 0; i < pagesInFlight; ++i, offset += pageSize) {
+                    wave.push_back(std::async(std::launch::async, [&fetchPage, &currency, &results, offset, i]() {
+                        return fetchPage(currency, offset, results[i]);
+                    }));
+                }
+
+                for (std::size_t i = 0; i < wave.size(); ++i) {
+                    count += wave[i].get();
+                    done = done || results[i] != PageResult::Full;
+                    failed = failed || results[i] == PageResult::Failed;
+                }
+            }
+            return std::make_pair(count, !failed);
+        }));
+    }
+
+    fetched = 0;
+    bool complete = true;
+    for (std::size_t i = 0; i < perCurrency.size(); ++i) {
+        const auto result = perCurrency[i].get();
+        fetched += result.first;
+        if (!result.second) {
+            std::cerr << fmt::format(ERROR_COLOR, "Order history of {} is incomplete\n", currencies[i]);
+            complete = false;
+        }
+    }
+    return complete;
+}
@@ -2,6 +2,12 @@
 #define ORDER_MANAGER_H
 
 #include <string>
+#include <vector>
+#include <cstddef>
+#include <nlohmann/json_fwd.hpp>
+#include "OrderEntry.h"
+
+class OrderStore;
 
 /**
  * @class OrderManager
@@ -16,9 +22,12 @@
  * to interact with the trading system and returns the API response as 
  * a JSON string.
  * 
+ * It implements the `OrderEntry` interface, so it can be swapped for the FIX
+ * transport (`FixOrderManager`) wherever only order entry is needed.
+ * 
  * @note Requires a valid access token for API authentication.
  */
-class OrderManager {
+class OrderManager : public OrderEntry {
 public:
     /**
      * @brief Constructor for the OrderManager class.
@@ -44,7 +53,7 @@ public:
      * quantity, and price. The response contains the order details or an 
      * error message if the request fails.
      */
-    std::string placeOrder(const std::string& instrument, const std::string& side, double quantity, double price);
+    std::string placeOrder(const std::string& instrument, const std::string& side, double quantity, double price) override;
 
     /**
      * @brief Modifies an existing order.
@@ -58,7 +67,7 @@ public:
      * existing limit order. The order ID must be provided to identify 
      * the order to be modified.
      */
-    std::string modifyOrder(const std::string& orderId, double newQuantity, double newPrice);
+    std::string modifyOrder(const std::string& orderId, double newQuantity, double newPrice) override;
 
     /**
      * @brief Cancels an active order.
@@ -70,7 +79,26 @@ public:
      * by its order ID. The response includes the status of the cancellation 
      * or an error message if the cancellation fails.
      */
-    std::string cancelOrder(const std::string& orderId);
+    std::string cancelOrder(const std::string& orderId) override;
+
+    /**
+     * @brief Cancels all open orders, optionally only those of one instrument.
+     * 
+     * @param instrument The instrument name, or an empty string for every instrument.
+     * @return A JSON string containing the API response.
+     * 
+     * The "kill switch": one `private/cancel_all` (or
+     * `private/cancel_all_by_instrument`) request instead of one cancel per order.
+     */
+    std::string cancelAllOrders(const std::string& instrument = "") override;
+
+    /**
+     * @brief Retrieves the current state of one order.
+     * 
+     * @param orderId The unique identifier of the order.
+     * @return A JSON string containing the `private/get_order_state` response.
+     */
+    std::string getOrderState(const std::string& orderId) override;
 
     /**
      * @brief Retrieves all open orders for a specific instrument.
@@ -84,7 +112,73 @@ public:
      */
     std::string getAllOrders(const std::string& instrument);
 
+    /**
+     * @brief Retrieves all open orders of a currency in a single request.
+     * 
+     * @param currency The currency (e.g., "BTC").
+     * @param kind The instrument kind ("future", "option", ...), or an empty string for all kinds.
+     * @return A JSON string containing the API response.
+     * 
+     * Replaces one `getAllOrders` call per instrument with one
+     * `private/get_open_orders_by_currency` call per currency.
+     */
+    std::string getOpenOrdersByCurrency(const std::string& currency, const std::string& kind = "");
+
+    /**
+     * @brief Retrieves the open orders of every currency in a single request.
+     * 
+     * @param kind The instrument kind, or an empty string for all kinds.
+     * @return A JSON string containing the `private/get_open_orders` response.
+     */
+    std::string getAllOpenOrders(const std::string& kind = "");
+
+    /**
+     * @brief Loads the open orders of several currencies into a local store.
+     * 
+     * @param currencies The currencies to reconcile (e.g., {"BTC", "ETH"}).
+     * @param store The store receiving the orders.
+     * @return The number of orders stored.
+     * 
+     * One request per currency is issued, all of them concurrently, and each
+     * result is written into the store as soon as it arrives.
+     */
+    std::size_t reconcileOpenOrders(const std::vector<std::string>& currencies, OrderStore& store);
+
+    /**
+     * @brief Fetches the order history of several currencies into a local store.
+     * 
+     * @param currencies The currencies to fetch (e.g., {"BTC", "ETH"}).
+     * @param store The store receiving the orders.
+     * @param fetched Receives the number of orders fetched.
+     * @param pageSize The number of orders per page (`count`).
+     * @param pagesInFlight The number of pages requested concurrently per currency.
+     * @return True if the whole history was fetched; false if a page still failed
+     *         after its retries (the store then holds a partial history).
+     * 
+     * `private/get_order_history_by_currency` pages by offset, so the offsets of
+     * the next `pagesInFlight` pages are known up front and requested in
+     * parallel. Each page is streamed into the store as it completes; a currency
+     * is done once a page comes back shorter than `pageSize`. A failed page is
+     * retried `HISTORY_PAGE_ATTEMPTS` times before the currency is given up.
+     */
+    bool fetchOrderHistory(const std::vector<std::string>& currencies, OrderStore& store, std::size_t& fetched,
+                           std::size_t pageSize = 100, std::size_t pagesInFlight = 4);
+
+    static constexpr int HISTORY_PAGE_ATTEMPTS = 3; /**< Attempts per order history page. */
+
 private:
+    /**
+     * @brief Sends an authenticated JSON-RPC request over HTTP.
+     * 
+     * @param method The API method (e.g., "private/get_open_orders_by_currency").
+     * @param params The request parameters.
+     * @return The raw response, or an empty string on failure.
+     * 
+     * Safe to call from several threads at once: each call uses its own CURL
+     * handle, and libcurl's global state is initialized exactly once.
+     */
+    std::string postPrivate(const std::string& method, const nlohmann::json& params) const;
+
     /**
      * @brief The access token used for API authentication.
      * 
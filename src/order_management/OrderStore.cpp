@@ -0,0 +1,206 @@
+#include "OrderStore.h"
+#include <nlohmann/json.hpp>
+
+using json = nlohmann::json;
+
+/**
+ * @file OrderStore.cpp
+ *
+ * @brief Implements the `OrderStore` class, a thread-safe local store of orders.
+ */
+
+namespace {
+
+/** @brief Reads a numeric field that may be missing or `null` (e.g., the price of a market order). */
+double numberOr(const json& object, const char* key, double fallback) {
+    auto it = object.find(key);
+    return it != object.end() && it->is_number() ? it->get<double>() : fallback;
+}
+
+/** @brief Copies a string field into `out` (empty if missing), reusing `out`'s buffer. */
+void assignString(const json& object, const char* key, std::string& out) {
+    auto it = object.find(key);
+    if (it != object.end() && it->is_string()) {
+        out.assign(it->get_ref<const std::string&>());
+    } else {
+        out.clear();
+    }
+}
+
+} // namespace
+
+bool StoredOrder::isOpen() const {
+    return orderState == "open" || orderState == "untriggered";
+}
+
+bool OrderStore::upsert(const json& order) {
+    std::lock_guard<std::mutex> lock(mutex);
+    return upsertLocked(order);
+}
+
+/**
+ * @brief Stores a whole page under a single lock acquisition.
+ */
+std::size_t OrderStore::upsertAll(const json& orders) {
+    if (!orders.is_array()) {
+        return 0;
+    }
+
+    std::lock_guard<std::mutex> lock(mutex);
+    std::size_t stored = 0;
+    for (const auto& order : orders) {
+        if (upsertLocked(order)) {
+            ++stored;
+        }
+    }
+    return stored;
+}
+
+/**
+ * @brief Keeps the newest version of an order by `last_update_timestamp`. A known order is updated
+ *        in place, so its strings keep their capacity across execution reports; a new order takes
+ *        over the slot (and string buffers) of a retired one when there is one.
+ */
+bool OrderStore::upsertLocked(const json& order) {
+    if (!order.is_object()) {
+        return false;
+    }
+    auto id = order.find("order_id");
+    if (id == order.end() || !id->is_string()) {
+        return false;
+    }
+    const std::string& orderId = id->get_ref<const std::string&>();
+    const int64_t lastUpdate = static_cast<int64_t>(numberOr(order, "last_update_timestamp", 0.0));
+
+    OrderIndex::Handle handle = ids.find(orderId);
+    if (handle != OrderIndex::INVALID_HANDLE && orders[handle].lastUpdate > lastUpdate) {
+        return false; // A newer version arrived first (pages are fetched in parallel)
+    }
+    if (handle == OrderIndex::INVALID_HANDLE) {
+        const OrderIndex::Handle retiredHandle = retired.find(orderId);
+        if (retiredHandle != OrderIndex::INVALID_HANDLE && retiredUpdate[retiredHandle] >= lastUpdate) {
+            return false; // The order already finished
+        }
+        handle = ids.intern(orderId);
+        if (handle >= orders.size()) {
+            orders.resize(ids.handleLimit());
+        }
+        orders[handle].orderId = orderId;
+    }
+
+    StoredOrder& entry = orders[handle];
+    entry.lastUpdate = lastUpdate;
+    assignString(order, "instrument_name", entry.instrument);
+    assignString(order, "label", entry.label);
+    assignString(order, "direction", entry.direction);
+    assignString(order, "order_state", entry.orderState);
+    entry.price = numberOr(order, "price", 0.0);
+    entry.amount = numberOr(order, "amount", 0.0);
+    entry.filledAmount = numberOr(order, "filled_amount", 0.0);
+
+    if (!entry.label.empty()) {
+        const OrderIndex::Handle labelHandle = labels.intern(entry.label);
+        if (labelHandle >= labelOrder.size()) {
+            labelOrder.resize(labelHandle + 1, OrderIndex::INVALID_HANDLE);
+        }
+        labelOrder[labelHandle] = handle;
+    }
+
+    if (!entry.isOpen()) {
+        retireLocked(handle);
+    }
+    return true;
+}
+
+/**
+ * @brief The oldest remembered ID is forgotten once `RETIRED_CAPACITY` IDs are remembered, so the
+ *        memory of finished orders stays bounded too.
+ */
+void OrderStore::retireLocked(OrderIndex::Handle handle) {
+    StoredOrder& entry = orders[handle];
+
+    OrderIndex::Handle retiredHandle = retired.find(entry.orderId);
+    if (retiredHandle == OrderIndex::INVALID_HANDLE) {
+        if (retired.size() == RETIRED_CAPACITY) {
+            retired.erase(retired.key(retiredRing[retiredNext]));
+        }
+        retiredHandle = retired.intern(entry.orderId);
+        if (retiredHandle >= retiredUpdate.size()) {
+            retiredUpdate.resize(retired.handleLimit());
+        }
+        if (retiredRing.size() < RETIRED_CAPACITY) {
+            retiredRing.push_back(retiredHandle);
+        } else {
+            retiredRing[retiredNext] = retiredHandle;
+            retiredNext = (retiredNext + 1) % RETIRED_CAPACITY;
+        }
+    }
+    retiredUpdate[retiredHandle] = entry.lastUpdate;
+
+    if (!entry.label.empty()) {
+        const OrderIndex::Handle labelHandle = labels.find(entry.label);
+        if (labelHandle != OrderIndex::INVALID_HANDLE && labelOrder[labelHandle] == handle) {
+            labels.erase(entry.label);
+            labelOrder[labelHandle] = OrderIndex::INVALID_HANDLE;
+        }
+    }
+
+    ids.erase(entry.orderId);
+    entry.orderId.clear();
+    entry.orderState.clear();
+}
+
+std::size_t OrderStore::onUserOrders(const json& data) {
+    if (data.is_array()) {
+        return upsertAll(data);
+    }
+    return upsert(data) ? 1 : 0;
+}
+
+bool OrderStore::find(std::string_view orderId, StoredOrder& out) const {
+    std::lock_guard<std::mutex> lock(mutex);
+    const OrderIndex::Handle handle = ids.find(orderId);
+    if (handle == OrderIndex::INVALID_HANDLE) {
+        return false;
+    }
+    out = orders[handle];
+    return true;
+}
+
+bool OrderStore::findByLabel(std::string_view label, StoredOrder& out) const {
+    std::lock_guard<std::mutex> lock(mutex);
+    const OrderIndex::Handle labelHandle = labels.find(label);
+    if (labelHandle == OrderIndex::INVALID_HANDLE || labelOrder[labelHandle] == OrderIndex::INVALID_HANDLE) {
+        return false;
+    }
+    out = orders[labelOrder[labelHandle]];
+    return true;
+}
+
+std::vector<StoredOrder> OrderStore::openOrders() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    std::vector<StoredOrder> open;
+    for (const auto& order : orders) {
+        if (order.isOpen()) {
+            open.push_back(order);
+        }
+    }
+    return open;
+}
+
+std::size_t OrderStore::size() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return ids.size();
+}
+
+void OrderStore::clear() {
+    std::lock_guard<std::mutex> lock(mutex);
+    ids.clear();
+    labels.clear();
+    orders.clear();
+    labelOrder.clear();
+    retired.clear();
+    retiredUpdate.clear();
+    retiredRing.clear();
+    retiredNext = 0;
+}
@@ -0,0 +1,143 @@
+#ifndef ORDER_STORE_H
+#define ORDER_STORE_H
+
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include <mutex>
+#include <string_view>
+#include <nlohmann/json_fwd.hpp>
+#include "OrderIndex.h"
+
+/**
+ * @file OrderStore.h
+ *
+ * @brief Defines the `OrderStore` class, a local, thread-safe store of orders keyed by order ID.
+ *
+ * The store is filled during startup reconciliation (open orders by currency, paginated order
+ * history) and can be kept current from `user.orders` notifications afterwards. Pages fetched in
+ * parallel are streamed into it as they arrive, so every write is serialized by a mutex and the
+ * newest version of an order (by `last_update_timestamp`) always wins regardless of arrival order.
+ *
+ * Order IDs and labels are interned by `OrderIndex` into dense handles, and orders live in a vector
+ * indexed by handle, so the lookup behind every `user.orders` execution report is one open-addressing
+ * probe and updating a known order reuses its storage.
+ *
+ * Only live orders are kept: an order that reaches a terminal state (filled, cancelled, rejected)
+ * leaves the index and its slot is reused by the next new order, so the store and `openOrders` scale
+ * with the open orders rather than with every order ever seen. The IDs of the most recently retired
+ * orders are remembered with their last update, so an older open version arriving late (pages are
+ * fetched in parallel) does not bring a finished order back.
+ */
+
+/**
+ * @struct StoredOrder
+ *
+ * @brief A locally cached order.
+ */
+struct StoredOrder {
+    std::string orderId;          /**< Exchange order ID. */
+    std::string instrument;       /**< Instrument name. */
+    std::string label;            /**< User label, if any. */
+    std::string direction;        /**< "buy" or "sell". */
+    std::string orderState;       /**< "open", "filled", "cancelled", ... */
+    double price{0.0};            /**< Limit price (0 for market orders). */
+    double amount{0.0};           /**< Order amount. */
+    double filledAmount{0.0};     /**< Filled amount. */
+    int64_t lastUpdate{0};        /**< Exchange `last_update_timestamp` (ms). */
+
+    /** @brief Returns true while the order can still trade. */
+    bool isOpen() const;
+};
+
+/**
+ * @class OrderStore
+ *
+ * @brief Thread-safe store of orders keyed by order ID, with a secondary index on labels.
+ *
+ * ### Example:
+ * ```
+ * OrderStore store;
+ * orderManager.reconcileOpenOrders({"BTC", "ETH"}, store);
+ * for (const auto& order : store.openOrders()) {
+ *     std::cout << order.orderId << " " << order.instrument << std::endl;
+ * }
+ * ```
+ */
+class OrderStore {
+public:
+    /**
+     * @brief Inserts or updates one order from its exchange JSON representation.
+     *
+     * @param order An order object as returned by the order endpoints or `user.orders`.
+     * @return True if the order was stored; false if it is malformed or older than the stored version.
+     */
+    bool upsert(const nlohmann::json& order);
+
+    /**
+     * @brief Inserts or updates every order of a JSON array.
+     *
+     * @param orders An array of order objects (e.g., the `result` of `get_open_orders_by_currency`).
+     * @return The number of orders stored.
+     */
+    std::size_t upsertAll(const nlohmann::json& orders);
+
+    /**
+     * @brief Looks up a live order.
+     *
+     * @param orderId The exchange order ID.
+     * @param out Receives a copy of the order if it is found.
+     * @return True if the order is known and not yet in a terminal state.
+     */
+    bool find(std::string_view orderId, StoredOrder& out) const;
+
+    /**
+     * @brief Looks up the latest live order carrying a label.
+     *
+     * @param label The client label (e.g., the label given to `private/buy`).
+     * @param out Receives a copy of the order if it is found.
+     * @return True if the latest order with this label is known and still live.
+     */
+    bool findByLabel(std::string_view label, StoredOrder& out) const;
+
+    /**
+     * @brief Applies a `user.orders` notification.
+     *
+     * @param data The notification's `params.data`: one order (`raw` channels) or an array of
+     *             orders (aggregated channels).
+     * @return The number of orders stored.
+     */
+    std::size_t onUserOrders(const nlohmann::json& data);
+
+    /** @brief Returns a copy of all orders that are still open. */
+    std::vector<StoredOrder> openOrders() const;
+
+    /** @brief Returns the number of live orders. */
+    std::size_t size() const;
+
+    /** @brief Removes all orders. */
+    void clear();
+
+private:
+    /** @brief Number of retired order IDs remembered to reject late stale versions. */
+    static constexpr std::size_t RETIRED_CAPACITY = 4096;
+
+    /** @brief Stores an order; the caller must hold the mutex. */
+    bool upsertLocked(const nlohmann::json& order);
+
+    /** @brief Drops a terminal order from the live index; the caller must hold the mutex. */
+    void retireLocked(OrderIndex::Handle handle);
+
+    mutable std::mutex mutex;                   /**< Serializes concurrent page writers. */
+    OrderIndex ids;                             /**< Live order ID -> handle. */
+    OrderIndex labels;                          /**< Label -> label handle. */
+    std::vector<StoredOrder> orders;            /**< Indexed by order handle; free slots have no order ID. */
+    std::vector<OrderIndex::Handle> labelOrder; /**< Label handle -> handle of its latest order. */
+    OrderIndex retired;                         /**< Recently retired order ID -> retired handle. */
+    std::vector<int64_t> retiredUpdate;         /**< Retired handle -> last update of the order. */
+    std::vector<OrderIndex::Handle> retiredRing; /**< Retired handles, oldest first from `retiredNext`. */
+    std::size_t retiredNext{0};                 /**< Ring position of the oldest retired handle. */
+};
+
+#endif // ORDER_STORE_H
@@ -0,0 +1,439 @@
+#include "OrderSubmissionQueue.h"
+#include "OrderEntry.h"
+#include "EditConflator.h"
+#include "../auth/RateLimiter.h"
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#include <vector>
+#include <nlohmann/json.hpp>
+#include <fmt/color.h>
+#include <fmt/format.h>
+
+// Define color constants for clarity
+const auto ERROR_COLOR = fmt::fg(fmt::color::red);
+const auto SUCCESS_COLOR = fmt::fg(fmt::color::cyan);
+const auto INFO_COLOR = fmt::fg(fmt::color::blue);
+const auto HIGHLIGHT_COLOR = fmt::fg(fmt::color::yellow);
+
+using json = nlohmann::json;
+
+/**
+ * @file OrderSubmissionQueue.cpp
+ *
+ * @brief Implements the `OrderSubmissionQueue` class: lock-free intent submission, the order I/O
+ *        thread and per-strategy completion delivery.
+ */
+
+namespace {
+
+/** @brief Copies a string into a fixed-size field, always leaving it NUL-terminated. */
+template <std::size_t N>
+void copyField(char (&field)[N], const std::string& value) {
+    const std::size_t length = std::min(value.size(), N - 1);
+    std::memcpy(field, value.data(), length);
+    field[length] = '\0';
+}
+
+template <std::size_t N>
+std::string fieldString(const char (&field)[N]) {
+    return std::string(field, strnlen(field, N));
+}
+
+int64_t steadyNowNs() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+/** @brief Reads a numeric field that may be missing or `null`. */
+double numberOr(const json& object, const char* key, double fallback) {
+    auto it = object.find(key);
+    return it != object.end() && it->is_number() ? it->get<double>() : fallback;
+}
+
+} // namespace
+
+OrderSubmissionQueue::OrderSubmissionQueue(OrderEntry& orderManager, RateLimiter* rateLimiter)
+    : orders(orderManager), limiter(rateLimiter), conflator(std::make_unique<EditConflator>()), conflatedCount(0), strategyCount(0), running(false) {
+    for (auto& ring : intents) {
+        ring = std::make_unique<IntentRing>();
+    }
+}
+
+OrderSubmissionQueue::~OrderSubmissionQueue() {
+    stop();
+}
+
+void OrderSubmissionQueue::start() {
+    if (!running.exchange(true)) {
+        io = std::thread([this]() { run(); });
+    }
+}
+
+void OrderSubmissionQueue::stop() {
+    if (running.exchange(false) && io.joinable()) {
+        wakeIfParked();
+        io.join();
+    }
+}
+
+/**
+ * @brief Producer half of the parking handshake: the fence orders the ring push before the
+ *        `parked` load, pairing with the fence in `run`, so either the I/O thread sees the intent
+ *        or this sees `parked` set. Notifying under `parkMutex` cannot fall between the I/O
+ *        thread's last check and its wait.
+ */
+void OrderSubmissionQueue::wakeIfParked() {
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (parked.load(std::memory_order_relaxed)) {
+        std::lock_guard<std::mutex> lock(parkMutex);
+        wakeup.notify_one();
+    }
+}
+
+/**
+ * @brief Publishes a new completion ring; the count is released after the ring exists, so the
+ *        I/O thread never sees a registered strategy without its ring.
+ */
+uint32_t OrderSubmissionQueue::registerStrategy() {
+    std::lock_guard<std::mutex> lock(registerMutex);
+    const uint32_t id = strategyCount.load(std::memory_order_relaxed);
+    if (id >= MAX_STRATEGIES) {
+        return INVALID_STRATEGY;
+    }
+    completions[id] = std::make_unique<CompletionRing>();
+    strategyCount.store(id + 1, std::memory_order_release);
+    return id;
+}
+
+OrderPriority OrderSubmissionQueue::priorityOf(OrderIntent::Type type) {
+    switch (type) {
+    case OrderIntent::Type::Cancel:
+    case OrderIntent::Type::CancelAll:
+        return OrderPriority::Cancel;
+    case OrderIntent::Type::Edit:
+        return OrderPriority::Edit;
+    case OrderIntent::Type::Query:
+        return OrderPriority::Query;
+    default:
+        return OrderPriority::New;
+    }
+}
+
+bool OrderSubmissionQueue::submit(OrderIntent intent) {
+    if (intent.strategyId >= strategyCount.load(std::memory_order_acquire)) {
+        return false;
+    }
+
+    const auto cls = static_cast<std::size_t>(priorityOf(intent.type));
+    intent.enqueuedNs = steadyNowNs();
+    if (!intents[cls]->tryPush(intent)) {
+        counters[cls].rejected.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+    wakeIfParked();
+    return true;
+}
+
+QueueDelayMetrics OrderSubmissionQueue::metrics(OrderPriority priority) const {
+    const ClassCounters& source = counters[static_cast<std::size_t>(priority)];
+    QueueDelayMetrics snapshot;
+    snapshot.sent = source.sent.load(std::memory_order_relaxed);
+    snapshot.rejected = source.rejected.load(std::memory_order_relaxed);
+    snapshot.totalDelayNs = source.totalDelayNs.load(std::memory_order_relaxed);
+    snapshot.maxDelayNs = source.maxDelayNs.load(std::memory_order_relaxed);
+    return snapshot;
+}
+
+uint64_t OrderSubmissionQueue::conflatedEdits() const {
+    return conflatedCount.load(std::memory_order_relaxed);
+}
+
+bool OrderSubmissionQueue::placeOrder(uint32_t strategyId, uint64_t requestId, const std::string& instrument,
+                                      const std::string& side, double amount, double price) {
+    OrderIntent intent{};
+    intent.requestId = requestId;
+    intent.strategyId = strategyId;
+    intent.type = side == "sell" ? OrderIntent::Type::Sell : OrderIntent::Type::Buy;
+    copyField(intent.instrument, instrument);
+    intent.amount = amount;
+    intent.price = price;
+    return submit(intent);
+}
+
+bool OrderSubmissionQueue::modifyOrder(uint32_t strategyId, uint64_t requestId, const std::string& orderId, double amount, double price) {
+    OrderIntent intent{};
+    intent.requestId = requestId;
+    intent.strategyId = strategyId;
+    intent.type = OrderIntent::Type::Edit;
+    copyField(intent.orderId, orderId);
+    intent.amount = amount;
+    intent.price = price;
+    return submit(intent);
+}
+
+bool OrderSubmissionQueue::cancelOrder(uint32_t strategyId, uint64_t requestId, const std::string& orderId) {
+    OrderIntent intent{};
+    intent.requestId = requestId;
+    intent.strategyId = strategyId;
+    intent.type = OrderIntent::Type::Cancel;
+    copyField(intent.orderId, orderId);
+    return submit(intent);
+}
+
+bool OrderSubmissionQueue::cancelAll(uint32_t strategyId, uint64_t requestId, const std::string& instrument) {
+    OrderIntent intent{};
+    intent.requestId = requestId;
+    intent.strategyId = strategyId;
+    intent.type = OrderIntent::Type::CancelAll;
+    copyField(intent.instrument, instrument);
+    return submit(intent);
+}
+
+bool OrderSubmissionQueue::queryOrder(uint32_t strategyId, uint64_t requestId, const std::string& orderId) {
+    OrderIntent intent{};
+    intent.requestId = requestId;
+    intent.strategyId = strategyId;
+    intent.type = OrderIntent::Type::Query;
+    copyField(intent.orderId, orderId);
+    return submit(intent);
+}
+
+bool OrderSubmissionQueue::poll(uint32_t strategyId, OrderCompletion& out) {
+    if (strategyId >= strategyCount.load(std::memory_order_acquire)) {
+        return false;
+    }
+    return completions[strategyId]->tryPop(out);
+}
+
+/**
+ * @brief Drains the class rings until stopped; intents still queued at `stop` are executed first.
+ *
+ * Priorities are re-evaluated before every request (the frame boundary), so a cancel enqueued
+ * while a new order is in flight is the very next request sent.
+ */
+void OrderSubmissionQueue::run() {
+    OrderIntent intent;
+    uint64_t queueDelay = 0;
+    auto idleSince = std::chrono::steady_clock::now();
+    while (true) {
+        if (next(intent, queueDelay)) {
+            execute(intent, queueDelay);
+            idleSince = std::chrono::steady_clock::now();
+            continue;
+        }
+        if (!running) {
+            break;
+        }
+        if (std::chrono::steady_clock::now() - idleSince < SPIN_BEFORE_PARK) {
+            std::this_thread::yield();
+            continue;
+        }
+
+        // Park: announce it, then look once more before waiting (see `wakeIfParked`)
+        bool found;
+        {
+            std::unique_lock<std::mutex> lock(parkMutex);
+            parked.store(true, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            found = next(intent, queueDelay);
+            if (!found && running) {
+                wakeup.wait_for(lock, PARK_TIMEOUT);
+            }
+            parked.store(false, std::memory_order_relaxed);
+        }
+        if (found) {
+            execute(intent, queueDelay);
+        }
+        idleSince = std::chrono::steady_clock::now();
+    }
+}
+
+/**
+ * @brief The edit class is served from `readyEdits`, which the conflator fills; every other class
+ *        is served straight from its ring.
+ */
+bool OrderSubmissionQueue::next(OrderIntent& out, uint64_t& delayNs) {
+    for (std::size_t cls = 0; cls < PRIORITY_COUNT; ++cls) {
+        if (cls == static_cast<std::size_t>(OrderPriority::Edit)) {
+            absorbEdits();
+            if (readyEdits.empty()) {
+                continue;
+            }
+            out = readyEdits.front();
+            readyEdits.pop_front();
+        } else if (!intents[cls]->tryPop(out)) {
+            continue;
+        }
+
+        const uint64_t delay = static_cast<uint64_t>(std::max<int64_t>(steadyNowNs() - out.enqueuedNs, 0));
+        delayNs = delay;
+        ClassCounters& counter = counters[cls];
+        counter.sent.fetch_add(1, std::memory_order_relaxed);
+        counter.totalDelayNs.fetch_add(delay, std::memory_order_relaxed);
+        if (delay > counter.maxDelayNs.load(std::memory_order_relaxed)) {
+            counter.maxDelayNs.store(delay, std::memory_order_relaxed); // Only the I/O thread writes it
+        }
+        return true;
+    }
+    return false;
+}
+
+void OrderSubmissionQueue::execute(const OrderIntent& intent, uint64_t queueDelay) {
+    std::string raw;
+    if (limiter && !limiter->tryAcquire()) {
+        raw = json{{"error", {{"message", "Rate limit exceeded"}}}}.dump();
+    } else {
+        switch (intent.type) {
+        case OrderIntent::Type::Buy:
+        case OrderIntent::Type::Sell:
+            raw = orders.placeOrder(fieldString(intent.instrument), intent.type == OrderIntent::Type::Buy ? "buy" : "sell",
+                                    intent.amount, intent.price);
+            break;
+        case OrderIntent::Type::Edit:
+            raw = orders.modifyOrder(fieldString(intent.orderId), intent.amount, intent.price);
+            break;
+        case OrderIntent::Type::Cancel:
+            raw = orders.cancelOrder(fieldString(intent.orderId));
+            break;
+        case OrderIntent::Type::CancelAll:
+            raw = orders.cancelAllOrders(fieldString(intent.instrument));
+            break;
+        case OrderIntent::Type::Query:
+            raw = orders.getOrderState(fieldString(intent.orderId));
+            break;
+        }
+    }
+
+    if (intent.type == OrderIntent::Type::Edit) {
+        OrderIntent pending;
+        if (conflator->complete(fieldString(intent.orderId), pending)) {
+            readyEdits.push_back(pending); // The answer arrived: the latest pending edit goes next
+        }
+    }
+
+    OrderCompletion completion{};
+    completion.requestId = intent.requestId;
+    completion.type = intent.type;
+    completion.queueDelayNs = queueDelay;
+    copyField(completion.instrument, fieldString(intent.instrument));
+
+    json response = json::parse(raw, nullptr, false);
+    if (response.is_discarded() || !response.contains("result")) {
+        completion.success = false;
+        std::string reason = "No response from exchange";
+        if (!response.is_discarded() && response.contains("error")) {
+            reason = response["error"].value("message", "Exchange error");
+        }
+        copyField(completion.message, reason);
+    } else {
+        if (intent.type == OrderIntent::Type::Cancel) {
+            dropEdits(fieldString(intent.orderId));
+        } else if (intent.type == OrderIntent::Type::CancelAll && intent.instrument[0] == '\0') {
+            dropEdits(std::string());
+        }
+
+        const json& result = response["result"];
+        const json& order = result.is_object() && result.contains("order") ? result["order"] : result;
+        completion.success = true;
+        if (!order.is_object()) {
+            // cancel_all answers with the number of cancelled orders
+            copyField(completion.message, order.dump());
+            deliver(intent, completion);
+            return;
+        }
+        copyField(completion.orderId, order.value("order_id", ""));
+        copyField(completion.instrument, order.value("instrument_name", ""));
+        copyField(completion.orderState, order.value("order_state", ""));
+        completion.amount = numberOr(order, "amount", 0.0);
+        completion.filledAmount = numberOr(order, "filled_amount", 0.0);
+        completion.price = numberOr(order, "price", 0.0);
+    }
+
+    deliver(intent, completion);
+}
+
+void OrderSubmissionQueue::deliver(const OrderIntent& intent, const OrderCompletion& completion) {
+    if (!completions[intent.strategyId]->tryPush(completion)) {
+        std::cerr << fmt::format(ERROR_COLOR, "Completion queue of strategy {} is full, completion {} dropped\n",
+                                 intent.strategyId, intent.requestId);
+    }
+}
+
+/**
+ * @brief Runs on the I/O thread only, so the conflator needs no locking. An edit overwritten in
+ *        the pending slot, or in `readyEdits` before it was sent, completes immediately so its
+ *        strategy is not left waiting.
+ */
+void OrderSubmissionQueue::absorbEdits() {
+    IntentRing& ring = *intents[static_cast<std::size_t>(OrderPriority::Edit)];
+    OrderIntent edit;
+    OrderIntent superseded;
+    while (ring.tryPop(edit)) {
+        // An unsent edit of the same order is replaced in place: it keeps its position and its
+        // queueing start, and the order still has at most one edit on the way
+        auto unsent = std::find_if(readyEdits.begin(), readyEdits.end(), [&edit](const OrderIntent& ready) {
+            return std::strncmp(ready.orderId, edit.orderId, sizeof(edit.orderId)) == 0;
+        });
+        if (unsent != readyEdits.end()) {
+            superseded = *unsent;
+            const int64_t enqueuedNs = unsent->enqueuedNs;
+            *unsent = edit;
+            unsent->enqueuedNs = enqueuedNs;
+            conflatedCount.fetch_add(1, std::memory_order_relaxed);
+            discard(superseded, "Superseded by a newer edit");
+            continue;
+        }
+
+        switch (conflator->submit(edit, superseded)) {
+        case EditConflator::Result::SendNow:
+            readyEdits.push_back(edit);
+            break;
+        case EditConflator::Result::Replaced:
+            conflatedCount.fetch_add(1, std::memory_order_relaxed);
+            discard(superseded, "Superseded by a newer edit");
+            break;
+        case EditConflator::Result::Queued:
+            break;
+        }
+    }
+}
+
+/**
+ * @brief Drops the unsent edits of a cancelled order (or of every order when `orderId` is empty),
+ *        both those already released to `readyEdits` and those pending in the conflator.
+ */
+void OrderSubmissionQueue::dropEdits(const std::string& orderId) {
+    absorbEdits(); // Edits still in the ring were submitted before the cancel completed
+    for (auto it = readyEdits.begin(); it != readyEdits.end();) {
+        if (orderId.empty() || fieldString(it->orderId) == orderId) {
+            discard(*it, "Order cancelled before the edit was sent");
+            it = readyEdits.erase(it);
+        } else {
+            ++it;
+        }
+    }
+
+    std::vector<OrderIntent> dropped;
+    if (orderId.empty()) {
+        conflator->forgetAll(dropped);
+    } else {
+        OrderIntent pending;
+        if (conflator->forget(orderId, pending)) {
+            dropped.push_back(pending);
+        }
+    }
+    for (const auto& edit : dropped) {
+        discard(edit, "Order cancelled before the edit was sent");
+    }
+}
+
+void OrderSubmissionQueue::discard(const OrderIntent& intent, const std::string& reason) {
+    OrderCompletion completion{};
+    completion.requestId = intent.requestId;
+    completion.type = intent.type;
+    completion.success = false;
+    copyField(completion.orderId, fieldString(intent.orderId));
+    copyField(completion.message, reason);
+    deliver(intent, completion);
+}
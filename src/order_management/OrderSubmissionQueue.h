@@ -0,0 +1,266 @@
+#ifndef ORDER_SUBMISSION_QUEUE_H
+#define ORDER_SUBMISSION_QUEUE_H
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <cstddef>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include "../utils/MpscRing.h"
+
+class OrderEntry;
+class EditConflator;
+class RateLimiter;
+
+/**
+ * @file OrderSubmissionQueue.h
+ *
+ * @brief Defines the `OrderSubmissionQueue` class, a thread-safe order entry front-end for one
+ *        order transport (`OrderEntry`) shared by several in-process strategies.
+ *
+ * `OrderEntry` calls block on their round trip (HTTP or FIX) and are not meant to be called from many
+ * threads. Instead, strategy threads push fixed-size intents into a lock-free MPSC ring; a single
+ * order I/O thread drains the ring, executes each intent and pushes the outcome into the
+ * completion ring of the strategy that submitted it. Submitting never takes a lock, and strategies
+ * never contend with each other on order entry.
+ *
+ * Intents are queued by priority class (kill/cancel > edit > new > query), each in its own bounded
+ * ring. The I/O thread picks the next request from the highest non-empty class before every send,
+ * so a cancel never waits behind a backlog of new orders; it only waits for the request already in
+ * flight. Queueing delay is measured per class.
+ *
+ * Edits are conflated per order: at most one edit of an order is in flight and one is pending. An
+ * edit arriving while another is pending overwrites it (the overwritten request completes with
+ * `success == false` and a "superseded" message), and the pending edit is sent as soon as the
+ * in-flight edit is acknowledged. An edit that was cleared for sending but is still waiting behind
+ * higher-priority requests is replaced the same way. A successful cancel drops every unsent edit
+ * of the order (a cancel of all orders drops all of them), so no edit goes out after its cancel.
+ *
+ * The I/O thread busy-polls the rings for `SPIN_BEFORE_PARK` after its last intent, so bursts are
+ * picked up without a wake-up, then parks on a condition variable that `submit` signals. An idle
+ * queue (e.g., behind the interactive menu) therefore costs no CPU.
+ *
+ * When a `RateLimiter` is given, the I/O thread charges it right before every request; a request
+ * that would exceed the limit is not sent and completes with a "Rate limit exceeded" error.
+ */
+
+/**
+ * @struct OrderIntent
+ *
+ * @brief One order instruction from a strategy.
+ */
+struct OrderIntent {
+    enum class Type : uint8_t {
+        Buy,
+        Sell,
+        Edit,
+        Cancel,
+        CancelAll, /**< Kill switch; `instrument` optionally limits it to one instrument. */
+        Query      /**< Order state lookup. */
+    };
+
+    uint64_t requestId;   /**< Strategy-chosen ID echoed in the completion. */
+    uint32_t strategyId;  /**< ID returned by `registerStrategy`. */
+    Type type;            /**< What to do. */
+    char instrument[64];  /**< Instrument name (buy/sell/cancel all). */
+    char orderId[64];     /**< Exchange order ID (edit/cancel/query). */
+    double amount;        /**< Amount (buy/sell/edit). */
+    double price;         /**< Limit price (buy/sell/edit). */
+    int64_t enqueuedNs;   /**< Steady-clock enqueue time, set by `submit`. */
+};
+
+/**
+ * @brief Send priority of an intent; lower values are sent first.
+ */
+enum class OrderPriority : uint8_t {
+    Cancel = 0, /**< Kill switch and cancels. */
+    Edit = 1,   /**< Edits of resting orders. */
+    New = 2,    /**< New orders. */
+    Query = 3   /**< Order state queries. */
+};
+
+/**
+ * @struct QueueDelayMetrics
+ *
+ * @brief Queueing delay (enqueue to send) of one priority class.
+ */
+struct QueueDelayMetrics {
+    uint64_t sent{0};         /**< Intents taken from the queue. */
+    uint64_t rejected{0};     /**< Intents refused because the class queue was full. */
+    uint64_t totalDelayNs{0}; /**< Sum of queueing delays. */
+    uint64_t maxDelayNs{0};   /**< Largest queueing delay. */
+
+    /** @brief Returns the mean queueing delay in microseconds. */
+    double averageDelayUs() const { return sent == 0 ? 0.0 : static_cast<double>(totalDelayNs) / sent / 1000.0; }
+};
+
+/**
+ * @struct OrderCompletion
+ *
+ * @brief Outcome of one intent, delivered to the submitting strategy.
+ */
+struct OrderCompletion {
+    uint64_t requestId;     /**< The `requestId` of the intent. */
+    OrderIntent::Type type; /**< The type of the intent. */
+    uint64_t queueDelayNs;  /**< Time the intent waited in its class queue. */
+    bool success;           /**< True if the exchange accepted the request. */
+    char orderId[64];       /**< Exchange order ID, if known. */
+    char instrument[64];    /**< Instrument of the order, if known. */
+    char orderState[24];    /**< "open", "filled", "cancelled", ... */
+    double amount;          /**< Order amount. */
+    double filledAmount;    /**< Filled amount. */
+    double price;           /**< Order price. */
+    char message[128];      /**< Error message when `success` is false. */
+};
+
+/**
+ * @class OrderSubmissionQueue
+ *
+ * @brief Lock-free MPSC intent queue drained by one order I/O thread, with per-strategy completions.
+ *
+ * ### Example:
+ * ```
+ * OrderSubmissionQueue queue(orderManager);
+ * queue.start();
+ * uint32_t strategy = queue.registerStrategy();
+ * queue.placeOrder(strategy, 1, "BTC-PERPETUAL", "buy", 10, 30000);   // any thread
+ * OrderCompletion completion;
+ * while (!queue.poll(strategy, completion)) {}                       // the strategy's thread
+ * ```
+ */
+class OrderSubmissionQueue {
+public:
+    static constexpr std::size_t INTENT_CAPACITY = 1024; /**< Per priority class. */
+    static constexpr std::size_t PRIORITY_COUNT = 4;
+    static constexpr std::size_t COMPLETION_CAPACITY = 1024;
+    static constexpr std::size_t MAX_STRATEGIES = 32;
+    static constexpr uint32_t INVALID_STRATEGY = 0xFFFFFFFFu;
+    static constexpr std::chrono::microseconds SPIN_BEFORE_PARK{200}; /**< Idle busy-poll time before the I/O thread parks. */
+    static constexpr std::chrono::milliseconds PARK_TIMEOUT{100};     /**< Longest park without a signal (safety net). */
+
+    /**
+     * @brief Constructs a stopped queue.
+     *
+     * @param orders The order transport used by the I/O thread; it must outlive the queue.
+     * @param limiter Optional token bucket charged before every request; it must outlive the queue.
+     */
+    explicit OrderSubmissionQueue(OrderEntry& orders, RateLimiter* limiter = nullptr);
+
+    /** @brief Stops the I/O thread. */
+    ~OrderSubmissionQueue();
+
+    OrderSubmissionQueue(const OrderSubmissionQueue&) = delete;
+    OrderSubmissionQueue& operator=(const OrderSubmissionQueue&) = delete;
+
+    /** @brief Starts the order I/O thread. */
+    void start();
+
+    /** @brief Stops the I/O thread after the intents already queued have been executed. */
+    void stop();
+
+    /**
+     * @brief Creates a completion queue for a new strategy.
+     *
+     * @return The strategy ID, or `INVALID_STRATEGY` if `MAX_STRATEGIES` are registered.
+     */
+    uint32_t registerStrategy();
+
+    /**
+     * @brief Enqueues an intent in its priority class; lock-free and safe from any thread.
+     *
+     * @return False if the strategy is unknown or the queue of its class is full.
+     */
+    bool submit(OrderIntent intent);
+
+    /** @brief Returns the priority class of an intent type. */
+    static OrderPriority priorityOf(OrderIntent::Type type);
+
+    /** @brief Returns a snapshot of the queueing delay metrics of a priority class. */
+    QueueDelayMetrics metrics(OrderPriority priority) const;
+
+    /** @brief Returns the number of edits overwritten by a newer edit of the same order before being sent. */
+    uint64_t conflatedEdits() const;
+
+    /** @brief Enqueues a limit order ("buy" or "sell"). */
+    bool placeOrder(uint32_t strategyId, uint64_t requestId, const std::string& instrument,
+                    const std::string& side, double amount, double price);
+
+    /** @brief Enqueues an edit of an existing order. */
+    bool modifyOrder(uint32_t strategyId, uint64_t requestId, const std::string& orderId, double amount, double price);
+
+    /** @brief Enqueues a cancellation. */
+    bool cancelOrder(uint32_t strategyId, uint64_t requestId, const std::string& orderId);
+
+    /** @brief Enqueues the kill switch (all orders, or all orders of one instrument). */
+    bool cancelAll(uint32_t strategyId, uint64_t requestId, const std::string& instrument = "");
+
+    /** @brief Enqueues an order state query. */
+    bool queryOrder(uint32_t strategyId, uint64_t requestId, const std::string& orderId);
+
+    /**
+     * @brief Fetches the next completion of a strategy without blocking.
+     *
+     * Must only be called by one thread per strategy.
+     */
+    bool poll(uint32_t strategyId, OrderCompletion& out);
+
+private:
+    using IntentRing = MpscRing<OrderIntent, INTENT_CAPACITY>;
+    using CompletionRing = MpscRing<OrderCompletion, COMPLETION_CAPACITY>;
+
+    /** @brief Per-class counters, written by producers (rejections) and the I/O thread (delays). */
+    struct ClassCounters {
+        std::atomic<uint64_t> sent{0};
+        std::atomic<uint64_t> rejected{0};
+        std::atomic<uint64_t> totalDelayNs{0};
+        std::atomic<uint64_t> maxDelayNs{0};
+    };
+
+    /** @brief I/O loop: always sends from the highest-priority non-empty class. */
+    void run();
+
+    /** @brief Pops the next intent by priority and records its queueing delay; false if all classes are empty. */
+    bool next(OrderIntent& out, uint64_t& delayNs);
+
+    /** @brief Executes one intent and delivers its completion. */
+    void execute(const OrderIntent& intent, uint64_t queueDelay);
+
+    /** @brief Pushes a completion into the submitting strategy's ring. */
+    void deliver(const OrderIntent& intent, const OrderCompletion& completion);
+
+    /** @brief Moves queued edits into the conflator; edits that may be sent now go to `readyEdits`. */
+    void absorbEdits();
+
+    /** @brief Drops the unsent edits of a cancelled order, or of every order if `orderId` is empty. */
+    void dropEdits(const std::string& orderId);
+
+    /** @brief Completes an intent without sending it (superseded or dropped edit). */
+    void discard(const OrderIntent& intent, const std::string& reason);
+
+    /** @brief Wakes the I/O thread up if it is parked; called after every push and by `stop`. */
+    void wakeIfParked();
+
+    OrderEntry& orders;
+    RateLimiter* limiter;                     /**< Charged before every request, or nullptr. */
+    std::array<std::unique_ptr<IntentRing>, PRIORITY_COUNT> intents;
+    std::array<ClassCounters, PRIORITY_COUNT> counters;
+    std::unique_ptr<EditConflator> conflator; /**< Per-order edit conflation (I/O thread only). */
+    std::deque<OrderIntent> readyEdits;       /**< Edits cleared by the conflator, in send order (I/O thread only). */
+    std::atomic<uint64_t> conflatedCount;
+    std::array<std::unique_ptr<CompletionRing>, MAX_STRATEGIES> completions;
+    std::atomic<uint32_t> strategyCount;
+    std::mutex registerMutex;
+    std::atomic<bool> running;
+    std::atomic<bool> parked{false};          /**< The I/O thread is (about to be) waiting on `wakeup`. */
+    std::mutex parkMutex;                     /**< Pairs `parked` with `wakeup` so no signal is lost. */
+    std::condition_variable wakeup;
+    std::thread io;
+};
+
+#endif // ORDER_SUBMISSION_QUEUE_H
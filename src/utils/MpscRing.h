@@ -0,0 +1,133 @@
+#ifndef MPSC_RING_H
+#define MPSC_RING_H
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+/**
+ * @file MpscRing.h
+ *
+ * @brief Defines `MpscRing`, a bounded lock-free multi-producer queue of trivially copyable values.
+ *
+ * The ring follows Dmitry Vyukov's bounded queue: every cell carries a sequence number that tells
+ * producers whether the cell is free for the current lap and tells the consumer whether it has been
+ * published. Producers claim a position with one CAS on the tail; the consumer needs no atomic
+ * read-modify-write at all when there is a single consumer.
+ *
+ * The ring holds no pointers and its atomics are address-free, so it can be placed in memory shared
+ * between processes (e.g., a `mmap`ed region) as well as used between threads.
+ */
+
+/**
+ * @class MpscRing
+ *
+ * @brief Bounded lock-free queue; many producers, one consumer.
+ *
+ * @tparam T The element type; must be trivially copyable.
+ * @tparam Capacity The number of cells; must be a power of two.
+ *
+ * ### Example:
+ * ```
+ * MpscRing<Intent, 1024> ring;
+ * ring.tryPush(intent);                 // any thread
+ * Intent next;
+ * while (ring.tryPop(next)) { ... }     // the consumer thread
+ * ```
+ */
+template <typename T, std::size_t Capacity>
+class MpscRing {
+    static_assert(std::is_trivially_copyable<T>::value, "MpscRing elements must be trivially copyable");
+    static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0, "MpscRing capacity must be a power of two");
+    static_assert(std::atomic<uint64_t>::is_always_lock_free, "MpscRing requires lock-free 64-bit atomics");
+
+public:
+    MpscRing() { reset(); }
+
+    MpscRing(const MpscRing&) = delete;
+    MpscRing& operator=(const MpscRing&) = delete;
+
+    /**
+     * @brief Empties the ring and prepares the cell sequence numbers.
+     *
+     * Must be called once before use when the ring lives in raw (e.g., shared) memory that was not
+     * constructed, and must not race with producers or the consumer.
+     */
+    void reset() {
+        for (std::size_t i = 0; i < Capacity; ++i) {
+            cells[i].sequence.store(i, std::memory_order_relaxed);
+        }
+        head.store(0, std::memory_order_relaxed);
+        tail.store(0, std::memory_order_release);
+    }
+
+    /**
+     * @brief Appends a value; safe to call from any number of producers.
+     *
+     * @return False if the ring is full.
+     */
+    bool tryPush(const T& value) {
+        uint64_t position = tail.load(std::memory_order_relaxed);
+        for (;;) {
+            Cell& cell = cells[position & MASK];
+            const uint64_t sequence = cell.sequence.load(std::memory_order_acquire);
+            const int64_t lap = static_cast<int64_t>(sequence) - static_cast<int64_t>(position);
+            if (lap == 0) {
+                if (tail.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                    cell.value = value;
+                    cell.sequence.store(position + 1, std::memory_order_release);
+                    return true;
+                }
+            } else if (lap < 0) {
+                return false; // The consumer has not freed this cell yet
+            } else {
+                position = tail.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    /**
+     * @brief Removes the oldest value; must only be called by the single consumer.
+     *
+     * @return False if the ring is empty (or the oldest value is still being written).
+     */
+    bool tryPop(T& out) {
+        const uint64_t position = head.load(std::memory_order_relaxed);
+        Cell& cell = cells[position & MASK];
+        const uint64_t sequence = cell.sequence.load(std::memory_order_acquire);
+        if (sequence != position + 1) {
+            return false;
+        }
+
+        out = cell.value;
+        cell.sequence.store(position + Capacity, std::memory_order_release);
+        head.store(position + 1, std::memory_order_relaxed);
+        return true;
+    }
+
+    /** @brief Returns an approximate number of queued values. */
+    std::size_t sizeApprox() const {
+        const uint64_t t = tail.load(std::memory_order_relaxed);
+        const uint64_t h = head.load(std::memory_order_relaxed);
+        return t > h ? static_cast<std::size_t>(t - h) : 0;
+    }
+
+    /** @brief Returns the capacity of the ring. */
+    static constexpr std::size_t capacity() { return Capacity; }
+
+private:
+    static constexpr uint64_t MASK = Capacity - 1;
+
+    struct alignas(64) Cell {
+        std::atomic<uint64_t> sequence;
+        T value;
+    };
+
+    alignas(64) std::atomic<uint64_t> tail; /**< Next position to claim (producers). */
+    alignas(64) std::atomic<uint64_t> head; /**< Next position to read (consumer). */
+    std::array<Cell, Capacity> cells;
+};
+
+#endif // MPSC_RING_H
@@ -0,0 +1,116 @@
+#ifndef PERFECT_HASH_H
+#define PERFECT_HASH_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <string_view>
+
+/**
+ * @file PerfectHash.h
+ *
+ * @brief Defines `PerfectHashTable`, a perfect hash table over a fixed set of strings built at
+ *        compile time.
+ *
+ * The constructor searches for a seed under which a seeded FNV-1a hash maps every key to its own
+ * slot of a power-of-two table at least twice the key count. A lookup is then one hash of the
+ * candidate, one table read and one string compare to reject unknown strings. Declared
+ * `constexpr`, the seed search runs in the compiler; a key set without a seed fails to compile.
+ */
+
+/**
+ * @class PerfectHashTable
+ *
+ * @brief Maps each of `N` known strings to its index in the key array.
+ *
+ * @tparam N The number of keys.
+ *
+ * ### Example:
+ * ```
+ * constexpr PerfectHashTable<3> methods({"subscription", "heartbeat", "public/test"});
+ * static_assert(methods.find("heartbeat") == 1);
+ * int index = methods.find(notification["method"].get<std::string_view>()); // -1 if unknown
+ * ```
+ */
+template <std::size_t N>
+class PerfectHashTable {
+    static_assert(N > 0 && N < 0x8000, "PerfectHashTable needs between 1 and 32767 keys");
+
+public:
+    /** @brief Number of slots: the smallest power of two holding twice the keys. */
+    static constexpr std::size_t SLOTS = [] {
+        std::size_t slots = 2;
+        while (slots < 2 * N) {
+            slots *= 2;
+        }
+        return slots;
+    }();
+
+    /** @brief Largest seed tried before giving up. */
+    static constexpr uint32_t MAX_SEED = 1u << 16;
+
+    /**
+     * @brief Finds a collision-free seed for the keys and fills the slot table.
+     *
+     * @throws std::logic_error If the keys contain duplicates or no seed up to `MAX_SEED` works
+     *         (a compile error when evaluated in a constant expression).
+     */
+    constexpr explicit PerfectHashTable(const std::array<std::string_view, N>& keys) : keys(keys) {
+        for (uint32_t candidate = 0; candidate < MAX_SEED; ++candidate) {
+            if (tryBuild(candidate)) {
+                seedValue = candidate;
+                return;
+            }
+        }
+        throw std::logic_error("PerfectHashTable: no collision-free seed for this key set");
+    }
+
+    /** @brief Returns the index of `key` in the key array, or -1 if it is not a key. */
+    constexpr int find(std::string_view key) const {
+        const int16_t index = slots[hash(key, seedValue) & (SLOTS - 1)];
+        return index >= 0 && keys[static_cast<std::size_t>(index)] == key ? index : -1;
+    }
+
+    /** @brief Returns the key with the given index. */
+    constexpr std::string_view key(std::size_t index) const { return keys[index]; }
+
+    /** @brief Returns the seed found by the constructor. */
+    constexpr uint32_t seed() const { return seedValue; }
+
+    static constexpr std::size_t size() { return N; }
+
+    /** @brief Seeded 32-bit FNV-1a with a final avalanche, so low bits depend on every byte. */
+    static constexpr uint32_t hash(std::string_view text, uint32_t seed) {
+        uint32_t h = 2166136261u ^ (seed * 0x9E3779B9u);
+        for (char c : text) {
+            h ^= static_cast<unsigned char>(c);
+            h *= 16777619u;
+        }
+        h ^= h >> 16;
+        h *= 0x85EBCA6Bu;
+        h ^= h >> 13;
+        return h;
+    }
+
+private:
+    constexpr bool tryBuild(uint32_t candidate) {
+        for (std::size_t i = 0; i < SLOTS; ++i) {
+            slots[i] = -1;
+        }
+        for (std::size_t i = 0; i < N; ++i) {
+            const std::size_t slot = hash(keys[i], candidate) & (SLOTS - 1);
+            if (slots[slot] >= 0) {
+                return false;
+            }
+            slots[slot] = static_cast<int16_t>(i);
+        }
+        return true;
+    }
+
+    std::array<std::string_view, N> keys;
+    std::array<int16_t, SLOTS> slots{};
+    uint32_t seedValue{0};
+};
+
+#endif // PERFECT_HASH_H
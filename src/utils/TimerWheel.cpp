@@ -0,0 +1,194 @@
+#include "TimerWheel.h"
+#include <algorithm>
+
+/**
+ * @file TimerWheel.cpp
+ *
+ * @brief Implements the `TimerWheel` class.
+ */
+
+namespace {
+
+/** @brief Largest expiry distance the top level can hold; farther timers are re-placed on cascade. */
+constexpr uint64_t MAX_DELTA = (uint64_t{1} << (TimerWheel::LEVELS * TimerWheel::SLOT_BITS)) - 1;
+
+constexpr uint64_t SLOT_MASK = TimerWheel::SLOTS - 1;
+
+} // namespace
+
+TimerWheel::TimerWheel(Clock::duration tick, std::size_t initialCapacity)
+    : origin(Clock::now()), tick(std::max(tick, Clock::duration(1))) {
+    buckets.fill(NONE);
+    nodes.resize(std::max<std::size_t>(initialCapacity, 1));
+    for (std::size_t i = nodes.size(); i-- > 0;) {
+        nodes[i].next = freeHead;
+        freeHead = static_cast<uint32_t>(i);
+    }
+}
+
+uint64_t TimerWheel::tickOf(Clock::time_point when) const {
+    if (when <= origin) {
+        return 0;
+    }
+    const auto elapsed = when - origin;
+    return static_cast<uint64_t>((elapsed + tick - Clock::duration(1)) / tick);
+}
+
+uint32_t TimerWheel::acquire() {
+    if (freeHead == NONE) {
+        // Double the pool; nodes are addressed by index, so moving them is harmless
+        const std::size_t previous = nodes.size();
+        nodes.resize(previous * 2);
+        for (std::size_t i = nodes.size(); i-- > previous;) {
+            nodes[i].next = freeHead;
+            freeHead = static_cast<uint32_t>(i);
+        }
+    }
+    const uint32_t index = freeHead;
+    freeHead = nodes[index].next;
+    nodes[index].next = NONE;
+    return index;
+}
+
+void TimerWheel::release(uint32_t index) {
+    Node& node = nodes[index];
+    node.callback = nullptr;
+    node.bucket = UNLINKED;
+    node.prev = NONE;
+    node.generation = node.generation == 0xFFFFFFFFu ? 1 : node.generation + 1;
+    node.next = freeHead;
+    freeHead = index;
+}
+
+void TimerWheel::link(uint32_t index, uint32_t bucket) {
+    Node& node = nodes[index];
+    node.bucket = bucket;
+    node.prev = NONE;
+    node.next = buckets[bucket];
+    if (node.next != NONE) {
+        nodes[node.next].prev = index;
+    }
+    buckets[bucket] = index;
+}
+
+void TimerWheel::unlink(uint32_t index) {
+    Node& node = nodes[index];
+    if (node.prev != NONE) {
+        nodes[node.prev].next = node.next;
+    } else {
+        buckets[node.bucket] = node.next;
+    }
+    if (node.next != NONE) {
+        nodes[node.next].prev = node.prev;
+    }
+    node.prev = node.next = NONE;
+    node.bucket = UNLINKED;
+}
+
+/**
+ * @brief Level L holds timers less than SLOTS^(L+1) ticks away, in the bucket of their expiry's
+ *        L-th digit (base SLOTS). That bucket is cascaded exactly when the current tick enters the
+ *        expiry's block of SLOTS^L ticks, so no timer is cascaded late.
+ */
+void TimerWheel::place(uint32_t index) {
+    const uint64_t expiry = nodes[index].expiry;
+    const uint64_t delta = expiry > current ? std::min(expiry - current, MAX_DELTA) : 0;
+    const uint64_t target = current + delta;
+
+    std::size_t level = 0;
+    while (level + 1 < LEVELS && delta >= (uint64_t{1} << ((level + 1) * SLOT_BITS))) {
+        ++level;
+    }
+    const uint64_t slot = (target >> (level * SLOT_BITS)) & SLOT_MASK;
+    link(index, static_cast<uint32_t>(level * SLOTS + slot));
+}
+
+void TimerWheel::cascade(uint32_t bucket) {
+    uint32_t index = buckets[bucket];
+    buckets[bucket] = NONE;
+    while (index != NONE) {
+        const uint32_t next = nodes[index].next;
+        nodes[index].prev = nodes[index].next = NONE;
+        nodes[index].bucket = UNLINKED;
+        place(index);
+        index = next;
+    }
+}
+
+TimerWheel::TimerId TimerWheel::schedule(Clock::time_point deadline, Callback callback) {
+    const uint32_t index = acquire();
+    Node& node = nodes[index];
+    node.expiry = std::max(tickOf(deadline), current + 1);
+    node.callback = std::move(callback);
+    place(index);
+    ++armed;
+    return (static_cast<uint64_t>(node.generation) << 32) | index;
+}
+
+TimerWheel::TimerId TimerWheel::scheduleAfter(Clock::duration delay, Callback callback) {
+    return schedule(Clock::now() + delay, std::move(callback));
+}
+
+bool TimerWheel::cancel(TimerId id) {
+    const uint32_t index = static_cast<uint32_t>(id & 0xFFFFFFFFu);
+    const uint32_t generation = static_cast<uint32_t>(id >> 32);
+    if (index >= nodes.size() || nodes[index].generation != generation || nodes[index].bucket == UNLINKED) {
+        return false;
+    }
+    unlink(index);
+    release(index);
+    --armed;
+    return true;
+}
+
+/**
+ * @brief Walks tick by tick: on every wrap of a level's cursor, the next bucket of the level above
+ *        is cascaded down, then the level 0 bucket of the tick fires. An empty wheel jumps straight
+ *        to `now`.
+ */
+std::size_t TimerWheel::advance(Clock::time_point now) {
+    const uint64_t target = now <= origin ? 0 : static_cast<uint64_t>((now - origin) / tick);
+    std::size_t fired = 0;
+
+    while (current < target) {
+        if (armed == 0) {
+            current = target;
+            break;
+        }
+        ++current;
+
+        for (std::size_t level = 1; level < LEVELS; ++level) {
+            if (((current >> ((level - 1) * SLOT_BITS)) & SLOT_MASK) != 0) {
+                break;
+            }
+            cascade(static_cast<uint32_t>(level * SLOTS + ((current >> (level * SLOT_BITS)) & SLOT_MASK)));
+        }
+
+        // Pop one timer at a time, so callbacks may cancel or schedule freely
+        const uint32_t bucket = static_cast<uint32_t>(current & SLOT_MASK);
+        while (buckets[bucket] != NONE) {
+            const uint32_t index = buckets[bucket];
+            unlink(index);
+            if (nodes[index].expiry > current) {
+                place(index);
+                continue;
+            }
+            Callback callback = std::move(nodes[index].callback);
+            release(index);
+            --armed;
+            ++fired;
+            if (callback) {
+                callback();
+            }
+        }
+    }
+    return fired;
+}
+
+std::size_t TimerWheel::size() const {
+    return armed;
+}
+
+std::size_t TimerWheel::capacity() const {
+    return nodes.size();
+}
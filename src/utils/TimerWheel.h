@@ -0,0 +1,150 @@
+#ifndef TIMER_WHEEL_H
+#define TIMER_WHEEL_H
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+/**
+ * @file TimerWheel.h
+ *
+ * @brief Defines the `TimerWheel` class, a hashed hierarchical timer wheel for the many short
+ *        timers of a trading loop (request timeouts, heartbeats, order expiry, algo slices).
+ *
+ * Time is counted in ticks. The wheel has `LEVELS` levels of `SLOTS` buckets: level 0 holds timers
+ * due within `SLOTS` ticks, one bucket per tick, and every higher level covers `SLOTS` times the
+ * span of the level below. When the level 0 cursor wraps, the next bucket of level 1 is cascaded
+ * down into level 0, and so on up the hierarchy, so every timer is moved at most `LEVELS - 1`
+ * times before it fires.
+ *
+ * Timer nodes live in a pool indexed by 32-bit handles and recycled through a free list; buckets are
+ * intrusive doubly linked lists through the nodes. Scheduling and cancelling are O(1) and, once the
+ * pool has grown to the peak number of active timers, allocate nothing.
+ *
+ * The wheel is not thread-safe: it belongs to the thread that calls `advance` (e.g., an I/O loop),
+ * or to a component that guards it with its own lock.
+ */
+
+/**
+ * @class TimerWheel
+ *
+ * @brief Hierarchical timer wheel with pooled nodes and O(1) schedule and cancel.
+ *
+ * ### Workflow:
+ * 1. `schedule`/`scheduleAfter` arm a timer and return its ID.
+ * 2. `cancel` disarms it; a fired or cancelled ID is never reused (node generations).
+ * 3. The owning loop calls `advance` regularly (e.g., after every poll); due timers fire in it.
+ *
+ * ### Example:
+ * ```
+ * TimerWheel timers(std::chrono::milliseconds(1));
+ * TimerWheel::TimerId heartbeat = timers.scheduleAfter(std::chrono::seconds(10), [&]() { sendHeartbeat(); });
+ * while (running) {
+ *     poll(...);
+ *     timers.advance();
+ * }
+ * timers.cancel(heartbeat);
+ * ```
+ */
+class TimerWheel {
+public:
+    using Callback = std::function<void()>;
+    using TimerId = uint64_t;
+    using Clock = std::chrono::steady_clock;
+
+    static constexpr TimerId INVALID_TIMER = 0;
+    static constexpr std::size_t LEVELS = 4;
+    static constexpr unsigned SLOT_BITS = 8;
+    static constexpr std::size_t SLOTS = std::size_t{1} << SLOT_BITS;
+
+    /**
+     * @brief Constructs an empty wheel whose tick count starts now.
+     *
+     * @param tick The resolution; timers fire on the first `advance` at or after their deadline,
+     *             rounded up to a tick.
+     * @param initialCapacity Timer nodes allocated up front.
+     */
+    explicit TimerWheel(Clock::duration tick = std::chrono::milliseconds(1), std::size_t initialCapacity = 1024);
+
+    TimerWheel(const TimerWheel&) = delete;
+    TimerWheel& operator=(const TimerWheel&) = delete;
+
+    /**
+     * @brief Arms a timer for a deadline; a deadline in the past fires on the next tick.
+     *
+     * Callbacks that capture at most two pointers are stored without allocating.
+     *
+     * @return The timer ID (never `INVALID_TIMER`).
+     */
+    TimerId schedule(Clock::time_point deadline, Callback callback);
+
+    /** @brief Arms a timer `delay` from now. */
+    TimerId scheduleAfter(Clock::duration delay, Callback callback);
+
+    /**
+     * @brief Disarms a timer.
+     *
+     * @return False if the timer already fired, was cancelled, or is unknown.
+     */
+    bool cancel(TimerId id);
+
+    /**
+     * @brief Advances the wheel to `now` and fires every timer due by then.
+     *
+     * Callbacks run inside this call and may schedule and cancel timers.
+     *
+     * @return The number of timers fired.
+     */
+    std::size_t advance(Clock::time_point now = Clock::now());
+
+    /** @brief Returns the number of armed timers. */
+    std::size_t size() const;
+
+    /** @brief Returns the number of pooled nodes (armed plus free). */
+    std::size_t capacity() const;
+
+private:
+    static constexpr uint32_t NONE = 0xFFFFFFFFu;
+    static constexpr uint32_t UNLINKED = 0xFFFFFFFFu;
+
+    /** @brief One timer; a free node is chained through `next` in the free list. */
+    struct Node {
+        uint64_t expiry{0};      /**< Due tick. */
+        uint32_t generation{1};  /**< Bumped on release, so stale IDs do not match. */
+        uint32_t prev{NONE};
+        uint32_t next{NONE};
+        uint32_t bucket{UNLINKED}; /**< level * SLOTS + slot, or UNLINKED when not armed. */
+        Callback callback;
+    };
+
+    /** @brief Returns the tick of a time point, rounded up. */
+    uint64_t tickOf(Clock::time_point when) const;
+
+    /** @brief Puts an armed node into the bucket matching its expiry. */
+    void place(uint32_t index);
+
+    void link(uint32_t index, uint32_t bucket);
+    void unlink(uint32_t index);
+
+    /** @brief Re-places every node of one bucket relative to the current tick. */
+    void cascade(uint32_t bucket);
+
+    /** @brief Takes a node from the free list, growing the pool if needed. */
+    uint32_t acquire();
+
+    /** @brief Returns a node to the free list. */
+    void release(uint32_t index);
+
+    Clock::time_point origin;  /**< Time of tick 0. */
+    Clock::duration tick;
+    uint64_t current{0};       /**< Last processed tick. */
+    std::size_t armed{0};
+    std::vector<Node> nodes;
+    uint32_t freeHead{NONE};
+    std::array<uint32_t, LEVELS * SLOTS> buckets;
+};
+
+#endif // TIMER_WHEEL_H